@@ -13,6 +13,7 @@
  *  Version | Author       | Date        | Description
  *  :--:    | :-----       | :--:        | :----------
  *   1      | J. Peterson  | 02/13/2015  | initial version
+ *   2      | agent        | 10/19/2026  | statistics, block capture, retry and parallel commands
  *
 */
 
@@ -37,6 +38,7 @@ CCommand::CCommand()
     m_lineNumber = -1;
 
     m_argInteger = 0;
+    m_argInteger2 = 0;
     m_stringArg.clear();
     m_argNumber = 0;
     m_charNumber = 0;
@@ -62,8 +64,7 @@ CCommand::~CCommand()
     switch (m_type)
     {
     case CMD_WAITFOR:
-        params_WAITFOR.m_expectedString->clear();
-        delete params_WAITFOR.m_expectedString;
+        params_WAITFOR.m_expectedString.clear();
         break;
     case CMD_VERSION:
         //params_VERSION.m_scriptVersion->clear();
@@ -84,6 +85,8 @@ CCommand::~CCommand()
  *     test <string - test name>                             - marks the begining of a test section
  *     type <string - test type>                             - test type
  *     desc <string - test description>                      - description of the test
+ *     requires <test name>[, <test name>...]                - tests that must not fail for this test to run
+ *     group <string - group name>                           - consecutive tests in the same group may run in any order
  *     sendline_a <string - command to send to instrument>   - sends a string to the instrument serial interface
  *     sendline_b <string - command to send to instrument>   - sends a string to the instrument serial interface
  *     readline_a                                            - reads a NL terminated line from instrument
@@ -94,12 +97,22 @@ CCommand::~CCommand()
  *     units <string>                                        - provides a description of the units used by the "expect" command
  *     expect_char <int - field> <int - char number> <char>  - tests if specified  character matches
  *     expect_str <int - field> <string>                     - tests the specified field for the string
+ *     expect_avg <int field> <min> <max> <int n>            - tests the mean of n samples of the field
+ *     expect_stats <int field> <min> <max> <int n>          - tests that all n samples of the field are in range
  *     sleep <int - ms>                                      - sleeps the specified number of milliseconds
- *     prompt <string - question>                            - asks the user a yes/no question
+ *     prompt [async] <string - question>                    - asks the user a yes/no question (async: without waiting)
  *     pause <string - comment>                              - pause till the user resumes
  *     waitfor <a|b> <int-ms> <string>                       - read from specified channel until string is seen or timeout
+ *     readblock <a|b> <int n> [rate-hz] [text|u8|s16]       - captures a block of n samples from the specified channel
+ *     expect_rms <min> <max>                                - tests the AC RMS of the captured block
+ *     expect_peak_freq <min-hz> <max-hz>                    - tests the frequency of the largest spectral peak of the block
+ *     expect_thd <min-%> <max-%>                            - tests the total harmonic distortion of the block
  *     end_script                                            - terminate the script
  *     end_on_error                                          - terminate on error on previous command
+ *     retry <int n> <int backoff-ms> [once]                 - retry a send/read/expect group whose reply is missing or unreadable
+ *     parallel {                                            - start of a block whose two branches run at the same time
+ *     } / {                                                 - ends the first branch (port A or B) and starts the second
+ *     }                                                     - ends the parallel block, waits for both branches
  *
  * @author J. Peterson
  * @date 06/22/2014
@@ -170,6 +183,36 @@ void CCommand::parse(const char *line, int lineNumber)
         return;
     }
 
+    //
+    // group
+    //
+    if (args[0] == "group")
+    {
+        m_type = CMD_GROUP;
+        m_stringArg = m_line.right(m_line.size()-5);
+        m_stringArg = m_stringArg.trimmed();
+        if (m_stringArg.isEmpty())
+        {
+            m_type = CMD_UNKNOWN;
+        }
+        return;
+    }
+
+    //
+    // requires
+    //
+    if (args[0] == "requires")
+    {
+        m_type = CMD_REQUIRES;
+        m_stringArg = m_line.right(m_line.size()-8);
+        m_stringArg = m_stringArg.trimmed();
+        if (m_stringArg.isEmpty())
+        {
+            m_type = CMD_UNKNOWN;
+        }
+        return;
+    }
+
     //
     // sendline_a
     //
@@ -288,6 +331,27 @@ void CCommand::parse(const char *line, int lineNumber)
         return;
     }
 
+    //
+    // expect_avg and expect_stats
+    //
+    if ((args[0] == "expect_avg") || (args[0] == "expect_stats"))
+    {
+        m_type = (args[0] == "expect_avg") ? CMD_EXPECT_AVG : CMD_EXPECT_STATS;
+        bool b1=false, b2=false, b3=false, b4=false;
+        if (args.size() >= 5)
+        {
+            m_argNumber = args[1].toInt(&b1);
+            m_argMin = args[2].toDouble(&b2);
+            m_argMax = args[3].toDouble(&b3);
+            m_argInteger = args[4].toInt(&b4);
+        }
+        if (!b1 || !b2 || !b3 || !b4 || (m_argNumber < 1) || (m_argInteger < 1))
+        {
+            m_type = CMD_UNKNOWN;
+        }
+        return;
+    }
+
     //
     // waitfor
     //
@@ -296,7 +360,7 @@ void CCommand::parse(const char *line, int lineNumber)
         m_type = CMD_WAITFOR;
         params_WAITFOR.m_channelIndex = -1;
         params_WAITFOR.m_timeoutMS = -1;
-        params_WAITFOR.m_expectedString = NULL;
+        params_WAITFOR.m_expectedString.clear();
         if (args.size() >= 2)
         {
             if ((args[1] == "a") || (args[1] == "A") || (args[1] == "0"))
@@ -314,9 +378,62 @@ void CCommand::parse(const char *line, int lineNumber)
         }
         if (args.size() >= 4)
         {
-            params_WAITFOR.m_expectedString =  new QString(args[3]);
+            params_WAITFOR.m_expectedString = args[3];
+        }
+        if ((params_WAITFOR.m_timeoutMS <= 0) || (params_WAITFOR.m_channelIndex < 0) || params_WAITFOR.m_expectedString.isEmpty() )
+        {
+            char msg[500];
+            sprintf(msg, "malformed command on line %d: %s", lineNumber,  line+1);
+            QMessageBox msgBox;
+            msgBox.setText(msg);
+            msgBox.exec();
+            m_type = CMD_UNKNOWN;
+        }
+        return;
+    }
+
+    //
+    // readblock
+    //
+    if (args[0] == "readblock")
+    {
+        m_type = CMD_READBLOCK;
+        params_READBLOCK.m_channelIndex = -1;
+        params_READBLOCK.m_sampleCount = 0;
+        params_READBLOCK.m_sampleRate = 0.0;
+        params_READBLOCK.m_format = BLOCK_TEXT;
+        bool formatValid = true;
+        if (args.size() >= 2)
+        {
+            if ((args[1] == "a") || (args[1] == "A") || (args[1] == "0"))
+            {
+                params_READBLOCK.m_channelIndex = 0;
+            }
+            else if ((args[1] == "b") || (args[1] == "B") || (args[1] == "1"))
+            {
+                params_READBLOCK.m_channelIndex = 1;
+            }
+        }
+        if (args.size() >= 3)
+        {
+            params_READBLOCK.m_sampleCount = args[2].toInt();
+        }
+        if (args.size() >= 4)
+        {
+            params_READBLOCK.m_sampleRate = args[3].toDouble();
+        }
+        if (args.size() >= 5)
+        {
+            if (args[4] == "text")
+                params_READBLOCK.m_format = BLOCK_TEXT;
+            else if (args[4] == "u8")
+                params_READBLOCK.m_format = BLOCK_U8;
+            else if (args[4] == "s16")
+                params_READBLOCK.m_format = BLOCK_S16;
+            else
+                formatValid = false;
         }
-        if ((params_WAITFOR.m_timeoutMS <= 0) || (params_WAITFOR.m_channelIndex < 0) || (params_WAITFOR.m_expectedString==NULL) )
+        if ((params_READBLOCK.m_channelIndex < 0) || (params_READBLOCK.m_sampleCount <= 0) || (params_READBLOCK.m_sampleRate < 0.0) || !formatValid)
         {
             char msg[500];
             sprintf(msg, "malformed command on line %d: %s", lineNumber,  line+1);
@@ -328,6 +445,30 @@ void CCommand::parse(const char *line, int lineNumber)
         return;
     }
 
+    //
+    // expect_rms, expect_peak_freq and expect_thd
+    //
+    if ((args[0] == "expect_rms") || (args[0] == "expect_peak_freq") || (args[0] == "expect_thd"))
+    {
+        if (args[0] == "expect_rms")
+            m_type = CMD_EXPECT_RMS;
+        else if (args[0] == "expect_peak_freq")
+            m_type = CMD_EXPECT_PEAK_FREQ;
+        else
+            m_type = CMD_EXPECT_THD;
+        bool b1=false, b2=false;
+        if (args.size() >= 3)
+        {
+            m_argMin = args[1].toDouble(&b1);
+            m_argMax = args[2].toDouble(&b2);
+        }
+        if (!b1 || !b2)
+        {
+            m_type = CMD_UNKNOWN;
+        }
+        return;
+    }
+
     //
     // sleep
     //
@@ -346,6 +487,13 @@ void CCommand::parse(const char *line, int lineNumber)
         m_type = CMD_PROMPT;
         m_stringArg = m_line.right(m_line.size()-6);
         m_stringArg = m_stringArg.trimmed();
+        m_argInteger = 0;
+        if ((args.size() >= 3) && (args[1] == "async"))
+        {
+            m_argInteger = 1;    // posted to the operator queue
+            m_stringArg = m_stringArg.right(m_stringArg.size()-5);
+            m_stringArg = m_stringArg.trimmed();
+        }
         return;
     }
 
@@ -360,6 +508,53 @@ void CCommand::parse(const char *line, int lineNumber)
         return;
     }
 
+    //
+    // retry
+    //
+    if (args[0] == "retry")
+    {
+        m_type = CMD_RETRY;
+        bool b1=false, b2=false;
+        if (args.size() >= 3)
+        {
+            m_argInteger = args[1].toInt(&b1);     // number of retries
+            m_argInteger2 = args[2].toInt(&b2);    // ms between retries
+        }
+        if (args.size() >= 4)
+        {
+            m_stringArg = args[3];
+        }
+        if (  !b1 || !b2 || (m_argInteger < 0) || (m_argInteger2 < 0)
+           || (!m_stringArg.isEmpty() && (m_stringArg != "once")) )
+        {
+            m_type = CMD_UNKNOWN;
+        }
+        return;
+    }
+
+    //
+    // parallel blocks (the braces may be written with or without spaces)
+    //
+    QString compact = m_line;
+    compact.remove(QRegExp("[ \t]"));
+    if (compact == "parallel{")
+    {
+        m_type = CMD_PARALLEL;
+        m_argInteger = -1;     // index of the "} / {", set when the script is loaded
+        m_argInteger2 = -1;    // index of the closing "}"
+        return;
+    }
+    if (compact == "}/{")
+    {
+        m_type = CMD_PARALLEL_NEXT;
+        return;
+    }
+    if (compact == "}")
+    {
+        m_type = CMD_PARALLEL_END;
+        return;
+    }
+
     //
     // end_on_error
     //
@@ -376,3 +571,55 @@ void CCommand::parse(const char *line, int lineNumber)
 }
 
 
+/*!
+ * @brief Returns the text of a sendline command as it is written to the port
+ *
+ * Any trailing comment is removed, the same as is done when the
+ * command is transmitted.
+ *
+ * @return the command string without comments or surrounding white space
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CCommand::getTransmitString() const
+{
+    int index;
+    QString cmd = m_stringArg;
+
+    index = cmd.indexOf("//");
+    if (index >= 0)
+        cmd.truncate(index);
+    index = cmd.indexOf("#");
+    if (index >= 0)
+        cmd.truncate(index);
+
+    return(cmd.trimmed());
+}
+
+
+/*!
+ * @brief Reports if the command is one of the expect commands
+ *
+ * @return true for the commands that produce a test result
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CCommand::isExpect() const
+{
+    switch (m_type)
+    {
+    case CMD_EXPECT:
+    case CMD_EXPECT_CHAR:
+    case CMD_EXPECT_STR:
+    case CMD_EXPECT_AVG:
+    case CMD_EXPECT_STATS:
+    case CMD_EXPECT_RMS:
+    case CMD_EXPECT_PEAK_FREQ:
+    case CMD_EXPECT_THD:
+        return(true);
+    default:
+        return(false);
+    }
+}
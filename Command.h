@@ -13,6 +13,7 @@
  *  Version | Author       | Date        | Description
  *  :--:    | :-----       | :--:        | :----------
  *   1      | J. Peterson  | 02/13/2015  | initial version
+ *   2      | agent        | 10/19/2026  | statistics, block capture, retry and parallel commands
  *
 */
 #ifndef COMMAND_H
@@ -40,7 +41,10 @@ public:
         CMD_COMMENT,     // any line starting with either "#" or "//"
         CMD_TEST,        // test <string>
         CMD_DESC,        // desc <string>
-        CMD_PROMPT,      // prompt <string>
+        CMD_REQUIRES,    // requires <test name>[, <test name>...]
+        CMD_GROUP,       // group <string> - consecutive tests of a group may be reordered
+        CMD_RETRY,       // retry <integer count> <integer backoff ms> [once]
+        CMD_PROMPT,      // prompt [async] <string>
         CMD_PAUSE,       // pause <string>
         CMD_SLEEP,       // sleep <integer ms>
         CMD_SENDLINE_A,  // sendline_a <string>
@@ -53,13 +57,24 @@ public:
         CMD_EXPECT,      // expect <integer field> <integer min> <integer max>
         CMD_EXPECT_CHAR, // expect_char <integer field> <integer char number> <char>
         CMD_EXPECT_STR,  // expect_str <integer field> <string - pattern to match>
+        CMD_EXPECT_AVG,  // expect_avg <integer field> <min> <max> <integer samples>
+        CMD_EXPECT_STATS,// expect_stats <integer field> <min> <max> <integer samples>
         CMD_WAITFOR,     // wait for specified string
+        CMD_READBLOCK,   // readblock <a|b> <integer samples> [rate hz] [text|u8|s16]
+        CMD_EXPECT_RMS,  // expect_rms <min> <max>
+        CMD_EXPECT_PEAK_FREQ, // expect_peak_freq <min hz> <max hz>
+        CMD_EXPECT_THD,  // expect_thd <min %> <max %>
+        CMD_PARALLEL,    // parallel { - start of the first branch of a parallel block
+        CMD_PARALLEL_NEXT, // } / { - start of the second branch
+        CMD_PARALLEL_END,  // } - end of the parallel block (the join)
         CMD_END_ON_ERROR
     };
 
     CCommand();
     ~CCommand();
     void parse(const char *line, int lineNumber);
+    QString getTransmitString() const;
+    bool isExpect() const;
 
 public:
     commandType_t  m_type;
@@ -81,8 +96,23 @@ public:
     {
         int      m_channelIndex;
         int      m_timeoutMS;
-        QString *m_expectedString;
+        QString  m_expectedString;
     } params_WAITFOR;
+
+    enum blockFormat_t
+    {
+        BLOCK_TEXT,      // numeric samples as text, any number per line
+        BLOCK_U8,        // binary, unsigned 8 bit
+        BLOCK_S16        // binary, signed 16 bit little endian
+    };
+
+    struct
+    {
+        int            m_channelIndex;
+        int            m_sampleCount;
+        double         m_sampleRate;
+        blockFormat_t  m_format;
+    } params_READBLOCK;
 };
 
 
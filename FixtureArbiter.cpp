@@ -0,0 +1,443 @@
+/*!
+ * @file FixtureArbiter.cpp
+ * @brief Implements the CFixtureArbiter class
+ *
+ * This class shares the fixture port between the positions of a panel
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include <QMutexLocker>
+#include <QTime>
+#include "FixtureArbiter.h"
+#include "Abort.h"
+
+
+/*!
+ * @brief CFixtureArbiter constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CFixtureArbiter::CFixtureArbiter(QObject *parent) :
+    QObject(parent)
+{
+    m_timeout_ms = 100;
+    reset();
+}
+
+
+/*!
+ * @brief CFixtureArbiter destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CFixtureArbiter::~CFixtureArbiter()
+{
+    m_waiters.clear();
+    m_selections.clear();
+}
+
+
+/*!
+ * @brief Sets the fixture port (owned by the main window)
+ *
+ * @param[in] port - the fixture port
+ * @param[in] outputDelay_ms - delay between transmitted characters
+ * @param[in] timeout_ms - read timeout of the fixture port
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::setPort(QSerialPort *port, int outputDelay_ms, int timeout_ms)
+{
+    m_channel.setPort(port);
+    m_channel.setOutputDelay(outputDelay_ms);
+    m_timeout_ms = timeout_ms;
+}
+
+
+/*!
+ * @brief Forgets the state of the fixture and the statistics of the last run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::reset()
+{
+    QMutexLocker lock(&m_mutex);
+    m_waiters.clear();
+    m_nextTicket = 0;
+    m_holder = -1;
+    m_lastHolder = -1;
+    m_nextTag.clear();
+    m_inEffect.clear();
+    m_selections.clear();
+    m_grants.clear();
+    m_wait_ms.clear();
+    m_restores = 0;
+}
+
+
+/*!
+ * @brief Returns the waiter that gets the fixture next
+ *
+ * @return index into the waiter list, -1 if no one is waiting
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CFixtureArbiter::nextWaiter()
+{
+    int best = -1;
+    for (unsigned int k=0; k<m_waiters.size(); k++)
+    {
+        if (  (best < 0)
+           || (m_waiters[k].m_urgent && !m_waiters[best].m_urgent)
+           || ( (m_waiters[k].m_urgent == m_waiters[best].m_urgent)
+             && (m_waiters[k].m_ticket < m_waiters[best].m_ticket) ) )
+        {
+            best = k;
+        }
+    }
+    return(best);
+}
+
+
+/*!
+ * @brief Waits until the position holds the fixture
+ *
+ * This is called from the thread of the position.  When the fixture was
+ * last used by another position, the selections of this position are
+ * restored before this returns.
+ *
+ * @param[in] position - the position asking for the fixture
+ * @param[in] urgent - true for the OnAbort/OnExit cleanup
+ * @return false if the run was aborted while waiting
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureArbiter::acquire(int position, bool urgent)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_holder == position)
+    {
+        return(true);
+    }
+
+    waiter_t waiter;
+    waiter.m_position = position;
+    waiter.m_urgent = urgent;
+    waiter.m_ticket = m_nextTicket++;
+    m_waiters.push_back(waiter);
+
+    QTime t;
+    t.start();
+    while (true)
+    {
+        int next = nextWaiter();
+        if ((m_holder < 0) && (m_waiters[next].m_position == position))
+        {
+            m_waiters.erase(m_waiters.begin()+next);
+            break;
+        }
+        if (!urgent && CAbort::Instance()->abortRequested())
+        {
+            for (unsigned int k=0; k<m_waiters.size(); k++)
+            {
+                if (m_waiters[k].m_position == position)
+                {
+                    m_waiters.erase(m_waiters.begin()+k);
+                    break;
+                }
+            }
+            m_released.wakeAll();
+            return(false);
+        }
+        m_released.wait(&m_mutex, 50);
+    }
+
+    m_holder = position;
+    m_grants[position]++;
+    m_wait_ms[position] += t.elapsed();
+    bool restore = (m_lastHolder >= 0) && (m_lastHolder != position);
+    m_lastHolder = position;
+    lock.unlock();
+
+    if (restore)
+    {
+        QMetaObject::invokeMethod(this, "restoreSelections", Qt::BlockingQueuedConnection, Q_ARG(int, position));
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Gives up the fixture
+ *
+ * @param[in] position - the position holding the fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::release(int position)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_holder == position)
+    {
+        m_holder = -1;
+        m_released.wakeAll();
+    }
+}
+
+
+/*!
+ * @brief Marks the next command sent as a selection tagged with %POS%
+ *
+ * @param[in] tag - the sendline before %POS% was replaced
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::setNextTag(const QString &tag)
+{
+    QMutexLocker lock(&m_mutex);
+    m_nextTag = tag;
+}
+
+
+/*!
+ * @brief Keeps track of what a command sent to the fixture selects
+ *
+ * @param[in] command - the command as it was sent
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::commandSent(const QString &command)
+{
+    QMutexLocker lock(&m_mutex);
+    QString cmd = command.trimmed();
+    if (cmd.isEmpty())
+    {
+        // not sent, the fixture may be in any state
+        m_nextTag.clear();
+        m_inEffect.clear();
+        return;
+    }
+    QString key, value;
+    CFixtureState::action_t action = m_profile.classify(cmd, key, value);
+    if (action != CFixtureState::FIXTURE_IDEMPOTENT)
+    {
+        key = m_nextTag;
+    }
+    m_nextTag.clear();
+
+    if (key.isEmpty())
+    {
+        if (action != CFixtureState::FIXTURE_NEUTRAL)
+        {
+            m_inEffect.clear();
+        }
+        return;
+    }
+
+    m_inEffect[key] = cmd;
+    if (m_holder < 0)
+    {
+        return;
+    }
+    std::vector<selection_t> &selections = m_selections[m_holder];
+    for (unsigned int k=0; k<selections.size(); k++)
+    {
+        if (selections[k].m_key == key)
+        {
+            selections[k].m_command = cmd;
+            return;
+        }
+    }
+    selection_t selection;
+    selection.m_key = key;
+    selection.m_command = cmd;
+    selections.push_back(selection);
+}
+
+
+/*!
+ * @brief Sends the selections of a position that another position changed
+ *
+ * @param[in] position - the position that now holds the fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::restoreSelections(int position)
+{
+    std::vector<selection_t> selections;
+    {
+        QMutexLocker lock(&m_mutex);
+        selections = m_selections[position];
+    }
+
+    for (unsigned int k=0; k<selections.size(); k++)
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            std::map<QString, QString>::iterator it = m_inEffect.find(selections[k].m_key);
+            if ((it != m_inEffect.end()) && (it->second == selections[k].m_command))
+            {
+                continue;
+            }
+            m_restores++;
+        }
+
+        char msg[500];
+        sprintf(msg, "[P%d] restoring fixture selection: %s", position, selections[k].m_command.toLocal8Bit().data());
+        logStringGray(msg);
+
+        char echo[1024];
+        bool sent = m_channel.send(selections[k].m_command.toLocal8Bit());
+        bool echoed = m_channel.readLine(echo, sizeof(echo), m_timeout_ms);
+
+        QMutexLocker lock(&m_mutex);
+        if (sent && echoed)
+        {
+            m_inEffect[selections[k].m_key] = selections[k].m_command;
+        }
+        else
+        {
+            m_inEffect.clear();
+        }
+    }
+}
+
+
+/*!
+ * @brief Sends a command to the fixture (called by the holder)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureArbiter::send(const QString &command)
+{
+    bool sent = m_channel.send(command.toLocal8Bit());
+    commandSent(sent ? command : QString());
+    return(sent);
+}
+
+
+/*!
+ * @brief Reads a line from the fixture into the reply (called by the holder)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureArbiter::readLine(int msTimeout)
+{
+    char buffer[10*1024];
+    bool ok = m_channel.readLine(buffer, sizeof(buffer), msTimeout);
+    m_reply = buffer;
+    return(ok);
+}
+
+
+/*!
+ * @brief Reads raw bytes from the fixture into the reply (called by the holder)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CFixtureArbiter::readBytes(int count, int msTimeout)
+{
+    m_reply.resize(count);
+    int n = m_channel.readBytes(m_reply.data(), count, msTimeout);
+    m_reply.resize(n);
+    return(n);
+}
+
+
+/*!
+ * @brief Discards what the fixture has sent (called by the holder)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::flush()
+{
+    m_channel.flush();
+}
+
+
+/*!
+ * @brief Starts sending a command without waiting (called by the holder)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureArbiter::startCommand(const QString &command)
+{
+    bool started = m_channel.startCommand(command.toLocal8Bit());
+    commandSent(started ? command : QString());
+    return(started);
+}
+
+
+/*!
+ * @brief Writes the next character of the command started by startCommand
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CFixtureArbiter::pollOutput()
+{
+    return(m_channel.pollOutput());
+}
+
+
+/*!
+ * @brief Reads a line into the reply if a whole line has arrived (called by the holder)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureArbiter::pollLine()
+{
+    char buffer[10*1024];
+    bool ok = m_channel.pollLine(buffer, sizeof(buffer));
+    m_reply = buffer;
+    return(ok);
+}
+
+
+/*!
+ * @brief Formats the use of the fixture during the last run
+ *
+ * @param[out] lines - lines of the report are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureArbiter::getReport(std::vector<QString> &lines)
+{
+    QMutexLocker lock(&m_mutex);
+    char msg[200];
+    for (std::map<int, int>::iterator it = m_grants.begin(); it != m_grants.end(); ++it)
+    {
+        sprintf(msg, "Fixture: position %d used it %d times, waited %0.3lf s",
+                it->first, it->second, m_wait_ms[it->first]/1000.0);
+        lines.push_back(msg);
+    }
+    sprintf(msg, "Fixture: %d selection(s) restored", m_restores);
+    lines.push_back(msg);
+}
@@ -0,0 +1,122 @@
+/*!
+ * @file FixtureArbiter.h
+ * @brief Declares the CFixtureArbiter class
+ *
+ * This class shares the fixture port between the positions of a panel
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef FIXTUREARBITER_H
+#define FIXTUREARBITER_H
+
+#include <map>
+#include <vector>
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QByteArray>
+#include <QString>
+#include "SerialChannel.h"
+#include "FixtureState.h"
+
+/*!
+ * @brief This class serializes the use of the fixture by the positions of a panel
+ *
+ * A position holds the fixture from its first fixture command until it goes
+ * on to talk to its DUT (see CTestScript::leaseFixture).  Positions waiting
+ * for the fixture get it in the order they asked for it, except that the
+ * OnAbort/OnExit cleanup of a position goes first.
+ *
+ * The fixture port belongs to the main window and all of the I/O is done in
+ * the main thread; the positions call the I/O slots with blocking queued
+ * connections while they hold the fixture.
+ *
+ * The selections a position makes (the idempotent commands of the fixture
+ * profile and the sendlines tagged with %POS%) are remembered.  When a
+ * position gets the fixture back after another position used it, the
+ * selections that the other position changed are sent again first.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CFixtureArbiter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CFixtureArbiter(QObject *parent = 0);
+    ~CFixtureArbiter();
+
+    void setPort(QSerialPort *port, int outputDelay_ms, int timeout_ms);
+    QSerialPort *getPort() { return(m_channel.getPort()); }
+    bool loadProfile(const QString &filename) { return(m_profile.loadProfile(filename)); }
+    void reset();
+
+    bool acquire(int position, bool urgent);
+    void release(int position);
+    void setNextTag(const QString &tag);
+    const QByteArray &getReply() { return(m_reply); }
+    void getReport(std::vector<QString> &lines);
+
+public slots:
+    bool send(const QString &command);
+    bool readLine(int msTimeout);
+    int  readBytes(int count, int msTimeout);
+    void flush();
+    bool startCommand(const QString &command);
+    int  pollOutput();
+    bool pollLine();
+
+private slots:
+    void restoreSelections(int position);
+
+signals:
+    void logStringGray(const char *string);
+
+private:
+    int  nextWaiter();
+    void commandSent(const QString &command);
+
+private:
+    struct waiter_t
+    {
+        int   m_position;
+        bool  m_urgent;       // OnAbort/OnExit cleanup
+        int   m_ticket;       // order of the request
+    };
+    struct selection_t
+    {
+        QString  m_key;       // profile key or %POS% template
+        QString  m_command;
+    };
+
+    QMutex                     m_mutex;
+    QWaitCondition             m_released;
+    std::vector<waiter_t>      m_waiters;
+    int                        m_nextTicket;
+    int                        m_holder;          // position holding the fixture, -1 if none
+    int                        m_lastHolder;
+    QString                    m_nextTag;         // %POS% template of the next command sent
+
+    CSerialChannel             m_channel;
+    int                        m_timeout_ms;
+    QByteArray                 m_reply;           // result of the last read
+    CFixtureState              m_profile;
+    std::map<QString, QString> m_inEffect;        // key -> last command sent for it
+    std::map<int, std::vector<selection_t> > m_selections;   // position -> its selections
+
+    std::map<int, int>         m_grants;          // position -> number of times it got the fixture
+    std::map<int, int>         m_wait_ms;         // position -> time spent waiting for the fixture
+    int                        m_restores;        // selections sent again
+};
+
+#endif // FIXTUREARBITER_H
@@ -0,0 +1,285 @@
+/*!
+ * @file FixtureState.cpp
+ * @brief Implements the CFixtureState class
+ *
+ * This class keeps a model of the state of the test fixture
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include <QStringList>
+#include "FixtureState.h"
+
+
+/*!
+ * @brief CFixtureState constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CFixtureState::CFixtureState()
+{
+    m_rules.clear();
+    m_state.clear();
+    m_commands.clear();
+}
+
+
+/*!
+ * @brief CFixtureState destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CFixtureState::~CFixtureState()
+{
+    m_rules.clear();
+    m_settleRules.clear();
+    m_state.clear();
+}
+
+
+/*!
+ * @brief Reads the fixture profile
+ *
+ * Lines that are not understood are ignored.
+ *
+ * @param[in] filename - name of the profile file
+ * @return true if the file was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureState::loadProfile(const QString &filename)
+{
+    m_rules.clear();
+    m_settleRules.clear();
+    m_state.clear();
+
+    FILE *fp = fopen(filename.toLocal8Bit().data(), "r");
+    if (fp == NULL)
+    {
+        return(false);
+    }
+
+    while (!feof(fp))
+    {
+        char lineBuffer[1024];
+        if (!fgets(lineBuffer, sizeof(lineBuffer), fp))
+        {
+            continue;
+        }
+
+        QString line = QString(lineBuffer).trimmed();
+        if (line.isEmpty() || line.startsWith("#"))
+        {
+            continue;
+        }
+
+        QStringList args = line.split(QRegExp("[ \t]"), QString::SkipEmptyParts);
+        if (args.size() < 2)
+        {
+            continue;
+        }
+
+        rule_t rule;
+        rule.m_pattern = QRegExp(args[1]);
+        if (!rule.m_pattern.isValid())
+        {
+            continue;
+        }
+        if ((args[0] == "idempotent") && (args.size() >= 4))
+        {
+            rule.m_action = FIXTURE_IDEMPOTENT;
+            rule.m_key = args[2];
+            rule.m_value = args[3];
+        }
+        else if (args[0] == "neutral")
+        {
+            rule.m_action = FIXTURE_NEUTRAL;
+        }
+        else if (args[0] == "invalidate")
+        {
+            rule.m_action = FIXTURE_INVALIDATE;
+        }
+        else if ((args[0] == "settle") && (args.size() >= 3))
+        {
+            rule.m_action = FIXTURE_NEUTRAL;
+            rule.m_value = args[2];
+            m_settleRules.push_back(rule);
+            continue;
+        }
+        else
+        {
+            continue;
+        }
+        m_rules.push_back(rule);
+    }
+
+    fclose(fp);
+    return(true);
+}
+
+
+/*!
+ * @brief Forgets everything that is known about the fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureState::invalidate()
+{
+    m_state.clear();
+    m_commands.clear();
+}
+
+
+/*!
+ * @brief Replaces %1..%9 in a key or value with the captures of a match
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CFixtureState::substitute(const QString &pattern, const QRegExp &match)
+{
+    QString result = pattern;
+    for (int n=match.captureCount(); n>=1; n--)
+    {
+        result.replace(QString("%%1").arg(n), match.cap(n));
+    }
+    return(result);
+}
+
+
+/*!
+ * @brief Finds the rule that applies to a fixture command
+ *
+ * @param[in] command - the command as it is transmitted
+ * @param[out] key - state set by an idempotent command
+ * @param[out] value - value the key is set to by an idempotent command
+ * @return the action of the rule, FIXTURE_UNKNOWN if no rule matched
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CFixtureState::action_t CFixtureState::classify(const QString &command, QString &key, QString &value)
+{
+    for (unsigned int i=0; i<m_rules.size(); i++)
+    {
+        QRegExp match = m_rules[i].m_pattern;
+        if (match.exactMatch(command))
+        {
+            if (m_rules[i].m_action == FIXTURE_IDEMPOTENT)
+            {
+                key = substitute(m_rules[i].m_key, match);
+                value = substitute(m_rules[i].m_value, match);
+            }
+            return(m_rules[i].m_action);
+        }
+    }
+    return(FIXTURE_UNKNOWN);
+}
+
+
+/*!
+ * @brief Reports if an idempotent command would not change the fixture
+ *
+ * @param[in] command - the command as it is transmitted
+ * @return true if the command is idempotent and its state is already in effect
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CFixtureState::isInEffect(const QString &command)
+{
+    QString key, value;
+    if (classify(command, key, value) != FIXTURE_IDEMPOTENT)
+    {
+        return(false);
+    }
+
+    std::map<QString, QString>::iterator it = m_state.find(key);
+    return((it != m_state.end()) && (it->second == value));
+}
+
+
+/*!
+ * @brief Updates the model after a command was sent to the fixture
+ *
+ * @param[in] command - the command as it was transmitted
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureState::commandSent(const QString &command)
+{
+    QString key, value;
+    switch (classify(command, key, value))
+    {
+    case FIXTURE_IDEMPOTENT:
+        m_state[key] = value;
+        m_commands[key] = command;
+        break;
+
+    case FIXTURE_NEUTRAL:
+        break;
+
+    case FIXTURE_INVALIDATE:
+    case FIXTURE_UNKNOWN:
+    default:
+        invalidate();
+        break;
+    }
+}
+
+
+/*!
+ * @brief Returns the settle time of a fixture command from the profile
+ *
+ * @param[in] command - the command as it is transmitted
+ * @return the settle time in ms, -1 if no settle line matches
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CFixtureState::getSettleMS(const QString &command)
+{
+    for (unsigned int i=0; i<m_settleRules.size(); i++)
+    {
+        if (m_settleRules[i].m_pattern.exactMatch(command))
+        {
+            return(m_settleRules[i].m_value.toInt());
+        }
+    }
+    return(-1);
+}
+
+
+/*!
+ * @brief Returns the commands that set the known state of the fixture
+ *
+ * Sending these commands again puts the fixture back in the known state.
+ *
+ * @param[out] commands - one command per known key
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CFixtureState::getCommands(std::vector<QString> &commands)
+{
+    commands.clear();
+    std::map<QString, QString>::iterator it;
+    for (it = m_commands.begin(); it != m_commands.end(); ++it)
+    {
+        commands.push_back(it->second);
+    }
+}
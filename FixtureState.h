@@ -0,0 +1,85 @@
+/*!
+ * @file FixtureState.h
+ * @brief Declares the CFixtureState class
+ *
+ * This class keeps a model of the state of the test fixture
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef FIXTURESTATE_H
+#define FIXTURESTATE_H
+
+#include <map>
+#include <vector>
+#include <QString>
+#include <QRegExp>
+
+/*!
+ * @brief This class tracks the relays, MUX channels and sources of the fixture
+ *
+ * The fixture profile is a text file that classifies the commands sent to
+ * the fixture (port B).  Each line is one of:
+ *
+ *     idempotent <regex> <key> <value>   - the command sets key to value (%1..%9 are the captures)
+ *     neutral <regex>                    - the command does not change the tracked state
+ *     invalidate <regex>                 - the command may change anything (e.g. a reset)
+ *     settle <regex> <int ms>            - time the fixture needs after the command changes it
+ *
+ * Lines starting with "#" are comments.  The first rule whose regex matches
+ * the whole command is used.  A command that matches no rule is treated the
+ * same as an invalidate command.  The settle lines are separate from the
+ * other rules and are only used to estimate switching costs (see CTestReorder).
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CFixtureState
+{
+public:
+    enum action_t
+    {
+        FIXTURE_UNKNOWN,     // no rule matched
+        FIXTURE_IDEMPOTENT,
+        FIXTURE_NEUTRAL,
+        FIXTURE_INVALIDATE
+    };
+
+    CFixtureState();
+    ~CFixtureState();
+
+    bool     loadProfile(const QString &filename);
+    bool     isLoaded() { return(!m_rules.empty()); }
+    void     invalidate();
+    action_t classify(const QString &command, QString &key, QString &value);
+    bool     isInEffect(const QString &command);
+    void     commandSent(const QString &command);
+    int      getSettleMS(const QString &command);
+    void     getCommands(std::vector<QString> &commands);
+
+private:
+    struct rule_t
+    {
+        action_t  m_action;
+        QRegExp   m_pattern;
+        QString   m_key;
+        QString   m_value;
+    };
+    QString substitute(const QString &pattern, const QRegExp &match);
+
+private:
+    std::vector<rule_t>          m_rules;
+    std::vector<rule_t>          m_settleRules;   // m_value holds the settle time in ms
+    std::map<QString, QString>   m_state;     // key -> value, missing keys are unknown
+    std::map<QString, QString>   m_commands;  // key -> command that set the value
+};
+
+#endif // FIXTURESTATE_H
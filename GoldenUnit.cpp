@@ -0,0 +1,269 @@
+/*!
+ * @file GoldenUnit.cpp
+ * @brief Implements the CGoldenUnit class
+ *
+ * This class compares the runs of the golden board with its stored baseline
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QSettings>
+#include <QStringList>
+#include "GoldenUnit.h"
+
+
+/*!
+ * @brief CGoldenUnit constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CGoldenUnit::CGoldenUnit()
+{
+    m_baseline.clear();
+    m_tolerances.clear();
+    m_defaultTolerance_pct = 5.0;
+    m_lastCheckShift.clear();
+    m_lastCheckPassed = false;
+    m_filename.clear();
+    m_modified = false;
+}
+
+
+/*!
+ * @brief CGoldenUnit destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CGoldenUnit::~CGoldenUnit()
+{
+    m_baseline.clear();
+    m_tolerances.clear();
+}
+
+
+/*!
+ * @brief Builds the key used to store the golden value of an expect
+ *
+ * The "/" and "\" characters are used by QSettings to separate
+ * groups so they are replaced in the names.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CGoldenUnit::makeKey(const QString &scriptVersion, const QString &testName, int lineNumber)
+{
+    QString version = scriptVersion;
+    version.replace('/', '_');
+    version.replace('\\', '_');
+    QString test = testName;
+    test.replace('/', '_');
+    test.replace('\\', '_');
+
+    QString key = "Baseline/%1/L%2_%3";
+    return(key.arg(version.trimmed()).arg(lineNumber+1).arg(test.trimmed()));
+}
+
+
+/*!
+ * @brief Reads the baseline from the specified ini file
+ *
+ * @param[in] filename - name of the baseline file
+ * @return true if the file was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CGoldenUnit::load(const QString &filename)
+{
+    m_baseline.clear();
+    m_tolerances.clear();
+    m_filename = filename;
+    m_modified = false;
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError)
+    {
+        return(false);
+    }
+
+    m_lastCheckShift = settings.value("LastCheck/Shift", "").toString();
+    m_lastCheckPassed = settings.value("LastCheck/Passed", "false").toBool();
+
+    QStringList keys = settings.allKeys();
+    for (int i=0; i<keys.size(); i++)
+    {
+        if (keys[i].startsWith("Baseline/"))
+        {
+            m_baseline[keys[i]] = settings.value(keys[i], 0.0).toDouble();
+        }
+    }
+
+    //
+    // Tolerances are entered by hand, e.g. "TP1 Voltage=10"
+    //
+    settings.beginGroup("Tolerances");
+    keys = settings.childKeys();
+    for (int i=0; i<keys.size(); i++)
+    {
+        bool ok = false;
+        double percent = settings.value(keys[i], "").toDouble(&ok);
+        if (ok && (percent >= 0.0))
+        {
+            m_tolerances[keys[i].trimmed()] = percent;
+        }
+    }
+    settings.endGroup();
+    return(true);
+}
+
+
+/*!
+ * @brief Writes the baseline to the file it was loaded from
+ *
+ * The tolerances are not written, they are only edited by hand.
+ *
+ * @return true if successful (or there was nothing to write), false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CGoldenUnit::save()
+{
+    if (!m_modified || m_filename.isEmpty())
+    {
+        return(true);
+    }
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    settings.remove("Baseline");
+    std::map<QString, double>::iterator it;
+    for (it = m_baseline.begin(); it != m_baseline.end(); ++it)
+    {
+        settings.setValue(it->first, QString::number(it->second, 'g', 17));
+    }
+    settings.setValue("LastCheck/Shift", m_lastCheckShift);
+    settings.setValue("LastCheck/Passed", m_lastCheckPassed);
+    settings.sync();
+    m_modified = false;
+
+    return(settings.status() == QSettings::NoError);
+}
+
+
+/*!
+ * @brief Returns the tolerance of a test
+ *
+ * @param[in] testName - name of the test
+ * @return the allowed drift in percent of the span of the limits
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CGoldenUnit::getTolerance(const QString &testName)
+{
+    std::map<QString, double>::iterator it = m_tolerances.find(testName.trimmed());
+    if (it == m_tolerances.end())
+    {
+        return(m_defaultTolerance_pct);
+    }
+    return(it->second);
+}
+
+
+/*!
+ * @brief Returns true if the golden board has been run with a script version
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CGoldenUnit::hasBaseline(const QString &scriptVersion)
+{
+    QString prefix = makeKey(scriptVersion, "", 0);
+    prefix.truncate(prefix.lastIndexOf('/') + 1);
+    std::map<QString, double>::iterator it = m_baseline.lower_bound(prefix);
+    return((it != m_baseline.end()) && it->first.startsWith(prefix));
+}
+
+
+/*!
+ * @brief Forgets the golden values of a script version
+ *
+ * The next run of the golden board with the version records new values.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CGoldenUnit::clearBaseline(const QString &scriptVersion)
+{
+    QString prefix = makeKey(scriptVersion, "", 0);
+    prefix.truncate(prefix.lastIndexOf('/') + 1);
+    std::map<QString, double>::iterator it = m_baseline.lower_bound(prefix);
+    while ((it != m_baseline.end()) && it->first.startsWith(prefix))
+    {
+        m_baseline.erase(it++);
+    }
+    m_lastCheckShift.clear();
+    m_lastCheckPassed = false;
+    m_modified = true;
+}
+
+
+/*!
+ * @brief Records the golden value of an expect
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CGoldenUnit::setBaseline(const QString &scriptVersion, const QString &testName, int lineNumber, double value)
+{
+    m_baseline[makeKey(scriptVersion, testName, lineNumber)] = value;
+    m_modified = true;
+}
+
+
+/*!
+ * @brief Looks up the golden value of an expect
+ *
+ * @param[out] value - the golden value
+ * @return false if the expect has no golden value
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CGoldenUnit::getBaseline(const QString &scriptVersion, const QString &testName, int lineNumber, double &value)
+{
+    std::map<QString, double>::iterator it = m_baseline.find(makeKey(scriptVersion, testName, lineNumber));
+    if (it == m_baseline.end())
+    {
+        return(false);
+    }
+    value = it->second;
+    return(true);
+}
+
+
+/*!
+ * @brief Records the result of a golden run
+ *
+ * @param[in] shiftId - the shift the golden board was run in
+ * @param[in] passed - false if a value drifted or the run did not finish
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CGoldenUnit::setLastCheck(const QString &shiftId, bool passed)
+{
+    m_lastCheckShift = shiftId;
+    m_lastCheckPassed = passed;
+    m_modified = true;
+}
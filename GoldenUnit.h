@@ -0,0 +1,70 @@
+/*!
+ * @file GoldenUnit.h
+ * @brief Declares the CGoldenUnit class
+ *
+ * This class compares the runs of the golden board with its stored baseline
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef GOLDENUNIT_H
+#define GOLDENUNIT_H
+
+#include <map>
+#include <QString>
+
+/*!
+ * @brief This class holds the baseline of the golden board of the fixture
+ *
+ * The baseline is the value of each numeric expect from the first run of
+ * the golden board with a script version, keyed by script version, test and
+ * line.  Later runs of the golden board are compared with it; a value that
+ * moved by more than the tolerance of its test (a percentage of the span of
+ * the limits of the expect) points at a fixture channel that drifted.
+ *
+ * The file also remembers the shift of the last golden run and whether it
+ * passed, so that production units can be held until the golden board has
+ * been run at the start of the shift.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CGoldenUnit
+{
+public:
+    CGoldenUnit();
+    ~CGoldenUnit();
+
+    bool   load(const QString &filename);
+    bool   save();
+    void   setDefaultTolerance(double percent) { m_defaultTolerance_pct = percent; }
+    double getTolerance(const QString &testName);
+    bool   hasBaseline(const QString &scriptVersion);
+    void   clearBaseline(const QString &scriptVersion);
+    void   setBaseline(const QString &scriptVersion, const QString &testName, int lineNumber, double value);
+    bool   getBaseline(const QString &scriptVersion, const QString &testName, int lineNumber, double &value);
+    void   setLastCheck(const QString &shiftId, bool passed);
+    bool   checkedInShift(const QString &shiftId) { return(m_lastCheckPassed && (m_lastCheckShift == shiftId)); }
+
+private:
+    QString makeKey(const QString &scriptVersion, const QString &testName, int lineNumber);
+
+private:
+    std::map<QString, double>  m_baseline;      //! golden value of each expect
+    std::map<QString, double>  m_tolerances;    //! test name -> tolerance in percent of the limit span
+    double                     m_defaultTolerance_pct;
+    QString                    m_lastCheckShift;
+    bool                       m_lastCheckPassed;
+    QString                    m_filename;
+    bool                       m_modified;
+};
+
+#endif // GOLDENUNIT_H
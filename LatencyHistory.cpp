@@ -0,0 +1,210 @@
+/*!
+ * @file LatencyHistory.cpp
+ * @brief Implements the CLatencyHistory class
+ *
+ * This class keeps the history of observed reply latencies for each readline
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <math.h>
+#include <algorithm>
+#include <QSettings>
+#include <QStringList>
+#include "LatencyHistory.h"
+
+#define MAX_SAMPLES_PER_KEY  2000
+
+
+/*!
+ * @brief CLatencyHistory constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CLatencyHistory::CLatencyHistory()
+{
+    m_samples.clear();
+    m_filename.clear();
+    m_modified = false;
+}
+
+
+/*!
+ * @brief CLatencyHistory destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CLatencyHistory::~CLatencyHistory()
+{
+    m_samples.clear();
+}
+
+
+/*!
+ * @brief Builds the key used to store the samples of a readline
+ *
+ * The "/" and "\" characters are used by QSettings to separate
+ * groups so they are replaced in the names.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CLatencyHistory::makeKey(const QString &scriptName, const QString &testName, int lineNumber)
+{
+    QString script = scriptName;
+    script.replace('/', '_');
+    script.replace('\\', '_');
+    QString test = testName;
+    test.replace('/', '_');
+    test.replace('\\', '_');
+
+    QString key = "%1/L%2_%3";
+    return(key.arg(script).arg(lineNumber+1).arg(test.trimmed()));
+}
+
+
+/*!
+ * @brief Reads the history from the specified ini file
+ *
+ * @param[in] filename - name of the history file
+ * @return true if the file was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CLatencyHistory::load(const QString &filename)
+{
+    m_samples.clear();
+    m_filename = filename;
+    m_modified = false;
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError)
+    {
+        return(false);
+    }
+
+    QStringList keys = settings.allKeys();
+    for (int i=0; i<keys.size(); i++)
+    {
+        QStringList values = settings.value(keys[i], "").toString().split(',', QString::SkipEmptyParts);
+        std::vector<int> *pSamples = &m_samples[keys[i]];
+        pSamples->reserve(values.size());
+        for (int k=0; k<values.size(); k++)
+        {
+            pSamples->push_back(values[k].toInt());
+        }
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Writes the history to the file it was loaded from
+ *
+ * @return true if successful (or there was nothing to write), false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CLatencyHistory::save()
+{
+    if (!m_modified || m_filename.isEmpty())
+    {
+        return(true);
+    }
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    std::map<QString, std::vector<int> >::iterator it;
+    for (it = m_samples.begin(); it != m_samples.end(); ++it)
+    {
+        QStringList values;
+        for (unsigned int k=0; k<it->second.size(); k++)
+        {
+            values.append(QString::number(it->second[k]));
+        }
+        settings.setValue(it->first, values.join(","));
+    }
+    settings.sync();
+    m_modified = false;
+
+    return(settings.status() == QSettings::NoError);
+}
+
+
+/*!
+ * @brief Adds an observed latency to the history of a readline
+ *
+ * @param[in] scriptName - file name of the script
+ * @param[in] testName - name of the test containing the readline
+ * @param[in] lineNumber - line number of the readline
+ * @param[in] latency_ms - time from the end of the transmit to the reply
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CLatencyHistory::addSample(const QString &scriptName, const QString &testName, int lineNumber, int latency_ms)
+{
+    std::vector<int> *pSamples = &m_samples[makeKey(scriptName, testName, lineNumber)];
+    if (pSamples->size() >= MAX_SAMPLES_PER_KEY)
+    {
+        pSamples->erase(pSamples->begin());
+    }
+    pSamples->push_back(latency_ms);
+    m_modified = true;
+}
+
+
+/*!
+ * @brief Returns the number of samples held for a readline
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CLatencyHistory::getSampleCount(const QString &scriptName, const QString &testName, int lineNumber)
+{
+    std::map<QString, std::vector<int> >::iterator it = m_samples.find(makeKey(scriptName, testName, lineNumber));
+    if (it == m_samples.end())
+    {
+        return(0);
+    }
+    return(it->second.size());
+}
+
+
+/*!
+ * @brief Returns the specified percentile of the latencies of a readline
+ *
+ * @param[in] percentile - percentile to return (e.g. 99.9)
+ * @return the latency in ms, -1 if there are no samples
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CLatencyHistory::getPercentile(const QString &scriptName, const QString &testName, int lineNumber, double percentile)
+{
+    std::map<QString, std::vector<int> >::iterator it = m_samples.find(makeKey(scriptName, testName, lineNumber));
+    if ((it == m_samples.end()) || it->second.empty())
+    {
+        return(-1);
+    }
+
+    std::vector<int> sorted = it->second;
+    std::sort(sorted.begin(), sorted.end());
+    int index = (int)ceil(percentile / 100.0 * sorted.size()) - 1;
+    if (index < 0)
+        index = 0;
+    if (index >= (int)sorted.size())
+        index = sorted.size() - 1;
+    return(sorted[index]);
+}
@@ -0,0 +1,55 @@
+/*!
+ * @file LatencyHistory.h
+ * @brief Declares the CLatencyHistory class
+ *
+ * This class keeps the history of observed reply latencies for each readline
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef LATENCYHISTORY_H
+#define LATENCYHISTORY_H
+
+#include <map>
+#include <vector>
+#include <QString>
+
+/*!
+ * @brief This class holds reply latency samples keyed by script, test and line
+ *
+ * Only the most recent samples of each key are kept.  The history is
+ * stored in a local ini file so that it survives between runs.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CLatencyHistory
+{
+public:
+    CLatencyHistory();
+    ~CLatencyHistory();
+
+    bool load(const QString &filename);
+    bool save();
+    void addSample(const QString &scriptName, const QString &testName, int lineNumber, int latency_ms);
+    int  getSampleCount(const QString &scriptName, const QString &testName, int lineNumber);
+    int  getPercentile(const QString &scriptName, const QString &testName, int lineNumber, double percentile);
+
+private:
+    QString makeKey(const QString &scriptName, const QString &testName, int lineNumber);
+
+private:
+    std::map<QString, std::vector<int> >  m_samples;   //! latency samples in ms, oldest first
+    QString                               m_filename;
+    bool                                  m_modified;
+};
+
+#endif // LATENCYHISTORY_H
@@ -0,0 +1,231 @@
+/*!
+ * @file MeasurementStore.cpp
+ * @brief Implements the CMeasurementStore class
+ *
+ * This class keeps the result of every expect in a local SQLite database
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QMutexLocker>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariant>
+#include "MeasurementStore.h"
+
+
+/*!
+ * @brief CMeasurementStore constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CMeasurementStore::CMeasurementStore()
+{
+    m_connectionName = "measurements";
+    m_open = false;
+}
+
+
+/*!
+ * @brief CMeasurementStore destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CMeasurementStore::~CMeasurementStore()
+{
+    stop();
+}
+
+
+/*!
+ * @brief Starts the background thread and opens the database in it
+ *
+ * @param[in] filename - name of the SQLite file, created if it does not exist
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMeasurementStore::start(const QString &filename)
+{
+    if (m_thread.isRunning())
+    {
+        return;
+    }
+    m_filename = filename;
+    moveToThread(&m_thread);
+    m_thread.start();
+    QMetaObject::invokeMethod(this, "open", Qt::QueuedConnection);
+}
+
+
+/*!
+ * @brief Writes the rows still queued, closes the database and stops the thread
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMeasurementStore::stop()
+{
+    if (!m_thread.isRunning())
+    {
+        return;
+    }
+    QMetaObject::invokeMethod(this, "close", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+
+/*!
+ * @brief Queues the measurements of a run to be written
+ *
+ * @param[in] rows - the measurements of the run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMeasurementStore::addRun(const std::vector<row_t> &rows)
+{
+    if (rows.empty() || !m_thread.isRunning())
+    {
+        return;
+    }
+    {
+        QMutexLocker lock(&m_mutex);
+        m_pending.insert(m_pending.end(), rows.begin(), rows.end());
+    }
+    QMetaObject::invokeMethod(this, "writePending", Qt::QueuedConnection);
+}
+
+
+/*!
+ * @brief Opens the database and creates the table (background thread)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMeasurementStore::open()
+{
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    db.setDatabaseName(m_filename);
+    if (!db.open())
+    {
+        emit storeError("Could not open the measurement database: " + db.lastError().text());
+        return;
+    }
+
+    //
+    // WAL lets readers query the file while a run is written;
+    // NORMAL sync is safe in WAL mode and avoids a flush per commit
+    //
+    QSqlQuery query(db);
+    query.exec("PRAGMA journal_mode=WAL");
+    query.exec("PRAGMA synchronous=NORMAL");
+    bool ok = query.exec("CREATE TABLE IF NOT EXISTS measurements ("
+                         "id INTEGER PRIMARY KEY, "
+                         "serial_number TEXT NOT NULL, "
+                         "script_version TEXT, "
+                         "test_name TEXT, "
+                         "line INTEGER, "
+                         "command TEXT, "
+                         "value REAL, "
+                         "min REAL, "
+                         "max REAL, "
+                         "result TEXT, "
+                         "timestamp TEXT, "
+                         "duration_ms INTEGER, "
+                         "position INTEGER, "
+                         "retest INTEGER)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS measurements_serial ON measurements (serial_number)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS measurements_test ON measurements (script_version, test_name, line)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS measurements_time ON measurements (timestamp)");
+    if (!ok)
+    {
+        emit storeError("Could not create the measurement table: " + query.lastError().text());
+        return;
+    }
+    m_open = true;
+}
+
+
+/*!
+ * @brief Inserts the queued rows in one transaction (background thread)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMeasurementStore::writePending()
+{
+    std::vector<row_t> rows;
+    {
+        QMutexLocker lock(&m_mutex);
+        rows.swap(m_pending);
+    }
+    if (rows.empty() || !m_open)
+    {
+        return;
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    db.transaction();
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO measurements (serial_number, script_version, test_name, line, command, "
+                  "value, min, max, result, timestamp, duration_ms, position, retest) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    for (unsigned int k=0; k<rows.size(); k++)
+    {
+        const row_t &row = rows[k];
+        query.addBindValue(row.m_serialNumber);
+        query.addBindValue(row.m_scriptVersion);
+        query.addBindValue(row.m_testName);
+        query.addBindValue(row.m_line);
+        query.addBindValue(row.m_command);
+        query.addBindValue(row.m_valueValid ? QVariant(row.m_value) : QVariant(QVariant::Double));
+        query.addBindValue(row.m_limitsValid ? QVariant(row.m_min) : QVariant(QVariant::Double));
+        query.addBindValue(row.m_limitsValid ? QVariant(row.m_max) : QVariant(QVariant::Double));
+        query.addBindValue(row.m_passed ? "PASS" : "FAIL");
+        query.addBindValue(row.m_time.toString(Qt::ISODate));
+        query.addBindValue(row.m_duration_ms);
+        query.addBindValue(row.m_position);
+        query.addBindValue(row.m_retest ? 1 : 0);
+        if (!query.exec())
+        {
+            db.rollback();
+            emit storeError("Could not write the measurements: " + query.lastError().text());
+            return;
+        }
+    }
+    if (!db.commit())
+    {
+        emit storeError("Could not write the measurements: " + db.lastError().text());
+    }
+}
+
+
+/*!
+ * @brief Writes what is queued and closes the database (background thread)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMeasurementStore::close()
+{
+    writePending();
+    if (m_open)
+    {
+        QSqlDatabase::database(m_connectionName).close();
+        m_open = false;
+    }
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
@@ -0,0 +1,90 @@
+/*!
+ * @file MeasurementStore.h
+ * @brief Declares the CMeasurementStore class
+ *
+ * This class keeps the result of every expect in a local SQLite database
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef MEASUREMENTSTORE_H
+#define MEASUREMENTSTORE_H
+
+#include <vector>
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QString>
+#include <QDateTime>
+
+/*!
+ * @brief This class writes the measurements of each run to a SQLite database
+ *
+ * The database is opened in WAL mode so that yield and trend queries can
+ * read it while a run is being written.  The rows of a run are queued by
+ * addRun() and inserted in one transaction by a background thread, so the
+ * end of a run never waits on the disk.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CMeasurementStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * @brief One expect result
+     */
+    struct row_t
+    {
+        QString    m_serialNumber;
+        QString    m_scriptVersion;
+        QString    m_testName;
+        int        m_line;           // line of the expect in the script
+        QString    m_command;        // the expect command
+        bool       m_valueValid;
+        double     m_value;
+        bool       m_limitsValid;
+        double     m_min;
+        double     m_max;
+        bool       m_passed;
+        QDateTime  m_time;
+        int        m_duration_ms;
+        int        m_position;       // panel position, 0 when not on a panel
+        bool       m_retest;
+    };
+
+    CMeasurementStore();
+    ~CMeasurementStore();
+
+    void start(const QString &filename);
+    void stop();
+    void addRun(const std::vector<row_t> &rows);
+
+private slots:
+    void open();
+    void writePending();
+    void close();
+
+signals:
+    void storeError(const QString &message);
+
+private:
+    QThread             m_thread;
+    QMutex              m_mutex;
+    QString             m_filename;
+    QString             m_connectionName;
+    bool                m_open;
+    std::vector<row_t>  m_pending;     // rows waiting to be inserted
+};
+
+#endif // MEASUREMENTSTORE_H
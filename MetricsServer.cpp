@@ -0,0 +1,143 @@
+/*!
+ * @file MetricsServer.cpp
+ * @brief Implements the CMetricsServer class
+ *
+ * This class serves the station metrics over HTTP
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QHostAddress>
+#include "MetricsServer.h"
+#include "StationMetrics.h"
+
+#define MAX_REQUEST_SIZE  8192
+
+
+/*!
+ * @brief CMetricsServer constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CMetricsServer::CMetricsServer(QObject *parent) :
+    QObject(parent)
+{
+    connect(&m_server, SIGNAL(newConnection()), this, SLOT(newConnection()));
+}
+
+
+/*!
+ * @brief CMetricsServer destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CMetricsServer::~CMetricsServer()
+{
+    m_server.close();
+}
+
+
+/*!
+ * @brief Starts listening on all interfaces
+ *
+ * @param[in] port - the TCP port
+ * @return false if the port could not be opened
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CMetricsServer::start(int port)
+{
+    return(m_server.listen(QHostAddress::Any, port));
+}
+
+
+/*!
+ * @brief Accepts the pending connections
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMetricsServer::newConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        QTcpSocket *socket = m_server.nextPendingConnection();
+        connect(socket, SIGNAL(readyRead()), this, SLOT(readRequest()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+    }
+}
+
+
+/*!
+ * @brief Answers the request once its header has arrived
+ *
+ * The request is left in the socket until the blank line ending the
+ * header is received.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMetricsServer::readRequest()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (socket == NULL)
+    {
+        return;
+    }
+
+    QByteArray request = socket->peek(MAX_REQUEST_SIZE);
+    if (!request.contains("\r\n\r\n") && !request.contains("\n\n"))
+    {
+        if (request.size() >= MAX_REQUEST_SIZE)
+        {
+            respond(socket, "431 Request Header Fields Too Large", "");
+        }
+        return;
+    }
+    socket->readAll();
+
+    QList<QByteArray> fields = request.left(request.indexOf('\n')).trimmed().split(' ');
+    QByteArray path = (fields.size() >= 2) ? fields[1] : QByteArray();
+    if (fields[0] != "GET")
+    {
+        respond(socket, "405 Method Not Allowed", "");
+    }
+    else if ((path == "/metrics") || (path == "/"))
+    {
+        respond(socket, "200 OK", CStationMetrics::Instance()->formatText());
+    }
+    else
+    {
+        respond(socket, "404 Not Found", "");
+    }
+}
+
+
+/*!
+ * @brief Writes the response and closes the connection
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CMetricsServer::respond(QTcpSocket *socket, const char *status, const QByteArray &body)
+{
+    QByteArray header = "HTTP/1.0 ";
+    header.append(status);
+    header.append("\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n");
+    header.append("Content-Length: " + QByteArray::number(body.size()) + "\r\n");
+    header.append("Connection: close\r\n\r\n");
+    socket->write(header);
+    socket->write(body);
+    socket->disconnectFromHost();
+}
@@ -0,0 +1,57 @@
+/*!
+ * @file MetricsServer.h
+ * @brief Declares the CMetricsServer class
+ *
+ * This class serves the station metrics over HTTP
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+/*!
+ * @brief This class answers "GET /metrics" with the metrics of the station
+ *
+ * It is a minimal HTTP/1.0 server running in the main thread; the tests
+ * keep the event loop running (see snooze) so it answers during a run.
+ * Each connection gets one response and is closed.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CMetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CMetricsServer(QObject *parent = 0);
+    ~CMetricsServer();
+
+    bool start(int port);
+    QString errorString() { return(m_server.errorString()); }
+
+private slots:
+    void newConnection();
+    void readRequest();
+
+private:
+    void respond(QTcpSocket *socket, const char *status, const QByteArray &body);
+
+private:
+    QTcpServer  m_server;
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,170 @@
+/*!
+ * @file OperatorQueue.cpp
+ * @brief Implements the COperatorQueue class
+ *
+ * This class is the panel that holds the operator prompts that are not modal
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QLabel>
+#include <QPushButton>
+#include <QHBoxLayout>
+#include <QVariant>
+#include "OperatorQueue.h"
+
+
+/*!
+ * @brief COperatorQueue constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+COperatorQueue::COperatorQueue(QWidget *parent) :
+    QDockWidget("Operator Checks", parent)
+{
+    setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
+    m_panel = new QWidget(this);
+    m_layout = new QVBoxLayout(m_panel);
+    m_layout->addStretch();
+    setWidget(m_panel);
+    hide();
+}
+
+
+/*!
+ * @brief COperatorQueue destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+COperatorQueue::~COperatorQueue()
+{
+    m_entries.clear();
+}
+
+
+/*!
+ * @brief Adds a question to the panel
+ *
+ * @param[in] id - identifies the question when it is answered
+ * @param[in] testName - test that asked the question
+ * @param[in] question - text of the question
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void COperatorQueue::addPrompt(int id, const QString &testName, const QString &question)
+{
+    QFrame *frame = new QFrame(m_panel);
+    frame->setFrameShape(QFrame::StyledPanel);
+    QVBoxLayout *frameLayout = new QVBoxLayout(frame);
+
+    QLabel *name = new QLabel(testName, frame);
+    name->setStyleSheet("color: gray;");
+    frameLayout->addWidget(name);
+
+    QLabel *text = new QLabel("<font size=5>" + question + "</font>", frame);
+    text->setWordWrap(true);
+    frameLayout->addWidget(text);
+
+    QHBoxLayout *buttons = new QHBoxLayout();
+    QPushButton *yes = new QPushButton("Yes", frame);
+    QPushButton *no = new QPushButton("No", frame);
+    yes->setProperty("promptId", id);
+    no->setProperty("promptId", id);
+    connect(yes, SIGNAL(clicked()), this, SLOT(yesPressed()));
+    connect(no, SIGNAL(clicked()), this, SLOT(noPressed()));
+    buttons->addStretch();
+    buttons->addWidget(yes);
+    buttons->addWidget(no);
+    frameLayout->addLayout(buttons);
+
+    m_layout->insertWidget(m_layout->count()-1, frame);   // above the stretch
+    m_entries[id] = frame;
+    show();
+    raise();
+}
+
+
+/*!
+ * @brief Removes all questions without answering them
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void COperatorQueue::clearAll()
+{
+    std::map<int, QFrame *>::iterator it;
+    for (it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        it->second->deleteLater();
+    }
+    m_entries.clear();
+    hide();
+}
+
+
+/*!
+ * @brief Called when a "Yes" button is pressed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void COperatorQueue::yesPressed()
+{
+    answer(true);
+}
+
+
+/*!
+ * @brief Called when a "No" button is pressed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void COperatorQueue::noPressed()
+{
+    answer(false);
+}
+
+
+/*!
+ * @brief Removes the question of the pressed button and reports the answer
+ *
+ * @param[in] yes - true if the operator answered yes
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void COperatorQueue::answer(bool yes)
+{
+    QObject *button = sender();
+    if (button == NULL)
+    {
+        return;
+    }
+
+    int id = button->property("promptId").toInt();
+    std::map<int, QFrame *>::iterator it = m_entries.find(id);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+    it->second->deleteLater();
+    m_entries.erase(it);
+    if (m_entries.empty())
+    {
+        hide();
+    }
+
+    emit answered(id, yes);
+}
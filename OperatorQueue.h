@@ -0,0 +1,66 @@
+/*!
+ * @file OperatorQueue.h
+ * @brief Declares the COperatorQueue class
+ *
+ * This class is the panel that holds the operator prompts that are not modal
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef OPERATORQUEUE_H
+#define OPERATORQUEUE_H
+
+#include <map>
+#include <QDockWidget>
+#include <QVBoxLayout>
+#include <QFrame>
+#include <QString>
+
+/*!
+ * @brief This class shows the "prompt async" questions waiting for the operator
+ *
+ * Each question has its own Yes and No buttons.  The panel is shown when a
+ * question is added and hidden when the last one is answered.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class COperatorQueue : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit COperatorQueue(QWidget *parent = 0);
+    ~COperatorQueue();
+
+    int  getCount() { return(m_entries.size()); }
+
+signals:
+    void answered(int id, bool yes);
+
+public slots:
+    void addPrompt(int id, const QString &testName, const QString &question);
+    void clearAll();
+
+private slots:
+    void yesPressed();
+    void noPressed();
+
+private:
+    void answer(bool yes);
+
+private:
+    QWidget                  *m_panel;
+    QVBoxLayout              *m_layout;
+    std::map<int, QFrame *>   m_entries;    // prompt id -> the frame that shows it
+};
+
+#endif // OPERATORQUEUE_H
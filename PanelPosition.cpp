@@ -0,0 +1,700 @@
+/*!
+ * @file PanelPosition.cpp
+ * @brief Implements the CPanelPosition class
+ *
+ * This class runs the script for one DUT position of a panel
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <string.h>
+#include <algorithm>
+#include <QEventLoop>
+#include <QTimer>
+#include <QTime>
+#include "PanelPosition.h"
+#include "Abort.h"
+#include "StationMetrics.h"
+
+
+/*!
+ * @brief CPanelPosition constructor
+ *
+ * @param[in] position - position on the panel, starting at 1
+ * @param[in] portName - serial port of the DUT at this position
+ * @param[in] arbiter - the arbiter of the shared fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CPanelPosition::CPanelPosition(int position, const QString &portName, CFixtureArbiter *arbiter)
+{
+    m_position = position;
+    m_portName = portName;
+    m_dutPort = NULL;
+    m_arbiter = arbiter;
+    m_fixtureGranted = false;
+    m_cleanup = false;
+    m_indexOnAbort = -1;
+    m_indexOnExit = -1;
+    m_terminateOnError = false;
+    m_timeoutA_ms = 100;
+    m_timeoutB_ms = 100;
+    m_passCount = 0;
+    m_failCount = 0;
+    m_terminatedEarly = false;
+    m_ranOnAbort = false;
+
+    //
+    // The script and this object run in the same thread
+    //
+    connect(&m_script, SIGNAL(logStringBlack(const char *)), this, SLOT(logStringBlack(const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(logStringGray(const char *)), this, SLOT(logStringGray(const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(logStringRed(const char *)), this, SLOT(logStringRed(const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(logCommand(const char *)), this, SLOT(logCommand(const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(logReply(const char *)), this, SLOT(logReply(const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(sendVapoThermCommand(int, const char *)), this, SLOT(sendVapoThermCommand(int, const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(readVapoThermResponse(int, char *, const int , const int )), this, SLOT(readVapoThermResponse(int, char *, const int , const int )), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(readVapoThermBytes(int, char *, const int , const int )), this, SLOT(readVapoThermBytes(int, char *, const int , const int )), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(flushIncomingData(int)), this, SLOT(flushIncomingData(int)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(startVapoThermCommand(int, const char *)), this, SLOT(startVapoThermCommand(int, const char *)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(pollVapoThermOutput(int)), this, SLOT(pollVapoThermOutput(int)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(pollVapoThermResponse(int, char *, const int)), this, SLOT(pollVapoThermResponse(int, char *, const int)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(readTimedOut(int)), this, SLOT(readTimedOut(int)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(postOperatorPrompt(int, const QString &, const QString &)), this, SLOT(postOperatorPrompt(int, const QString &, const QString &)), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(acquireFixture()), this, SLOT(acquireFixture()), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(releaseFixture()), this, SLOT(releaseFixture()), Qt::DirectConnection);
+    connect(&m_script, SIGNAL(fixtureSelection(const QString &)), this, SLOT(fixtureSelection(const QString &)), Qt::DirectConnection);
+}
+
+
+/*!
+ * @brief CPanelPosition destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CPanelPosition::~CPanelPosition()
+{
+    stop();
+    m_reportStrings.clear();
+}
+
+
+/*!
+ * @brief Gives the position its copy of the script and the run settings
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::setup(const CTestScript &script, const std::vector<int> &tests, int indexOnAbort, int indexOnExit,
+                           int outputDelay_ms, int timeoutA_ms, int timeoutB_ms, bool terminateOnError)
+{
+    m_script.copyScript(script);
+    m_script.setPosition(m_position);
+    m_script.setSharedFixture(true);
+    m_script.setElideRedundant(false);
+    m_script.setAdaptiveTimeouts(false, 0, 0);
+    m_script.setTimeouts(timeoutA_ms, timeoutB_ms);
+    m_script.terminateOnError(terminateOnError);
+    m_tests = tests;
+    m_indexOnAbort = indexOnAbort;
+    m_indexOnExit = indexOnExit;
+    m_terminateOnError = terminateOnError;
+    m_timeoutA_ms = timeoutA_ms;
+    m_timeoutB_ms = timeoutB_ms;
+    m_dut.setOutputDelay(outputDelay_ms);
+}
+
+
+/*!
+ * @brief Sets the lines that start the report of this position
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::setHeader(const std::vector<QString> &header, const QString &serialNumber,
+                               const QString &program, const QString &programVersion, const QString &scriptFile)
+{
+    m_header = header;
+    m_serialNumber = serialNumber;
+    m_program = program;
+    m_programVersion = programVersion;
+    m_scriptFile = scriptFile;
+}
+
+
+/*!
+ * @brief Starts the thread of the position and runs the tests in it
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::start()
+{
+    moveToThread(&m_thread);
+    m_script.moveToThread(&m_thread);
+    m_thread.start();
+    QMetaObject::invokeMethod(this, "runTests", Qt::QueuedConnection);
+}
+
+
+/*!
+ * @brief Stops the thread of the position
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::stop()
+{
+    if (m_thread.isRunning())
+    {
+        m_thread.quit();
+        m_thread.wait();
+    }
+}
+
+
+/*!
+ * @brief Sends a line to the main window, tagged with the position
+ *
+ * @param[in] text - the line
+ * @param[in] color - 0 black, 1 gray, 2 red
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::emitLine(const QString &text, int color)
+{
+    QString line = "[P%1] ";
+    emit logLine(m_position, line.arg(m_position) + text, color);
+}
+
+
+/*!
+ * @brief Runs the selected tests (first phase of a run)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::runTests()
+{
+    m_reportStrings.clear();
+    m_failedTests.clear();
+    m_skippedTests.clear();
+    m_passCount = 0;
+    m_failCount = 0;
+    m_terminatedEarly = false;
+    m_ranOnAbort = false;
+    m_cleanup = false;
+    m_script.cancelAsyncPrompts();
+
+    m_dutPort = new QSerialPort();
+    m_dutPort->setPortName(m_portName);
+    if (m_dutPort->open(QSerialPort::ReadWrite))
+    {
+        m_dutPort->setBaudRate(QSerialPort::Baud38400);
+        m_dutPort->setDataBits(QSerialPort::Data8);
+        m_dutPort->setParity(QSerialPort::NoParity);
+        m_dutPort->setStopBits(QSerialPort::OneStop);
+        m_dutPort->setFlowControl(QSerialPort::NoFlowControl);
+        m_dutPort->setDataTerminalReady(true);
+        m_dutPort->clearError();
+        m_dutPort->clear();
+    }
+    else
+    {
+        QString msg = "Could not open the DUT port " + m_portName;
+        emitLine(msg, 2);
+        m_terminatedEarly = true;
+        emit testsDone(m_position);
+        return;
+    }
+    m_dut.setPort(m_dutPort);
+
+    for (unsigned int k=0; k<m_header.size(); k++)
+    {
+        logStringBlack(m_header[k].toLocal8Bit());
+    }
+    m_script.generateProgramRecords(m_program, m_programVersion, m_scriptFile);
+
+    std::vector<bool> testFailed(m_script.getTestCount(), false);
+    for (unsigned int r=0; r<m_tests.size(); r++)
+    {
+        int n = m_tests[r];
+
+        //
+        // Skip tests whose prerequisites failed or were skipped
+        //
+        const std::vector<int> &prereqs = m_script.getPrerequisites(n);
+        int failedPrereq = -1;
+        for (unsigned int k=0; k<prereqs.size(); k++)
+        {
+            if (testFailed[prereqs[k]])
+            {
+                failedPrereq = prereqs[k];
+                break;
+            }
+        }
+        if (failedPrereq >= 0)
+        {
+            QString reason = "required test did not pass (";
+            reason.append(*m_script.getTestName(failedPrereq));
+            reason.append(")");
+            m_script.reportNotRun(n, reason);
+            testFailed[n] = true;
+            m_skippedTests.push_back(n);
+            continue;
+        }
+
+        QTime testTime;
+        testTime.start();
+        m_script.runTest(n);
+        if (!CAbort::Instance()->abortRequested())
+        {
+            CStationMetrics::Instance()->testFinished(*m_script.getTestName(n), testTime.elapsed()/1000.0);
+        }
+        if (m_script.sawError() || m_script.terminatedEarly() || CAbort::Instance()->abortRequested())
+        {
+            testFailed[n] = true;
+            m_failCount++;
+            m_failedTests.push_back(n);
+        }
+        else
+        {
+            m_passCount++;
+        }
+
+        if (CAbort::Instance()->abortRequested())
+        {
+            break;
+        }
+        if (m_script.terminatedEarly())
+        {
+            emitLine("Tests Terminated Abnormally", 2);
+            m_terminatedEarly = true;
+            if (m_indexOnAbort >= 0)
+            {
+                m_cleanup = true;
+                m_script.runTest(m_indexOnAbort);
+                m_cleanup = false;
+                m_ranOnAbort = true;
+            }
+            break;
+        }
+        if (m_script.sawError() && m_terminateOnError)
+        {
+            break;
+        }
+    }
+
+    waitForPrompts();
+
+    //
+    // A test that passed fails if one of its async prompts was answered "no"
+    //
+    const std::vector<int> &asyncFailedTests = m_script.getAsyncFailedTests();
+    for (unsigned int k=0; k<asyncFailedTests.size(); k++)
+    {
+        int n = asyncFailedTests[k];
+        if ((n < 0) || testFailed[n])
+        {
+            continue;
+        }
+        testFailed[n] = true;
+        m_passCount--;
+        m_failCount++;
+        m_failedTests.push_back(n);
+    }
+
+    emit testsDone(m_position);
+}
+
+
+/*!
+ * @brief Waits for the async prompts of this position to be answered
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::waitForPrompts()
+{
+    m_script.flushAsyncPrompts();
+    while ((m_script.getPendingPromptCount() > 0) && !CAbort::Instance()->abortRequested())
+    {
+        QEventLoop loop;
+        QTimer::singleShot(10, &loop, SLOT(quit()));
+        loop.exec();
+        m_script.flushAsyncPrompts();
+    }
+    if (CAbort::Instance()->abortRequested())
+    {
+        m_script.cancelAsyncPrompts();
+    }
+}
+
+
+/*!
+ * @brief Runs OnAbort (when aborted) and OnExit (second phase of a run)
+ *
+ * The main window clears the abort request before this is called so that
+ * the cleanup commands run.
+ *
+ * @param[in] aborted - true if the operator aborted the run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::runCleanup(bool aborted)
+{
+    m_cleanup = true;
+    if (m_dutPort != NULL)
+    {
+        if (aborted && !m_ranOnAbort && (m_indexOnAbort >= 0))
+        {
+            m_script.runTest(m_indexOnAbort);
+        }
+        if (m_indexOnExit >= 0)
+        {
+            m_script.runTest(m_indexOnExit);
+        }
+        m_dutPort->close();
+        delete m_dutPort;
+        m_dutPort = NULL;
+        m_dut.setPort(NULL);
+    }
+    m_cleanup = false;
+    emit finished(m_position);
+}
+
+
+/*!
+ * @brief Passes the answer to an operator prompt on to the script
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::operatorPromptAnswered(int id, bool yes)
+{
+    m_script.operatorPromptAnswered(id, yes);
+}
+
+
+/*!
+ * @brief Writes a line to the report of the position and to the main window
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::logStringBlack(const char *string)
+{
+    m_reportStrings.push_back(string);
+    emitLine(string, 0);
+}
+
+
+/*!
+ * @brief Writes a line to the main window only
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::logStringGray(const char *string)
+{
+    emitLine(string, 1);
+}
+
+
+/*!
+ * @brief Writes an error to the report of the position and to the main window
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::logStringRed(const char *string)
+{
+    m_reportStrings.push_back(string);
+    emitLine(string, 2);
+}
+
+
+/*!
+ * @brief Shows a command sent by the position
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::logCommand(const char *cmd)
+{
+    QString line = ">> ";
+    emitLine(line + cmd, 1);
+}
+
+
+/*!
+ * @brief Shows a reply received by the position
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::logReply(const char *reply)
+{
+    QString line = "<< ";
+    emitLine(line + reply, 1);
+}
+
+
+/*!
+ * @brief Sends a command to the DUT (port A) or to the shared fixture (port B)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CPanelPosition::sendVapoThermCommand(int portIndex, const char *command)
+{
+    if (portIndex == 0)
+    {
+        return(m_dut.send(command));
+    }
+    if (!m_fixtureGranted)
+    {
+        return(false);
+    }
+
+    QString cmd = command;
+    int index = cmd.indexOf("//");
+    if (index >= 0)
+        cmd.truncate(index);
+    index = cmd.indexOf("#");
+    if (index >= 0)
+        cmd.truncate(index);
+
+    bool ok = false;
+    QMetaObject::invokeMethod(m_arbiter, "send", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, ok), Q_ARG(QString, cmd.trimmed()));
+    return(ok);
+}
+
+
+/*!
+ * @brief Reads a line from the DUT or from the shared fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CPanelPosition::readVapoThermResponse(int portIndex, char *buffer, const int bufferSize, const int msTimeout)
+{
+    if (portIndex == 0)
+    {
+        return(m_dut.readLine(buffer, bufferSize, msTimeout));
+    }
+    buffer[0] = '\0';
+    if (!m_fixtureGranted)
+    {
+        return(false);
+    }
+
+    bool ok = false;
+    QMetaObject::invokeMethod(m_arbiter, "readLine", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, ok), Q_ARG(int, msTimeout));
+    const QByteArray &reply = m_arbiter->getReply();
+    int n = std::min(reply.size(), bufferSize-1);
+    memcpy(buffer, reply.constData(), n);
+    buffer[n] = '\0';
+    return(ok);
+}
+
+
+/*!
+ * @brief Reads raw bytes from the DUT or from the shared fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CPanelPosition::readVapoThermBytes(int portIndex, char *buffer, const int count, const int msTimeout)
+{
+    if (portIndex == 0)
+    {
+        return(m_dut.readBytes(buffer, count, msTimeout));
+    }
+    if (!m_fixtureGranted)
+    {
+        return(0);
+    }
+
+    int n = 0;
+    QMetaObject::invokeMethod(m_arbiter, "readBytes", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(int, n), Q_ARG(int, count), Q_ARG(int, msTimeout));
+    memcpy(buffer, m_arbiter->getReply().constData(), n);
+    return(n);
+}
+
+
+/*!
+ * @brief Discards what the DUT or the fixture has sent
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::flushIncomingData(int portIndex)
+{
+    if (portIndex == 0)
+    {
+        m_dut.flush();
+    }
+    else if (m_fixtureGranted)
+    {
+        QMetaObject::invokeMethod(m_arbiter, "flush", Qt::BlockingQueuedConnection);
+    }
+}
+
+
+/*!
+ * @brief Starts sending a command without waiting (parallel blocks)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CPanelPosition::startVapoThermCommand(int portIndex, const char *command)
+{
+    if (portIndex == 0)
+    {
+        return(m_dut.startCommand(command));
+    }
+    if (!m_fixtureGranted)
+    {
+        return(false);
+    }
+
+    bool ok = false;
+    QMetaObject::invokeMethod(m_arbiter, "startCommand", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, ok), Q_ARG(QString, QString(command)));
+    return(ok);
+}
+
+
+/*!
+ * @brief Writes the next character of a command started by startVapoThermCommand
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CPanelPosition::pollVapoThermOutput(int portIndex)
+{
+    if (portIndex == 0)
+    {
+        return(m_dut.pollOutput());
+    }
+    if (!m_fixtureGranted)
+    {
+        return(-1);
+    }
+
+    int status = -1;
+    QMetaObject::invokeMethod(m_arbiter, "pollOutput", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(int, status));
+    return(status);
+}
+
+
+/*!
+ * @brief Returns a line from the DUT or the fixture if a whole line has arrived
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CPanelPosition::pollVapoThermResponse(int portIndex, char *buffer, const int bufferSize)
+{
+    if (portIndex == 0)
+    {
+        return(m_dut.pollLine(buffer, bufferSize));
+    }
+    buffer[0] = '\0';
+    if (!m_fixtureGranted)
+    {
+        return(false);
+    }
+
+    bool ok = false;
+    QMetaObject::invokeMethod(m_arbiter, "pollLine", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, ok));
+    const QByteArray &reply = m_arbiter->getReply();
+    int n = std::min(reply.size(), bufferSize-1);
+    memcpy(buffer, reply.constData(), n);
+    buffer[n] = '\0';
+    return(ok);
+}
+
+
+/*!
+ * @brief Counts a read of a parallel block branch that timed out
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::readTimedOut(int portIndex)
+{
+    QSerialPort *port = (portIndex == 0) ? m_dut.getPort() : m_arbiter->getPort();
+    if (port != NULL)
+    {
+        CStationMetrics::Instance()->readTimeout(port->portName());
+    }
+}
+
+
+/*!
+ * @brief Posts an operator prompt to the queue of the main window
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::postOperatorPrompt(int id, const QString &testName, const QString &question)
+{
+    QString name = "[P%1] ";
+    emit operatorPrompt(id, name.arg(m_position) + testName, question);
+}
+
+
+/*!
+ * @brief Waits for the shared fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::acquireFixture()
+{
+    m_fixtureGranted = m_arbiter->acquire(m_position, m_cleanup);
+}
+
+
+/*!
+ * @brief Gives up the shared fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::releaseFixture()
+{
+    m_arbiter->release(m_position);
+    m_fixtureGranted = false;
+}
+
+
+/*!
+ * @brief Marks the next fixture command as a selection of this position
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CPanelPosition::fixtureSelection(const QString &tag)
+{
+    m_arbiter->setNextTag(tag);
+}
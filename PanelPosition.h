@@ -0,0 +1,135 @@
+/*!
+ * @file PanelPosition.h
+ * @brief Declares the CPanelPosition class
+ *
+ * This class runs the script for one DUT position of a panel
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef PANELPOSITION_H
+#define PANELPOSITION_H
+
+#include <vector>
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include "TestScript.h"
+#include "SerialChannel.h"
+#include "FixtureArbiter.h"
+
+/*!
+ * @brief This class runs a copy of the script for one position of a panel
+ *
+ * Each position runs in its own thread with its own DUT port (port A of
+ * the script).  Port B of the script is the fixture, which is shared with
+ * the other positions through the fixture arbiter.  The position keeps its
+ * own report; the lines shown in the main window are tagged with "[Pn]".
+ *
+ * A run has two phases so that the main window can coordinate an abort:
+ * runTests() runs the selected tests, then runCleanup() runs OnAbort
+ * (when aborted) and OnExit once every position has stopped.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CPanelPosition : public QObject
+{
+    Q_OBJECT
+
+public:
+    CPanelPosition(int position, const QString &portName, CFixtureArbiter *arbiter);
+    ~CPanelPosition();
+
+    void setup(const CTestScript &script, const std::vector<int> &tests, int indexOnAbort, int indexOnExit,
+               int outputDelay_ms, int timeoutA_ms, int timeoutB_ms, bool terminateOnError);
+    void setHeader(const std::vector<QString> &header, const QString &serialNumber,
+                   const QString &program, const QString &programVersion, const QString &scriptFile);
+    void start();
+    void stop();
+
+    int  getPosition() { return(m_position); }
+    const QString &getSerialNumber() { return(m_serialNumber); }
+    const std::vector<QString> &getReportStrings() { return(m_reportStrings); }
+    int  getPassCount() { return(m_passCount); }
+    int  getFailCount() { return(m_failCount); }
+    const std::vector<int> &getFailedTests() { return(m_failedTests); }
+    const std::vector<int> &getSkippedTests() { return(m_skippedTests); }
+    bool terminatedEarly() { return(m_terminatedEarly); }
+    QString getTestName(int n) { return(*m_script.getTestName(n)); }
+    CTestScript *getScript() { return(&m_script); }
+
+public slots:
+    void runTests();
+    void runCleanup(bool aborted);
+    void operatorPromptAnswered(int id, bool yes);
+
+    void logStringBlack(const char *string);
+    void logStringGray(const char *string);
+    void logStringRed(const char *string);
+    void logCommand(const char *cmd);
+    void logReply(const char *reply);
+    bool sendVapoThermCommand(int portIndex, const char *command);
+    bool readVapoThermResponse(int portIndex, char *buffer, const int bufferSize, const int msTimeout);
+    int  readVapoThermBytes(int portIndex, char *buffer, const int count, const int msTimeout);
+    void flushIncomingData(int portIndex);
+    bool startVapoThermCommand(int portIndex, const char *command);
+    int  pollVapoThermOutput(int portIndex);
+    bool pollVapoThermResponse(int portIndex, char *buffer, const int bufferSize);
+    void readTimedOut(int portIndex);
+    void postOperatorPrompt(int id, const QString &testName, const QString &question);
+    void acquireFixture();
+    void releaseFixture();
+    void fixtureSelection(const QString &tag);
+
+signals:
+    void logLine(int position, const QString &text, int color);
+    void operatorPrompt(int id, const QString &testName, const QString &question);
+    void testsDone(int position);
+    void finished(int position);
+
+private:
+    void emitLine(const QString &text, int color);
+    void waitForPrompts();
+
+private:
+    int                   m_position;        // starting at 1
+    QString               m_portName;
+    QSerialPort          *m_dutPort;         // created in the thread of the position
+    CSerialChannel        m_dut;
+    CFixtureArbiter      *m_arbiter;
+    bool                  m_fixtureGranted;
+    bool                  m_cleanup;         // running OnAbort/OnExit
+    QThread               m_thread;
+    CTestScript           m_script;
+
+    std::vector<int>      m_tests;           // numbers of the tests to run, in order
+    int                   m_indexOnAbort;
+    int                   m_indexOnExit;
+    bool                  m_terminateOnError;
+    int                   m_timeoutA_ms;
+    int                   m_timeoutB_ms;
+    std::vector<QString>  m_header;          // report lines before the records
+    QString               m_serialNumber;
+    QString               m_program;
+    QString               m_programVersion;
+    QString               m_scriptFile;
+
+    std::vector<QString>  m_reportStrings;
+    int                   m_passCount;
+    int                   m_failCount;
+    std::vector<int>      m_failedTests;
+    std::vector<int>      m_skippedTests;
+    bool                  m_terminatedEarly;
+    bool                  m_ranOnAbort;
+};
+
+#endif // PANELPOSITION_H
@@ -0,0 +1,271 @@
+/*!
+ * @file RemoteControl.cpp
+ * @brief Implements the CRemoteControl class
+ *
+ * This class accepts JSON requests from a manufacturing execution system
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include "RemoteControl.h"
+
+#define MAX_REQUEST_SIZE  (64*1024)
+
+
+/*!
+ * @brief CRemoteControl constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CRemoteControl::CRemoteControl(QObject *parent) :
+    QObject(parent)
+{
+    m_nextClient = 1;
+    connect(&m_server, SIGNAL(newConnection()), this, SLOT(newConnection()));
+}
+
+
+/*!
+ * @brief CRemoteControl destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CRemoteControl::~CRemoteControl()
+{
+    m_server.close();
+    m_clients.clear();
+}
+
+
+/*!
+ * @brief Starts listening for clients
+ *
+ * @param[in] address - address to listen on, normally the local host
+ * @param[in] port - the TCP port
+ * @return false if the port could not be opened
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CRemoteControl::start(const QHostAddress &address, int port)
+{
+    return(m_server.listen(address, port));
+}
+
+
+/*!
+ * @brief Accepts the pending connections
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::newConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        QTcpSocket *socket = m_server.nextPendingConnection();
+        client_t client;
+        client.m_socket = socket;
+        client.m_subscribed = false;
+        int id = m_nextClient++;
+        m_clients[id] = client;
+        socket->setProperty("client", id);
+        connect(socket, SIGNAL(readyRead()), this, SLOT(readRequests()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(clientDisconnected()));
+    }
+}
+
+
+/*!
+ * @brief Forgets a client that closed its connection
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::clientDisconnected()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (socket == NULL)
+    {
+        return;
+    }
+    m_clients.erase(socket->property("client").toInt());
+    socket->deleteLater();
+}
+
+
+/*!
+ * @brief Hands each complete line received from a client to the main window
+ *
+ * A request can start a run, which keeps processing events until the run
+ * ends, so the client is looked up again after each request.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::readRequests()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (socket == NULL)
+    {
+        return;
+    }
+    int id = socket->property("client").toInt();
+
+    while ((m_clients.find(id) != m_clients.end()) && socket->canReadLine())
+    {
+        QByteArray line = socket->readLine(MAX_REQUEST_SIZE).trimmed();
+        if (line.isEmpty())
+        {
+            continue;
+        }
+        QJsonParseError error;
+        QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (!document.isObject())
+        {
+            QJsonObject response;
+            response["ok"] = false;
+            response["error"] = (error.error != QJsonParseError::NoError) ? error.errorString() : QString("request is not an object");
+            send(socket, response);
+            continue;
+        }
+        emit request(id, document.object());
+    }
+
+    if ((m_clients.find(id) != m_clients.end()) && (socket->bytesAvailable() > MAX_REQUEST_SIZE))
+    {
+        QJsonObject response;
+        response["ok"] = false;
+        response["error"] = QString("request too long");
+        send(socket, response);
+        socket->disconnectFromHost();
+    }
+}
+
+
+/*!
+ * @brief Writes a JSON object to a client as one line
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::send(QTcpSocket *socket, const QJsonObject &object)
+{
+    QByteArray line = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    line.append('\n');
+    socket->write(line);
+}
+
+
+/*!
+ * @brief Answers a request
+ *
+ * @param[in] client - the client that sent the request
+ * @param[in] request - the request, its "cmd" and "id" are copied to the reply
+ * @param[in] response - the reply, "ok" is set to true if it is not present
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::reply(int client, const QJsonObject &request, QJsonObject response)
+{
+    std::map<int, client_t>::iterator it = m_clients.find(client);
+    if (it == m_clients.end())
+    {
+        return;
+    }
+    if (!response.contains("ok"))
+    {
+        response["ok"] = true;
+    }
+    response["cmd"] = request.value("cmd");
+    if (request.contains("id"))
+    {
+        response["id"] = request.value("id");
+    }
+    send(it->second.m_socket, response);
+}
+
+
+/*!
+ * @brief Answers a request that could not be carried out
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::replyError(int client, const QJsonObject &request, const QString &message)
+{
+    QJsonObject response;
+    response["ok"] = false;
+    response["error"] = message;
+    reply(client, request, response);
+}
+
+
+/*!
+ * @brief Starts or stops sending the events to a client
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::subscribe(int client, bool subscribed)
+{
+    std::map<int, client_t>::iterator it = m_clients.find(client);
+    if (it != m_clients.end())
+    {
+        it->second.m_subscribed = subscribed;
+    }
+}
+
+
+/*!
+ * @brief Returns true if a client wants the events
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CRemoteControl::hasSubscribers()
+{
+    std::map<int, client_t>::iterator it;
+    for (it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        if (it->second.m_subscribed)
+        {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+
+/*!
+ * @brief Sends an event to every subscribed client
+ *
+ * @param[in] event - the event, its "event" member names it
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRemoteControl::publish(const QJsonObject &event)
+{
+    std::map<int, client_t>::iterator it;
+    for (it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        if (it->second.m_subscribed)
+        {
+            send(it->second.m_socket, event);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*!
+ * @file RemoteControl.h
+ * @brief Declares the CRemoteControl class
+ *
+ * This class accepts JSON requests from a manufacturing execution system
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef REMOTECONTROL_H
+#define REMOTECONTROL_H
+
+#include <map>
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QJsonObject>
+
+/*!
+ * @brief This class carries the requests and replies of the remote control API
+ *
+ * Clients connect over TCP and send one JSON object per line, e.g.
+ *   {"cmd":"set", "operator":"JGP", "serial":"1234567890"}
+ *   {"cmd":"start", "confirm":false}
+ * The "cmd" of each request is handed to the main window with the
+ * request() signal; the main window answers with reply().  An "id" in a
+ * request is copied to its reply.  Clients that sent "subscribe" also get
+ * the events published while tests run, one JSON object per line.
+ *
+ * This class only moves JSON; what the commands do is up to the main
+ * window so that they share the code of the buttons and menus.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CRemoteControl : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CRemoteControl(QObject *parent = 0);
+    ~CRemoteControl();
+
+    bool start(const QHostAddress &address, int port);
+    QString errorString() { return(m_server.errorString()); }
+    void reply(int client, const QJsonObject &request, QJsonObject response);
+    void replyError(int client, const QJsonObject &request, const QString &message);
+    void subscribe(int client, bool subscribed);
+    void publish(const QJsonObject &event);
+    bool hasSubscribers();
+
+signals:
+    void request(int client, const QJsonObject &request);
+
+private slots:
+    void newConnection();
+    void readRequests();
+    void clientDisconnected();
+
+private:
+    void send(QTcpSocket *socket, const QJsonObject &object);
+
+private:
+    struct client_t
+    {
+        QTcpSocket  *m_socket;
+        bool         m_subscribed;
+    };
+
+    QTcpServer                 m_server;
+    std::map<int, client_t>    m_clients;     // client id -> connection
+    int                        m_nextClient;
+};
+
+#endif // REMOTECONTROL_H
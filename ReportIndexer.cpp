@@ -0,0 +1,607 @@
+/*!
+ * @file ReportIndexer.cpp
+ * @brief Implements the CReportIndexer class
+ *
+ * This class indexes the records of an archive of report files
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+#include <QVariant>
+#include "ReportIndexer.h"
+
+#define FILES_PER_TASK 64
+
+
+/*!
+ * @brief Scans a batch of report files in a thread of the pool
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CReportScanTask : public QRunnable
+{
+public:
+    CReportScanTask(CReportIndexer *indexer, const QStringList &paths)
+    {
+        m_indexer = indexer;
+        m_paths = paths;
+    }
+
+    void run()
+    {
+        std::vector<CReportIndexer::file_t> files;
+        for (int i=0; i<m_paths.size(); i++)
+        {
+            if (m_indexer->isCancelled())
+            {
+                break;
+            }
+            CReportIndexer::file_t file;
+            if (CReportIndexer::scanFile(m_paths[i], file))
+            {
+                files.push_back(file);
+            }
+        }
+        m_indexer->scanned(files);
+    }
+
+private:
+    CReportIndexer  *m_indexer;
+    QStringList      m_paths;
+};
+
+
+/*!
+ * @brief Returns true if the line starts with the key
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+static inline bool lineStartsWith(const char *line, int length, const char *key, int keyLength)
+{
+    return((length >= keyLength) && (memcmp(line, key, keyLength) == 0));
+}
+
+
+/*!
+ * @brief Parses "MM/DD/YYYY" without copying it
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+static QDate parseDate(const char *text, int length)
+{
+    if (length < 10)
+    {
+        return(QDate());
+    }
+    int month = (text[0]-'0')*10 + (text[1]-'0');
+    int day = (text[3]-'0')*10 + (text[4]-'0');
+    int year = (text[6]-'0')*1000 + (text[7]-'0')*100 + (text[8]-'0')*10 + (text[9]-'0');
+    return(QDate(year, month, day));
+}
+
+
+/*!
+ * @brief CReportIndexer constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CReportIndexer::CReportIndexer()
+{
+    m_connectionName = "reportIndex";
+    m_open = false;
+    m_tasksRunning = 0;
+    m_filesQueued = 0;
+    m_filesDone = 0;
+    m_recordsDone = 0;
+    m_error.clear();
+    m_pool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+
+/*!
+ * @brief CReportIndexer destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CReportIndexer::~CReportIndexer()
+{
+    close();
+}
+
+
+/*!
+ * @brief Opens the database and creates the index tables
+ *
+ * @param[in] databaseFile - the measurement database
+ * @return true if successful
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CReportIndexer::open(const QString &databaseFile)
+{
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    db.setDatabaseName(databaseFile);
+    if (!db.open())
+    {
+        return(false);
+    }
+
+    QSqlQuery query(db);
+    query.exec("PRAGMA journal_mode=WAL");
+    query.exec("PRAGMA synchronous=NORMAL");
+    query.exec("PRAGMA busy_timeout=5000");
+    bool ok = query.exec("CREATE TABLE IF NOT EXISTS report_files ("
+                         "id INTEGER PRIMARY KEY, "
+                         "path TEXT UNIQUE, "
+                         "modified TEXT, "
+                         "size INTEGER, "
+                         "serial_number TEXT, "
+                         "script_version TEXT)");
+    ok = ok && query.exec("CREATE TABLE IF NOT EXISTS report_records ("
+                          "file_id INTEGER, "
+                          "offset INTEGER, "
+                          "serial_number TEXT, "
+                          "test_name TEXT, "
+                          "date TEXT, "
+                          "time TEXT, "
+                          "value REAL, "
+                          "result TEXT)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS report_records_file ON report_records (file_id)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS report_records_serial ON report_records (serial_number)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS report_records_test ON report_records (test_name, date)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS report_records_date ON report_records (date)");
+    ok = ok && query.exec("CREATE INDEX IF NOT EXISTS report_records_result ON report_records (result, test_name)");
+    m_open = ok;
+    return(ok);
+}
+
+
+/*!
+ * @brief Stops the scan and closes the database
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportIndexer::close()
+{
+    cancel();
+    m_pool.waitForDone();
+    m_scanned.clear();
+    if (QSqlDatabase::contains(m_connectionName))
+    {
+        QSqlDatabase::database(m_connectionName).close();
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+    m_open = false;
+}
+
+
+/*!
+ * @brief Lists the report files and starts scanning the new and changed ones
+ *
+ * @param[in] dirs - directories of reports, searched recursively
+ * @return the number of files that will be scanned, -1 if the database is not open
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CReportIndexer::start(const QStringList &dirs)
+{
+    if (!m_open)
+    {
+        return(-1);
+    }
+    m_cancel.storeRelease(0);
+    m_tasksRunning = 0;
+    m_filesQueued = 0;
+    m_filesDone = 0;
+    m_recordsDone = 0;
+    m_error.clear();
+
+    //
+    // Files already in the index
+    //
+    m_indexed.clear();
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    query.exec("SELECT id, path, modified, size FROM report_files");
+    while (query.next())
+    {
+        indexed_t indexed;
+        indexed.m_id = query.value(0).toInt();
+        indexed.m_modified = QDateTime::fromString(query.value(2).toString(), Qt::ISODate);
+        indexed.m_size = query.value(3).toLongLong();
+        m_indexed[query.value(1).toString()] = indexed;
+    }
+
+    QStringList batch;
+    for (int d=0; d<dirs.size(); d++)
+    {
+        QDirIterator it(dirs[d], QStringList() << "*.txt", QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            QString path = it.next();
+            QFileInfo info = it.fileInfo();
+            std::map<QString, indexed_t>::iterator found = m_indexed.find(path);
+            if ( (found != m_indexed.end())
+               && (found->second.m_size == info.size())
+               && (found->second.m_modified == QDateTime::fromString(info.lastModified().toString(Qt::ISODate), Qt::ISODate)) )
+            {
+                continue;
+            }
+            batch.append(path);
+            m_filesQueued++;
+            if (batch.size() >= FILES_PER_TASK)
+            {
+                startTask(batch);
+                batch.clear();
+            }
+        }
+    }
+    if (!batch.isEmpty())
+    {
+        startTask(batch);
+    }
+    return(m_filesQueued);
+}
+
+
+/*!
+ * @brief Queues a batch of files to be scanned by the pool
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportIndexer::startTask(const QStringList &paths)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        m_tasksRunning++;
+    }
+    m_pool.start(new CReportScanTask(this, paths));
+}
+
+
+/*!
+ * @brief Takes the files scanned by a task (called from the pool)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportIndexer::scanned(std::vector<file_t> &files)
+{
+    QMutexLocker lock(&m_mutex);
+    m_scanned.insert(m_scanned.end(), files.begin(), files.end());
+    m_tasksRunning--;
+}
+
+
+/*!
+ * @brief Inserts the files scanned so far
+ *
+ * Call this repeatedly (it does not wait) until it returns false.
+ *
+ * A batch that cannot be written stops the scan; getError() describes why.
+ *
+ * @param[out] filesDone - files indexed so far
+ * @param[out] recordsDone - records indexed so far
+ * @return false when every file has been indexed, the scan was cancelled
+ *         or a batch could not be written
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CReportIndexer::step(int &filesDone, int &recordsDone)
+{
+    std::vector<file_t> files;
+    {
+        QMutexLocker lock(&m_mutex);
+        files.swap(m_scanned);
+    }
+    if (!files.empty() && !isCancelled() && !writeFiles(files))
+    {
+        cancel();
+    }
+
+    filesDone = m_filesDone;
+    recordsDone = m_recordsDone;
+    if (isCancelled())
+    {
+        m_pool.waitForDone();
+        return(false);
+    }
+    QMutexLocker lock(&m_mutex);
+    return((m_tasksRunning > 0) || !m_scanned.empty());
+}
+
+
+/*!
+ * @brief Stops the scan; files not yet scanned are left for the next run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportIndexer::cancel()
+{
+    m_cancel.storeRelease(1);
+}
+
+
+/*!
+ * @brief Writes scanned files to the index in one transaction
+ *
+ * The files are counted as done only when the transaction is committed.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CReportIndexer::writeFiles(std::vector<file_t> &files)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    db.transaction();
+    QSqlQuery removeRecords(db);
+    removeRecords.prepare("DELETE FROM report_records WHERE file_id = ?");
+    QSqlQuery insertFile(db);
+    insertFile.prepare("INSERT OR REPLACE INTO report_files (id, path, modified, size, serial_number, script_version) "
+                       "VALUES (?, ?, ?, ?, ?, ?)");
+    QSqlQuery insertRecord(db);
+    insertRecord.prepare("INSERT INTO report_records (file_id, offset, serial_number, test_name, date, time, value, result) "
+                         "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+
+    bool ok = true;
+    int recordCount = 0;
+    for (unsigned int f=0; (f<files.size()) && ok; f++)
+    {
+        const file_t &file = files[f];
+
+        //
+        // A changed file keeps its id, its old records are replaced
+        //
+        QVariant id(QVariant::Int);
+        std::map<QString, indexed_t>::iterator found = m_indexed.find(file.m_path);
+        if (found != m_indexed.end())
+        {
+            id = found->second.m_id;
+            removeRecords.addBindValue(id);
+            ok = removeRecords.exec();
+            if (!ok)
+            {
+                m_error = removeRecords.lastError().text();
+                break;
+            }
+        }
+        insertFile.addBindValue(id);
+        insertFile.addBindValue(file.m_path);
+        insertFile.addBindValue(file.m_modified.toString(Qt::ISODate));
+        insertFile.addBindValue(file.m_size);
+        insertFile.addBindValue(file.m_serialNumber);
+        insertFile.addBindValue(file.m_scriptVersion);
+        ok = insertFile.exec();
+        if (!ok)
+        {
+            m_error = insertFile.lastError().text();
+            break;
+        }
+        int fileId = insertFile.lastInsertId().toInt();
+
+        for (unsigned int r=0; (r<file.m_records.size()) && ok; r++)
+        {
+            const record_t &record = file.m_records[r];
+            insertRecord.addBindValue(fileId);
+            insertRecord.addBindValue(record.m_offset);
+            insertRecord.addBindValue(file.m_serialNumber);
+            insertRecord.addBindValue(record.m_testName);
+            insertRecord.addBindValue(record.m_date.toString(Qt::ISODate));
+            insertRecord.addBindValue(record.m_time);
+            insertRecord.addBindValue(record.m_valueValid ? QVariant(record.m_value) : QVariant(QVariant::Double));
+            insertRecord.addBindValue(record.m_result);
+            ok = insertRecord.exec();
+            if (!ok)
+            {
+                m_error = insertRecord.lastError().text();
+            }
+        }
+        recordCount += file.m_records.size();
+    }
+
+    if (ok && !db.commit())
+    {
+        m_error = db.lastError().text();
+        ok = false;
+    }
+    if (!ok)
+    {
+        db.rollback();
+        m_error = QString("Could not write %1 report(s) to the index: %2").arg(files.size()).arg(m_error);
+        return(false);
+    }
+    m_filesDone += files.size();
+    m_recordsDone += recordCount;
+    return(true);
+}
+
+
+/*!
+ * @brief Reads the records of one report file
+ *
+ * The file is memory mapped and scanned line by line in place; only the
+ * fields that go into the index are copied.
+ *
+ * @param[in] path - the report file
+ * @param[out] file - the records of the file
+ * @return false if the file could not be read
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CReportIndexer::scanFile(const QString &path, file_t &file)
+{
+    QFile qf(path);
+    if (!qf.open(QIODevice::ReadOnly))
+    {
+        return(false);
+    }
+    QFileInfo info(qf);
+    file.m_path = path;
+    file.m_modified = QDateTime::fromString(info.lastModified().toString(Qt::ISODate), Qt::ISODate);
+    file.m_size = qf.size();
+    file.m_records.clear();
+    if (file.m_size == 0)
+    {
+        return(true);
+    }
+
+    const char *data = (const char *)qf.map(0, file.m_size);
+    if (data == NULL)
+    {
+        return(false);
+    }
+    const char *end = data + file.m_size;
+
+    record_t record;
+    bool inRecord = false;
+    bool scriptVersionRecord = false;
+    const char *p = data;
+    while (p < end)
+    {
+        const char *eol = (const char *)memchr(p, '\n', end - p);
+        if (eol == NULL)
+        {
+            eol = end;
+        }
+        int length = eol - p;
+        if ((length > 0) && (p[length-1] == '\r'))
+        {
+            length--;
+        }
+
+        if (lineStartsWith(p, length, "TestName: ", 10))
+        {
+            record.m_offset = p - data;
+            record.m_testName = QString::fromLatin1(p+10, length-10).trimmed();
+            record.m_date = QDate();
+            record.m_time.clear();
+            record.m_valueValid = false;
+            record.m_value = 0.0;
+            record.m_result.clear();
+            scriptVersionRecord = (record.m_testName == "Test Script Version");
+            inRecord = true;
+        }
+        else if (!inRecord)
+        {
+            if (lineStartsWith(p, length, "ImageBarcode: ", 14))
+            {
+                file.m_serialNumber = QString::fromLatin1(p+14, length-14).trimmed();
+            }
+        }
+        else if (lineStartsWith(p, length, "Date: ", 6))
+        {
+            record.m_date = parseDate(p+6, length-6);
+        }
+        else if (lineStartsWith(p, length, "Time: ", 6))
+        {
+            record.m_time = QString::fromLatin1(p+6, length-6).trimmed();
+        }
+        else if (lineStartsWith(p, length, "Value: ", 7))
+        {
+            char number[64];
+            int n = std::min(length-7, (int)sizeof(number)-1);
+            memcpy(number, p+7, n);
+            number[n] = '\0';
+            char *stop = NULL;
+            record.m_value = strtod(number, &stop);
+            record.m_valueValid = (stop != number);
+            if (scriptVersionRecord)
+            {
+                file.m_scriptVersion = QString::fromLatin1(p+7, length-7).trimmed();
+            }
+        }
+        else if (lineStartsWith(p, length, "Result: ", 8))
+        {
+            record.m_result = QString::fromLatin1(p+8, length-8).trimmed();
+        }
+        else if (lineStartsWith(p, length, "~#~", 3))
+        {
+            file.m_records.push_back(record);
+            inRecord = false;
+        }
+
+        p = eol + 1;
+    }
+
+    qf.unmap((uchar *)data);
+    return(true);
+}
+
+
+/*!
+ * @brief Returns the records of a test between two dates
+ *
+ * @param[in] testName - the test
+ * @param[in] from - first date
+ * @param[in] to - last date
+ * @param[out] results - the records, oldest first
+ * @return false if the query failed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CReportIndexer::query(const QString &testName, const QDate &from, const QDate &to, std::vector<result_t> &results)
+{
+    results.clear();
+    if (!m_open)
+    {
+        return(false);
+    }
+
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    query.prepare("SELECT r.serial_number, r.date, r.time, r.value, r.result, f.path "
+                  "FROM report_records r JOIN report_files f ON r.file_id = f.id "
+                  "WHERE r.test_name = ? AND r.date BETWEEN ? AND ? "
+                  "ORDER BY r.date, r.time");
+    query.addBindValue(testName);
+    query.addBindValue(from.toString(Qt::ISODate));
+    query.addBindValue(to.toString(Qt::ISODate));
+    if (!query.exec())
+    {
+        return(false);
+    }
+    while (query.next())
+    {
+        result_t result;
+        result.m_serialNumber = query.value(0).toString();
+        result.m_date = QDate::fromString(query.value(1).toString(), Qt::ISODate);
+        result.m_time = query.value(2).toString();
+        result.m_valueValid = !query.value(3).isNull();
+        result.m_value = query.value(3).toDouble();
+        result.m_result = query.value(4).toString();
+        result.m_path = query.value(5).toString();
+        results.push_back(result);
+    }
+    return(true);
+}
@@ -0,0 +1,134 @@
+/*!
+ * @file ReportIndexer.h
+ * @brief Declares the CReportIndexer class
+ *
+ * This class indexes the records of an archive of report files
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef REPORTINDEXER_H
+#define REPORTINDEXER_H
+
+#include <map>
+#include <vector>
+#include <QAtomicInt>
+#include <QDate>
+#include <QDateTime>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+/*!
+ * @brief This class builds an index of the records of the report files
+ *
+ * The index is kept in two tables of the measurement database:
+ * report_files (one row per report) and report_records (one row per
+ * record, keyed by serial number, test name, date and result).  Only the
+ * files that are new or changed since the last run are read again.
+ *
+ * The files are memory mapped and scanned in place by a pool of threads,
+ * one thread per core; only the fields that go into the index are copied
+ * out of the mapped file.  The rows are inserted by the thread that calls
+ * step(), in one transaction per call.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CReportIndexer
+{
+public:
+    /*!
+     * @brief One record of a report
+     */
+    struct record_t
+    {
+        qint64   m_offset;        // of the "TestName:" line in the file
+        QString  m_testName;
+        QDate    m_date;
+        QString  m_time;
+        bool     m_valueValid;
+        double   m_value;
+        QString  m_result;
+    };
+
+    /*!
+     * @brief The records of one report file
+     */
+    struct file_t
+    {
+        QString                m_path;
+        QDateTime              m_modified;
+        qint64                 m_size;
+        QString                m_serialNumber;
+        QString                m_scriptVersion;
+        std::vector<record_t>  m_records;
+    };
+
+    /*!
+     * @brief A record found by query()
+     */
+    struct result_t
+    {
+        QString  m_serialNumber;
+        QDate    m_date;
+        QString  m_time;
+        bool     m_valueValid;
+        double   m_value;
+        QString  m_result;
+        QString  m_path;
+    };
+
+    CReportIndexer();
+    ~CReportIndexer();
+
+    bool open(const QString &databaseFile);
+    void close();
+    int  start(const QStringList &dirs);
+    bool step(int &filesDone, int &recordsDone);
+    void cancel();
+    QString getError() { return(m_error); }
+    bool query(const QString &testName, const QDate &from, const QDate &to, std::vector<result_t> &results);
+
+    static bool scanFile(const QString &path, file_t &file);
+
+    // called by the scan tasks
+    bool isCancelled() { return(m_cancel.loadAcquire() != 0); }
+    void scanned(std::vector<file_t> &files);
+
+private:
+    void startTask(const QStringList &paths);
+    bool writeFiles(std::vector<file_t> &files);
+
+private:
+    struct indexed_t
+    {
+        int        m_id;
+        QDateTime  m_modified;
+        qint64     m_size;
+    };
+
+    QString                          m_connectionName;
+    bool                             m_open;
+    QThreadPool                      m_pool;
+    QAtomicInt                       m_cancel;
+    QMutex                           m_mutex;
+    std::vector<file_t>              m_scanned;      // scanned, waiting to be inserted
+    int                              m_tasksRunning; // scan tasks queued or running
+    std::map<QString, indexed_t>     m_indexed;      // path -> file already in the index
+    int                              m_filesQueued;
+    int                              m_filesDone;
+    int                              m_recordsDone;
+    QString                          m_error;        // why the last batch was not written
+};
+
+#endif // REPORTINDEXER_H
@@ -0,0 +1,196 @@
+/*!
+ * @file ReportSpooler.cpp
+ * @brief Implements the CReportSpooler class
+ *
+ * This class writes the report files in the background
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include <QFile>
+#include <QFileInfo>
+#include "ReportSpooler.h"
+
+
+/*!
+ * @brief CReportSpooler constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CReportSpooler::CReportSpooler()
+{
+    m_pending.clear();
+}
+
+
+/*!
+ * @brief CReportSpooler destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CReportSpooler::~CReportSpooler()
+{
+    stop();
+}
+
+
+/*!
+ * @brief Sets the report directory and the local directory used when it cannot be written
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportSpooler::setDirectories(const QString &reportDir, const QString &localDir)
+{
+    m_reportDir = reportDir;
+    if (!m_reportDir.isEmpty() && !m_reportDir.endsWith("/"))
+    {
+        m_reportDir.append("/");
+    }
+    m_localDir = localDir;
+    if (!m_localDir.isEmpty() && !m_localDir.endsWith("/"))
+    {
+        m_localDir.append("/");
+    }
+}
+
+
+/*!
+ * @brief Starts the background thread
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportSpooler::start()
+{
+    if (m_thread.isRunning())
+    {
+        return;
+    }
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+
+/*!
+ * @brief Writes the reports still queued and stops the thread
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportSpooler::stop()
+{
+    if (!m_thread.isRunning())
+    {
+        return;
+    }
+    QMetaObject::invokeMethod(this, "drain", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+
+/*!
+ * @brief Queues a report to be written
+ *
+ * @param[in] filename - name of the report file, without a directory
+ * @param[in] lines - lines of the report
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportSpooler::spool(const QString &filename, const QStringList &lines)
+{
+    if (!m_thread.isRunning())
+    {
+        write(filename, lines);
+        return;
+    }
+    QMetaObject::invokeMethod(this, "write", Qt::QueuedConnection, Q_ARG(QString, filename), Q_ARG(QStringList, lines));
+}
+
+
+/*!
+ * @brief Creates a file with the lines of a report
+ *
+ * @return false if the file could not be created
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CReportSpooler::writeFile(const QString &path, const QStringList &lines)
+{
+    FILE *fp = fopen(path.toLocal8Bit().data(), "w");
+    if (fp == NULL)
+    {
+        return(false);
+    }
+    for (int i=0; i<lines.size(); i++)
+    {
+        fprintf(fp, "%s\n", lines[i].toLocal8Bit().data());
+    }
+    return(fclose(fp) == 0);
+}
+
+
+/*!
+ * @brief Writes a report to the report directory, or locally if that fails (background thread)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportSpooler::write(const QString &filename, const QStringList &lines)
+{
+    QString path = m_reportDir + filename;
+    if (writeFile(path, lines))
+    {
+        copyPending();
+        emit spooled(path, true, m_pending);
+        return;
+    }
+
+    QString localPath = m_localDir + filename;
+    if (!writeFile(localPath, lines))
+    {
+        emit spoolError("Could not write report to alternate location: " + localPath);
+        return;
+    }
+    m_pending.append(localPath);
+    emit spooled(localPath, false, m_pending);
+}
+
+
+/*!
+ * @brief Copies the reports written locally to the report directory (background thread)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CReportSpooler::copyPending()
+{
+    for (int i=m_pending.size()-1; i>=0; i--)
+    {
+        QFile file(m_pending[i]);
+        if (!file.exists())
+        {
+            m_pending.removeAt(i);
+            continue;
+        }
+        if (file.copy(m_reportDir + QFileInfo(m_pending[i]).fileName()))
+        {
+            file.remove();
+            m_pending.removeAt(i);
+        }
+    }
+}
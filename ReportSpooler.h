@@ -0,0 +1,75 @@
+/*!
+ * @file ReportSpooler.h
+ * @brief Declares the CReportSpooler class
+ *
+ * This class writes the report files in the background
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef REPORTSPOOLER_H
+#define REPORTSPOOLER_H
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * @brief This class writes report files to the report directory from its own thread
+ *
+ * The report directory is normally a network share, which can take
+ * seconds to open.  The main window queues the lines of a report with
+ * spool() and goes on with the next unit while the file is written.
+ *
+ * A report that cannot be written to the report directory is written to
+ * the local directory instead and added to the pending list.  The pending
+ * reports are copied to the report directory (and removed locally) after
+ * the next report that could be written there.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CReportSpooler : public QObject
+{
+    Q_OBJECT
+
+public:
+    CReportSpooler();
+    ~CReportSpooler();
+
+    void setDirectories(const QString &reportDir, const QString &localDir);
+    void setPending(const QStringList &pending) { m_pending = pending; }
+    const QStringList &getPending() { return(m_pending); }     // only once stopped
+    void start();
+    void stop();
+    void spool(const QString &filename, const QStringList &lines);
+
+private slots:
+    void write(const QString &filename, const QStringList &lines);
+    void drain() {}     // stop() waits for this behind the queued writes
+
+signals:
+    void spooled(const QString &path, bool inReportDir, const QStringList &pending);
+    void spoolError(const QString &message);
+
+private:
+    bool writeFile(const QString &path, const QStringList &lines);
+    void copyPending();
+
+private:
+    QThread      m_thread;
+    QString      m_reportDir;     // ends with "/"
+    QString      m_localDir;      // ends with "/"
+    QStringList  m_pending;       // local reports not yet in the report directory
+};
+
+#endif // REPORTSPOOLER_H
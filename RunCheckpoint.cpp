@@ -0,0 +1,245 @@
+/*!
+ * @file RunCheckpoint.cpp
+ * @brief Implements the CRunCheckpoint class
+ *
+ * This class saves the progress of a run so that it can be resumed
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QFile>
+#include <QSettings>
+#include <QStringList>
+#include "RunCheckpoint.h"
+
+
+/*!
+ * @brief CRunCheckpoint constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CRunCheckpoint::CRunCheckpoint()
+{
+    m_filename.clear();
+}
+
+
+/*!
+ * @brief CRunCheckpoint destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CRunCheckpoint::~CRunCheckpoint()
+{
+}
+
+
+/*!
+ * @brief Reads the checkpoint left by a run that did not end
+ *
+ * @param[out] run - the state of the run
+ * @return true if there is a checkpoint, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CRunCheckpoint::load(run_t &run)
+{
+    if (m_filename.isEmpty() || !QFile::exists(m_filename))
+    {
+        return(false);
+    }
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    if ((settings.status() != QSettings::NoError) || !settings.value("Run/Complete", false).toBool())
+    {
+        return(false);
+    }
+
+    run.m_serialNumber = settings.value("Run/SerialNumber", "").toString();
+    run.m_scriptFile = settings.value("Run/ScriptFile", "").toString();
+    run.m_scriptVersion = settings.value("Run/ScriptVersion", "").toString();
+    run.m_nextRun = settings.value("Run/NextRun", 0).toUInt();
+    run.m_passCount = settings.value("Run/PassCount", 0).toInt();
+    run.m_failCount = settings.value("Run/FailCount", 0).toInt();
+    run.m_retestReport = settings.value("Run/RetestReport", "").toString();
+
+    QStringList list;
+    run.m_runOrder.clear();
+    list = settings.value("Run/RunOrder").toStringList();
+    for (int i=0; i<list.size(); i++)
+    {
+        run.m_runOrder.push_back(list[i].toUInt());
+    }
+    run.m_checked.clear();
+    list = settings.value("Run/Checked").toStringList();
+    for (int i=0; i<list.size(); i++)
+    {
+        run.m_checked.push_back(list[i].toUInt());
+    }
+    run.m_failedTests.clear();
+    list = settings.value("Run/FailedTests").toStringList();
+    for (int i=0; i<list.size(); i++)
+    {
+        run.m_failedTests.push_back(list[i].toInt());
+    }
+    run.m_skippedTests.clear();
+    list = settings.value("Run/SkippedTests").toStringList();
+    for (int i=0; i<list.size(); i++)
+    {
+        run.m_skippedTests.push_back(list[i].toInt());
+    }
+
+    run.m_reportStrings.clear();
+    int count = settings.beginReadArray("Report");
+    for (int i=0; i<count; i++)
+    {
+        settings.setArrayIndex(i);
+        run.m_reportStrings.push_back(settings.value("line", "").toString());
+    }
+    settings.endArray();
+
+    run.m_fixtureCommands.clear();
+    count = settings.beginReadArray("Fixture");
+    for (int i=0; i<count; i++)
+    {
+        settings.setArrayIndex(i);
+        run.m_fixtureCommands.push_back(settings.value("command", "").toString());
+    }
+    settings.endArray();
+
+    return(run.m_nextRun <= run.m_runOrder.size());
+}
+
+
+/*!
+ * @brief Writes the checkpoint
+ *
+ * QSettings writes the whole file at sync(), so the checkpoint is written
+ * to a temporary file that replaces the old one only when it was written
+ * without error.  A crash while writing leaves the previous checkpoint (or
+ * none) rather than a half written one.  load() also ignores a file
+ * without the "Run/Complete" key, which is written last.
+ *
+ * @param[in] run - the state of the run
+ * @return true if successful, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CRunCheckpoint::save(const run_t &run)
+{
+    if (m_filename.isEmpty())
+    {
+        return(false);
+    }
+
+    QString tempFilename = m_filename + ".tmp";
+    QFile::remove(tempFilename);
+    if (!writeSettings(tempFilename, run))
+    {
+        QFile::remove(tempFilename);
+        return(false);
+    }
+
+    //
+    // QFile::rename does not replace an existing file
+    //
+    QFile::remove(m_filename);
+    return(QFile::rename(tempFilename, m_filename));
+}
+
+
+/*!
+ * @brief Writes the state of the run to an ini file
+ *
+ * @param[in] filename - the file to write
+ * @param[in] run - the state of the run
+ * @return true if successful, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CRunCheckpoint::writeSettings(const QString &filename, const run_t &run)
+{
+    QSettings settings(filename, QSettings::IniFormat);
+    settings.setValue("Run/SerialNumber", run.m_serialNumber);
+    settings.setValue("Run/ScriptFile", run.m_scriptFile);
+    settings.setValue("Run/ScriptVersion", run.m_scriptVersion);
+    settings.setValue("Run/NextRun", run.m_nextRun);
+    settings.setValue("Run/PassCount", run.m_passCount);
+    settings.setValue("Run/FailCount", run.m_failCount);
+    settings.setValue("Run/RetestReport", run.m_retestReport);
+
+    QStringList list;
+    for (unsigned int i=0; i<run.m_runOrder.size(); i++)
+    {
+        list.append(QString::number(run.m_runOrder[i]));
+    }
+    settings.setValue("Run/RunOrder", list);
+    list.clear();
+    for (unsigned int i=0; i<run.m_checked.size(); i++)
+    {
+        list.append(QString::number(run.m_checked[i]));
+    }
+    settings.setValue("Run/Checked", list);
+    list.clear();
+    for (unsigned int i=0; i<run.m_failedTests.size(); i++)
+    {
+        list.append(QString::number(run.m_failedTests[i]));
+    }
+    settings.setValue("Run/FailedTests", list);
+    list.clear();
+    for (unsigned int i=0; i<run.m_skippedTests.size(); i++)
+    {
+        list.append(QString::number(run.m_skippedTests[i]));
+    }
+    settings.setValue("Run/SkippedTests", list);
+
+    settings.beginWriteArray("Report", run.m_reportStrings.size());
+    for (unsigned int i=0; i<run.m_reportStrings.size(); i++)
+    {
+        settings.setArrayIndex(i);
+        settings.setValue("line", run.m_reportStrings[i]);
+    }
+    settings.endArray();
+
+    settings.beginWriteArray("Fixture", run.m_fixtureCommands.size());
+    for (unsigned int i=0; i<run.m_fixtureCommands.size(); i++)
+    {
+        settings.setArrayIndex(i);
+        settings.setValue("command", run.m_fixtureCommands[i]);
+    }
+    settings.endArray();
+
+    settings.setValue("Run/Complete", true);
+    settings.sync();
+
+    return(settings.status() == QSettings::NoError);
+}
+
+
+/*!
+ * @brief Removes the checkpoint when the run ends
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRunCheckpoint::clear()
+{
+    if (!m_filename.isEmpty())
+    {
+        QFile::remove(m_filename);
+        QFile::remove(m_filename + ".tmp");
+    }
+}
@@ -0,0 +1,73 @@
+/*!
+ * @file RunCheckpoint.h
+ * @brief Declares the CRunCheckpoint class
+ *
+ * This class saves the progress of a run so that it can be resumed
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef RUNCHECKPOINT_H
+#define RUNCHECKPOINT_H
+
+#include <vector>
+#include <QString>
+
+/*!
+ * @brief This class keeps a checkpoint of the run in progress in a local ini file
+ *
+ * The checkpoint is written after each completed test and removed when the
+ * run ends.  If the station crashes or loses power the checkpoint is still
+ * there when the program restarts, and the run of the same serial number
+ * can be resumed with the next test.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CRunCheckpoint
+{
+public:
+    /*!
+     * @brief The state of the run after the last completed test
+     */
+    struct run_t
+    {
+        QString                   m_serialNumber;
+        QString                   m_scriptFile;
+        QString                   m_scriptVersion;
+        std::vector<unsigned int> m_runOrder;       // indexes into the test list
+        std::vector<unsigned int> m_checked;        // indexes of the checked tests
+        unsigned int              m_nextRun;        // index into m_runOrder of the next test
+        int                       m_passCount;
+        int                       m_failCount;
+        std::vector<int>          m_failedTests;    // test numbers
+        std::vector<int>          m_skippedTests;
+        std::vector<QString>      m_reportStrings;  // the report so far
+        std::vector<QString>      m_fixtureCommands;// commands that set the known fixture state
+        QString                   m_retestReport;   // report being retested, empty for a full run
+    };
+
+    CRunCheckpoint();
+    ~CRunCheckpoint();
+
+    void setFilename(const QString &filename) { m_filename = filename; }
+    bool load(run_t &run);
+    bool save(const run_t &run);
+    void clear();
+
+private:
+    bool writeSettings(const QString &filename, const run_t &run);
+
+private:
+    QString  m_filename;
+};
+
+#endif // RUNCHECKPOINT_H
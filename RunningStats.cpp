@@ -0,0 +1,153 @@
+/*!
+ * @file RunningStats.cpp
+ * @brief Implements the CRunningStats class
+ *
+ * This simple class accumulates statistics of a stream of values
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <math.h>
+#include <QStringList>
+#include "RunningStats.h"
+
+
+/*!
+ * @brief CRunningStats constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CRunningStats::CRunningStats()
+{
+    clear();
+}
+
+
+/*!
+ * @brief Discards all accumulated values
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRunningStats::clear()
+{
+    m_count = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_min = 0.0;
+    m_max = 0.0;
+}
+
+
+/*!
+ * @brief Adds a value to the statistics
+ *
+ * @param[in] value - the new value
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CRunningStats::add(double value)
+{
+    m_count++;
+    if (m_count == 1)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        if (value < m_min)
+            m_min = value;
+        if (value > m_max)
+            m_max = value;
+    }
+
+    double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+}
+
+
+/*!
+ * @brief Returns the sample variance of the values
+ *
+ * @return the variance, 0 if there are fewer than two values
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CRunningStats::variance() const
+{
+    if (m_count < 2)
+    {
+        return(0.0);
+    }
+    return(m_m2 / (m_count - 1));
+}
+
+
+/*!
+ * @brief Returns the sample standard deviation of the values
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CRunningStats::stdDev() const
+{
+    return(sqrt(variance()));
+}
+
+
+/*!
+ * @brief Returns the state of the statistics as "count,mean,m2,min,max"
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CRunningStats::toString() const
+{
+    QString str = "%1,%2,%3,%4,%5";
+    return(str.arg(m_count).arg(m_mean, 0, 'g', 17).arg(m_m2, 0, 'g', 17).arg(m_min, 0, 'g', 17).arg(m_max, 0, 'g', 17));
+}
+
+
+/*!
+ * @brief Restores the state written by toString()
+ *
+ * @param[in] str - the state
+ * @return false if the string is not valid, the statistics are then cleared
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CRunningStats::fromString(const QString &str)
+{
+    clear();
+    QStringList fields = str.split(',');
+    if (fields.size() != 5)
+    {
+        return(false);
+    }
+    bool ok[5];
+    m_count = fields[0].toInt(&ok[0]);
+    m_mean = fields[1].toDouble(&ok[1]);
+    m_m2 = fields[2].toDouble(&ok[2]);
+    m_min = fields[3].toDouble(&ok[3]);
+    m_max = fields[4].toDouble(&ok[4]);
+    if (!ok[0] || !ok[1] || !ok[2] || !ok[3] || !ok[4] || (m_count < 0))
+    {
+        clear();
+        return(false);
+    }
+    return(true);
+}
@@ -0,0 +1,57 @@
+/*!
+ * @file RunningStats.h
+ * @brief Declares the CRunningStats class
+ *
+ * This simple class accumulates statistics of a stream of values
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef RUNNINGSTATS_H
+#define RUNNINGSTATS_H
+
+#include <QString>
+
+/*!
+ * @brief This class holds the count, mean, variance, min and max of a stream of values
+ *
+ * The mean and variance are updated with Welford's method so no
+ * samples need to be kept.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CRunningStats
+{
+public:
+    CRunningStats();
+    void clear();
+    void add(double value);
+
+    int    count() const     { return(m_count); }
+    double mean() const      { return(m_mean); }
+    double minimum() const   { return(m_min); }
+    double maximum() const   { return(m_max); }
+    double variance() const;
+    double stdDev() const;
+
+    QString toString() const;
+    bool    fromString(const QString &str);
+
+private:
+    int     m_count;
+    double  m_mean;
+    double  m_m2;     // sum of squared differences from the mean
+    double  m_min;
+    double  m_max;
+};
+
+#endif // RUNNINGSTATS_H
@@ -0,0 +1,302 @@
+/*!
+ * @file ScriptLibrary.cpp
+ * @brief Implements the CScriptLibrary class
+ *
+ * This class keeps the scripts of several products ready to run
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include <QFileInfo>
+#include <QDir>
+#include "ScriptLibrary.h"
+
+
+/*!
+ * @brief CScriptLibrary constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CScriptLibrary::CScriptLibrary()
+{
+    m_products.clear();
+}
+
+
+/*!
+ * @brief CScriptLibrary destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CScriptLibrary::~CScriptLibrary()
+{
+    clear();
+}
+
+
+/*!
+ * @brief Forgets all of the products and rules
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CScriptLibrary::clear()
+{
+    for (unsigned int i=0; i<m_products.size(); i++)
+    {
+        delete m_products[i].m_script;
+    }
+    m_products.clear();
+    m_prefixRules.clear();
+    m_zNumberRules.clear();
+    m_probes.clear();
+}
+
+
+/*!
+ * @brief Reads the rule file and parses the script of every product
+ *
+ * Lines of the file:
+ *     script  <product> <script file> [Z number]
+ *     prefix  <regex> <product>
+ *     znumber <Z number> <product>
+ *     probe   <A|B> <command> <regex> <product>
+ *
+ * Script files without a directory are looked for next to the rule file.
+ * Lines that cannot be used are skipped and described in errors.
+ *
+ * @param[in] filename - the rule file
+ * @param[out] errors - problems found in the file
+ * @return false if the file could not be read or has no usable product
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CScriptLibrary::loadRules(const QString &filename, QStringList &errors)
+{
+    clear();
+    errors.clear();
+
+    FILE *fp = fopen(filename.toLocal8Bit().data(), "r");
+    if (fp == NULL)
+    {
+        errors.append("Could not open " + filename);
+        return(false);
+    }
+    QDir ruleDir = QFileInfo(filename).absoluteDir();
+
+    int lineNumber = 0;
+    while (!feof(fp))
+    {
+        char lineBuffer[1024];
+        if (!fgets(lineBuffer, sizeof(lineBuffer), fp))
+        {
+            continue;
+        }
+        lineNumber++;
+
+        QString line = QString(lineBuffer).trimmed();
+        if (line.isEmpty() || line.startsWith("#"))
+        {
+            continue;
+        }
+
+        QStringList args = line.split(QRegExp("[ \t]"), QString::SkipEmptyParts);
+        QString where = QString("%1 line %2: ").arg(QFileInfo(filename).fileName()).arg(lineNumber);
+        if ((args[0] == "script") && (args.size() >= 3))
+        {
+            if (findProduct(args[1]) >= 0)
+            {
+                errors.append(where + "product " + args[1] + " is declared twice");
+                continue;
+            }
+            product_t product;
+            product.m_name = args[1];
+            product.m_scriptFile = QDir::cleanPath(ruleDir.absoluteFilePath(args[2]));
+            product.m_zNumber = (args.size() >= 4) ? args[3] : QString();
+            product.m_script = new CTestScript();
+            if (!product.m_script->readScriptFile(product.m_scriptFile.toLocal8Bit().data()))
+            {
+                errors.append(where + "could not read " + product.m_scriptFile);
+                delete product.m_script;
+                continue;
+            }
+            m_products.push_back(product);
+        }
+        else if (((args[0] == "prefix") || (args[0] == "znumber")) && (args.size() >= 3))
+        {
+            rule_t rule;
+            if (args[0] == "prefix")
+            {
+                rule.m_pattern = QRegExp("^(" + args[1] + ")");
+            }
+            else
+            {
+                rule.m_pattern = QRegExp(QRegExp::escape(args[1]), Qt::CaseInsensitive);
+            }
+            rule.m_product = args[2];
+            if (!rule.m_pattern.isValid() || (findProduct(rule.m_product) < 0))
+            {
+                errors.append(where + "bad pattern or unknown product");
+                continue;
+            }
+            if (args[0] == "prefix")
+            {
+                m_prefixRules.push_back(rule);
+            }
+            else
+            {
+                m_zNumberRules.push_back(rule);
+            }
+        }
+        else if ((args[0] == "probe") && (args.size() >= 5))
+        {
+            probe_t probe;
+            probe.m_portIndex = (args[1].toUpper() == "B") ? 1 : 0;
+            probe.m_command = args[2];
+            probe.m_reply = QRegExp(args[3]);
+            probe.m_product = args[4];
+            if (!probe.m_reply.isValid() || (findProduct(probe.m_product) < 0))
+            {
+                errors.append(where + "bad pattern or unknown product");
+                continue;
+            }
+            m_probes.push_back(probe);
+        }
+        else
+        {
+            errors.append(where + "not understood");
+        }
+    }
+
+    fclose(fp);
+    return(!m_products.empty());
+}
+
+
+/*!
+ * @brief Returns the index of a product, -1 if it is not in the library
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CScriptLibrary::findProduct(const QString &product)
+{
+    for (unsigned int i=0; i<m_products.size(); i++)
+    {
+        if (m_products[i].m_name == product)
+        {
+            return(i);
+        }
+    }
+    return(-1);
+}
+
+
+/*!
+ * @brief Returns the names of the products, in the order of the rule file
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QStringList CScriptLibrary::getProducts()
+{
+    QStringList products;
+    for (unsigned int i=0; i<m_products.size(); i++)
+    {
+        products.append(m_products[i].m_name);
+    }
+    return(products);
+}
+
+
+/*!
+ * @brief Returns the parsed script of a product, NULL if it is not in the library
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestScript *CScriptLibrary::getScript(const QString &product)
+{
+    int i = findProduct(product);
+    return((i < 0) ? NULL : m_products[i].m_script);
+}
+
+
+/*!
+ * @brief Returns the path of the script file of a product
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CScriptLibrary::getScriptFile(const QString &product)
+{
+    int i = findProduct(product);
+    return((i < 0) ? QString() : m_products[i].m_scriptFile);
+}
+
+
+/*!
+ * @brief Returns the Z number of a product, empty if it has none
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CScriptLibrary::getZNumber(const QString &product)
+{
+    int i = findProduct(product);
+    return((i < 0) ? QString() : m_products[i].m_zNumber);
+}
+
+
+/*!
+ * @brief Returns the product of the first prefix rule matching a serial number
+ *
+ * @return the product, empty if no rule matches
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CScriptLibrary::matchSerialNumber(const QString &serialNumber)
+{
+    for (unsigned int i=0; i<m_prefixRules.size(); i++)
+    {
+        if (m_prefixRules[i].m_pattern.indexIn(serialNumber) == 0)
+        {
+            return(m_prefixRules[i].m_product);
+        }
+    }
+    return(QString());
+}
+
+
+/*!
+ * @brief Returns the product of the Z number a serial number was logged under
+ *
+ * @return the product, empty if no rule matches
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CScriptLibrary::matchZNumber(const QString &zNumber)
+{
+    for (unsigned int i=0; i<m_zNumberRules.size(); i++)
+    {
+        if (m_zNumberRules[i].m_pattern.exactMatch(zNumber.trimmed()))
+        {
+            return(m_zNumberRules[i].m_product);
+        }
+    }
+    return(QString());
+}
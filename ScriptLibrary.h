@@ -0,0 +1,97 @@
+/*!
+ * @file ScriptLibrary.h
+ * @brief Declares the CScriptLibrary class
+ *
+ * This class keeps the scripts of several products ready to run
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef SCRIPTLIBRARY_H
+#define SCRIPTLIBRARY_H
+
+#include <vector>
+#include <QString>
+#include <QStringList>
+#include <QRegExp>
+#include "TestScript.h"
+
+/*!
+ * @brief This class keeps the parsed scripts of several products in memory
+ *
+ * The products and the rules that pick one of them for a unit are read
+ * from a rule file (see Products.txt).  Every script of the file is read
+ * and parsed once when the rule file is loaded; the main window copies
+ * the script of the product it selects into its own script with
+ * CTestScript::copyScript, so switching products does not read the file.
+ *
+ * A product is picked by the first rule that matches, trying the serial
+ * number prefixes first, then the Z number of the serial number in the
+ * database, then the replies of the DUT or fixture to probe commands.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CScriptLibrary
+{
+public:
+    /*!
+     * @brief A command sent to identify the product
+     */
+    struct probe_t
+    {
+        int      m_portIndex;     // 0 = port A (DUT), 1 = port B (fixture)
+        QString  m_command;
+        QRegExp  m_reply;         // matched against each line of the reply
+        QString  m_product;
+    };
+
+public:
+    CScriptLibrary();
+    ~CScriptLibrary();
+
+    bool loadRules(const QString &filename, QStringList &errors);
+    void clear();
+    bool isEmpty() { return(m_products.empty()); }
+    QStringList getProducts();
+    CTestScript *getScript(const QString &product);
+    QString getScriptFile(const QString &product);
+    QString getZNumber(const QString &product);
+
+    QString matchSerialNumber(const QString &serialNumber);
+    bool hasZNumberRules() { return(!m_zNumberRules.empty()); }
+    QString matchZNumber(const QString &zNumber);
+    const std::vector<probe_t> &getProbes() { return(m_probes); }
+
+private:
+    int findProduct(const QString &product);
+
+private:
+    struct product_t
+    {
+        QString       m_name;
+        QString       m_scriptFile;
+        QString       m_zNumber;       // used to validate its serial numbers, may be empty
+        CTestScript  *m_script;
+    };
+    struct rule_t
+    {
+        QRegExp  m_pattern;
+        QString  m_product;
+    };
+
+    std::vector<product_t>  m_products;
+    std::vector<rule_t>     m_prefixRules;
+    std::vector<rule_t>     m_zNumberRules;
+    std::vector<probe_t>    m_probes;
+};
+
+#endif // SCRIPTLIBRARY_H
@@ -0,0 +1,325 @@
+/*!
+ * @file SerialChannel.cpp
+ * @brief Implements the CSerialChannel class
+ *
+ * This class does the line oriented I/O on one serial port
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <string.h>
+#include <algorithm>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+#include "SerialChannel.h"
+#include "StationMetrics.h"
+
+
+/*!
+ * @brief CSerialChannel constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSerialChannel::CSerialChannel()
+{
+    m_port = NULL;
+    m_outputDelay_ms = 0;
+    m_pendingIndex = -1;
+    m_pendingWritten = 0;
+}
+
+
+/*!
+ * @brief CSerialChannel destructor
+ *
+ * The port is owned by the caller and is not closed.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSerialChannel::~CSerialChannel()
+{
+    m_input.clear();
+    m_pendingOutput.clear();
+}
+
+
+/*!
+ * @brief sleeps for specified milliseconds
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialChannel::snooze(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, SLOT(quit()));
+    loop.exec();
+}
+
+
+/*!
+ * @brief Sends a command one character at a time followed by CR-LF
+ *
+ * @param[in] command - the command, comments are not sent
+ * @return true if every character was written
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSerialChannel::send(const char *command)
+{
+    if (!isOpen())
+    {
+        return(false);
+    }
+
+    QString cmd = command;
+    int index = cmd.indexOf("//");
+    if (index >= 0)
+        cmd.truncate(index);
+    index = cmd.indexOf("#");
+    if (index >= 0)
+        cmd.truncate(index);
+    cmd = cmd.trimmed();
+
+    flush();
+
+    QByteArray bytes = cmd.toLocal8Bit();
+    int bytesWritten = 0;
+    int commandLength = bytes.size();
+    char smallStr[2];
+    smallStr[1] = '\0';
+    for (int k=0; k<commandLength; k++)
+    {
+        smallStr[0] = bytes.at(k);
+        bytesWritten += m_port->write(smallStr);
+        snooze(m_outputDelay_ms);
+    }
+    bytesWritten += m_port->write("\r\n");
+    CStationMetrics::Instance()->bytesOut(m_port->portName(), bytesWritten);
+
+    return(bytesWritten >= commandLength+2);
+}
+
+
+/*!
+ * @brief Reads a line, waiting up to the timeout between received characters
+ *
+ * Empty lines are skipped.
+ *
+ * @param[in] buffer - place to put the line
+ * @param[in] bufferSize - size of the buffer
+ * @param[in] msTimeout - timeout period between successful reads
+ * @return true if a line was read
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSerialChannel::readLine(char *buffer, const int bufferSize, const int msTimeout)
+{
+    int tick = 0;
+    while (tick < msTimeout)
+    {
+        if (!isOpen())
+        {
+            buffer[0] = '\0';
+            return(false);
+        }
+        int before = m_input.size();
+        if (pollLine(buffer, bufferSize))
+        {
+            return(true);
+        }
+        if (m_input.size() > before)
+        {
+            tick = 0;
+            continue;
+        }
+        qApp->processEvents();
+        snooze(1);
+        tick++;
+    }
+    CStationMetrics::Instance()->readTimeout(m_port->portName());
+    buffer[0] = '\0';
+    return(false);
+}
+
+
+/*!
+ * @brief Reads a block of raw bytes, no line terminators are interpreted
+ *
+ * @param[in] buffer - place to put the bytes
+ * @param[in] count - number of bytes to read
+ * @param[in] msTimeout - timeout period between successful reads
+ * @return the number of bytes read
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CSerialChannel::readBytes(char *buffer, const int count, const int msTimeout)
+{
+    int index = 0;
+    int tick = 0;
+    while ((index < count) && (tick < msTimeout) && isOpen())
+    {
+        QByteArray received = m_port->readAll();
+        CStationMetrics::Instance()->bytesIn(m_port->portName(), received.size());
+        m_input.append(received);
+        if (!m_input.isEmpty())
+        {
+            int n = std::min(count - index, m_input.size());
+            memcpy(&buffer[index], m_input.constData(), n);
+            m_input.remove(0, n);
+            index += n;
+            tick = 0;
+            continue;
+        }
+        qApp->processEvents();
+        snooze(1);
+        tick++;
+    }
+    if ((index < count) && isOpen())
+    {
+        CStationMetrics::Instance()->readTimeout(m_port->portName());
+    }
+    return(index);
+}
+
+
+/*!
+ * @brief Discards everything that has been received
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialChannel::flush()
+{
+    if (m_port != NULL)
+    {
+        m_port->clear();
+    }
+    m_input.clear();
+}
+
+
+/*!
+ * @brief Starts sending a command without waiting
+ *
+ * @param[in] command - the command, without comments
+ * @return false if the port is not open
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSerialChannel::startCommand(const char *command)
+{
+    flush();
+    m_pendingOutput = command;
+    m_pendingIndex = 0;
+    m_pendingWritten = 0;
+    m_pendingTime.start();
+    return(isOpen());
+}
+
+
+/*!
+ * @brief Writes the next character of the command started by startCommand
+ *
+ * @return 0 while the command is being sent, 1 when it has been sent, -1 on a write error
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CSerialChannel::pollOutput()
+{
+    int commandLength = m_pendingOutput.size();
+    if (m_pendingIndex < 0)
+    {
+        return((m_pendingWritten < commandLength+2) ? -1 : 1);
+    }
+    if (!isOpen())
+    {
+        m_pendingIndex = -1;
+        return(-1);
+    }
+    if ((m_pendingIndex > 0) && (m_pendingTime.elapsed() < m_outputDelay_ms))
+    {
+        return(0);
+    }
+
+    if (m_pendingIndex < commandLength)
+    {
+        char smallStr[2];
+        smallStr[0] = m_pendingOutput.at(m_pendingIndex);
+        smallStr[1] = '\0';
+        qint64 n = m_port->write(smallStr);
+        m_pendingWritten += n;
+        CStationMetrics::Instance()->bytesOut(m_port->portName(), n);
+        m_pendingIndex++;
+        m_pendingTime.start();
+        return(0);
+    }
+
+    qint64 n = m_port->write("\r\n");
+    m_pendingWritten += n;
+    CStationMetrics::Instance()->bytesOut(m_port->portName(), n);
+    m_pendingIndex = -1;
+    return((m_pendingWritten < commandLength+2) ? -1 : 1);
+}
+
+
+/*!
+ * @brief Returns a line if a whole line has arrived, without waiting
+ *
+ * @param[in] buffer - place to put the line
+ * @param[in] bufferSize - size of the buffer
+ * @return true if a line was returned
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSerialChannel::pollLine(char *buffer, const int bufferSize)
+{
+    buffer[0] = '\0';
+    if (!isOpen())
+    {
+        return(false);
+    }
+    QByteArray received = m_port->readAll();
+    CStationMetrics::Instance()->bytesIn(m_port->portName(), received.size());
+    m_input.append(received);
+
+    while (!m_input.isEmpty())
+    {
+        int end = 0;
+        while ((end < m_input.size()) && (m_input.at(end) != '\r') && (m_input.at(end) != '\n'))
+        {
+            end++;
+        }
+        if ((end == m_input.size()) && (end < bufferSize-1))
+        {
+            return(false);
+        }
+
+        int n = std::min(end, bufferSize-1);
+        memcpy(buffer, m_input.constData(), n);
+        buffer[n] = '\0';
+        m_input.remove(0, (n < end) ? n : end+1);
+        if (n > 0)
+        {
+            return(true);
+        }
+    }
+    return(false);
+}
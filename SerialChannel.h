@@ -0,0 +1,68 @@
+/*!
+ * @file SerialChannel.h
+ * @brief Declares the CSerialChannel class
+ *
+ * This class does the line oriented I/O on one serial port
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef SERIALCHANNEL_H
+#define SERIALCHANNEL_H
+
+#include <QSerialPort>
+#include <QByteArray>
+#include <QTime>
+
+/*!
+ * @brief This class sends commands to and reads replies from one serial port
+ *
+ * It does the same I/O as the main window does for ports A and B, for the
+ * ports that are not owned by the main window (the DUT ports of a panel
+ * and the shared fixture port).  It must only be used from the thread
+ * that the serial port lives in.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CSerialChannel
+{
+public:
+    CSerialChannel();
+    ~CSerialChannel();
+
+    void setPort(QSerialPort *port) { m_port = port; }
+    QSerialPort *getPort() { return(m_port); }
+    void setOutputDelay(int outputDelay_ms) { m_outputDelay_ms = outputDelay_ms; }
+    bool isOpen() { return((m_port != NULL) && m_port->isOpen()); }
+
+    bool send(const char *command);
+    bool readLine(char *buffer, const int bufferSize, const int msTimeout);
+    int  readBytes(char *buffer, const int count, const int msTimeout);
+    void flush();
+    bool startCommand(const char *command);
+    int  pollOutput();
+    bool pollLine(char *buffer, const int bufferSize);
+
+private:
+    void snooze(int ms);
+
+private:
+    QSerialPort  *m_port;
+    int           m_outputDelay_ms;   // ms delay between output characters
+    QByteArray    m_input;            // received bytes not yet returned
+    QByteArray    m_pendingOutput;    // command being paced out by pollOutput
+    int           m_pendingIndex;     // next character to write, -1 when idle
+    int           m_pendingWritten;
+    QTime         m_pendingTime;      // time of the last character written
+};
+
+#endif // SERIALCHANNEL_H
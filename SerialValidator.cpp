@@ -0,0 +1,195 @@
+/*!
+ * @file SerialValidator.cpp
+ * @brief Implements the CSerialValidator class
+ *
+ * This class looks up serial numbers in the database in the background
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTime>
+#include "SerialValidator.h"
+#include "StationMetrics.h"
+
+
+/*!
+ * @brief CSerialValidator constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSerialValidator::CSerialValidator()
+{
+    m_connectionName = "serialValidator";
+}
+
+
+/*!
+ * @brief CSerialValidator destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSerialValidator::~CSerialValidator()
+{
+    stop();
+}
+
+
+/*!
+ * @brief Sets the database parameters (the Database section of the ini file)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialValidator::setDatabase(const QString &server, const QString &name, const QString &user,
+                                   const QString &password, const QString &zNumber)
+{
+    m_server = server;
+    m_name = name;
+    m_user = user;
+    m_password = password;
+    m_zNumber = zNumber;
+}
+
+
+/*!
+ * @brief Starts the background thread
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialValidator::start()
+{
+    if (m_thread.isRunning())
+    {
+        return;
+    }
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+
+/*!
+ * @brief Closes the database and stops the thread
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialValidator::stop()
+{
+    if (!m_thread.isRunning())
+    {
+        return;
+    }
+    QMetaObject::invokeMethod(this, "close", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+
+/*!
+ * @brief Opens the connection to the database if it is not open (background thread)
+ *
+ * @param[out] error - why the connection failed
+ * @return true if the database is open
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSerialValidator::open(QString &error)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    if (db.isOpen())
+    {
+        return(true);
+    }
+    if (m_server.isEmpty() || m_name.isEmpty())
+    {
+        error = "Database server and/or name were not specified.";
+        return(false);
+    }
+    if (!db.isValid())
+    {
+        db = QSqlDatabase::addDatabase("QODBC", m_connectionName);
+    }
+    QString connectionString = "DRIVER={SQL SERVER};SERVER=%1;DATABASE=%2;";
+    db.setDatabaseName(connectionString.arg(m_server).arg(m_name));
+    if (!db.open(m_user, m_password))
+    {
+        error = "Failed to connect to database: " + db.lastError().text();
+        return(false);
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Looks up a serial number (background thread)
+ *
+ * The answer is given with the validated() signal.
+ *
+ * @param[in] serialNumber - the serial number
+ * @param[in] zNumber - Z number of its product, empty for the one of setDatabase
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialValidator::validate(const QString &serialNumber, const QString &zNumber)
+{
+    QString error;
+    if (!open(error))
+    {
+        emit validated(serialNumber, false, error);
+        return;
+    }
+
+    QString queryStr;
+    queryStr.append("SELECT SNLogDetail.Job, SNLogDetail.Suffix ");
+    queryStr.append("FROM EnerconUtilities.dbo.SNLogDetail (NOLOCK) ");
+    queryStr.append("INNER JOIN EnerconUtilities.dbo.SNLog2 (NOLOCK) ");
+    queryStr.append("ON SNLogDetail.RecordNo = SNLog2.RecordNo ");
+    queryStr.append("WHERE SNLogDetail.SN1='%1' AND SNLog2.[Z Number] ='%2'");
+    queryStr = queryStr.arg(serialNumber).arg(zNumber.isEmpty() ? m_zNumber : zNumber);
+
+    QTime lookupTime;
+    lookupTime.start();
+    QSqlQuery query(queryStr, QSqlDatabase::database(m_connectionName, false));
+    bool found = query.next();
+    CStationMetrics::Instance()->databaseLookup(lookupTime.elapsed()/1000.0);
+    if (!found && query.lastError().isValid())
+    {
+        error = query.lastError().text();
+    }
+    emit validated(serialNumber, found, error);
+}
+
+
+/*!
+ * @brief Closes the database (background thread)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSerialValidator::close()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+        if (db.isValid())
+        {
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
@@ -0,0 +1,71 @@
+/*!
+ * @file SerialValidator.h
+ * @brief Declares the CSerialValidator class
+ *
+ * This class looks up serial numbers in the database in the background
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef SERIALVALIDATOR_H
+#define SERIALVALIDATOR_H
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+
+/*!
+ * @brief This class validates serial numbers without blocking the main window
+ *
+ * It runs in its own thread with its own connection to the serial number
+ * database (a QSqlDatabase connection can only be used by the thread that
+ * opened it), so a scan can be validated while a unit is being tested.
+ * The query is the one of MainWindow::serialNumberIsInDB.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CSerialValidator : public QObject
+{
+    Q_OBJECT
+
+public:
+    CSerialValidator();
+    ~CSerialValidator();
+
+    void setDatabase(const QString &server, const QString &name, const QString &user,
+                     const QString &password, const QString &zNumber);
+    void start();
+    void stop();
+
+public slots:
+    void validate(const QString &serialNumber, const QString &zNumber);
+
+private slots:
+    void close();
+
+signals:
+    void validated(const QString &serialNumber, bool found, const QString &error);
+
+private:
+    bool open(QString &error);
+
+private:
+    QThread   m_thread;
+    QString   m_connectionName;
+    QString   m_server;
+    QString   m_name;
+    QString   m_user;
+    QString   m_password;
+    QString   m_zNumber;
+};
+
+#endif // SERIALVALIDATOR_H
@@ -0,0 +1,384 @@
+/*!
+ * @file SignalAnalysis.cpp
+ * @brief Implements the CSignalAnalysis class
+ *
+ * This class holds a block of captured samples and analyzes it
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <math.h>
+#include "SignalAnalysis.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+/*!
+ * @brief CSignalAnalysis constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSignalAnalysis::CSignalAnalysis()
+{
+    m_fftSize = 0;
+    clear();
+}
+
+
+/*!
+ * @brief CSignalAnalysis destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSignalAnalysis::~CSignalAnalysis()
+{
+    m_samples.clear();
+    m_fft.clear();
+    m_power.clear();
+}
+
+
+/*!
+ * @brief Allocates the buffers for the largest block that will be captured
+ *
+ * This is called when a script is loaded so that no memory is
+ * allocated while a test is running.
+ *
+ * @param[in] maxSamples - the largest sample count of any readblock command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSignalAnalysis::reserve(int maxSamples)
+{
+    int fftSize = 1;
+    while (fftSize < maxSamples)
+    {
+        fftSize <<= 1;
+    }
+
+    m_samples.assign(maxSamples, 0.0);
+    m_fft.assign(fftSize, std::complex<double>(0.0, 0.0));
+    m_power.assign(fftSize/2 + 1, 0.0);
+    clear();
+}
+
+
+/*!
+ * @brief Discards the captured block
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSignalAnalysis::clear()
+{
+    m_sampleCount = 0;
+    m_sampleRate = 0.0;
+    m_spectrumValid = false;
+}
+
+
+/*!
+ * @brief Prepares the buffer for a new capture
+ *
+ * @param[in] sampleCount - number of samples that will be captured
+ * @param[in] sampleRate - sample rate of the block in Hz
+ * @return pointer to the sample buffer, NULL if the block was not reserved
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double *CSignalAnalysis::beginCapture(int sampleCount, double sampleRate)
+{
+    clear();
+    if ((sampleCount <= 0) || (sampleCount > (int) m_samples.size()))
+    {
+        return(NULL);
+    }
+    m_sampleRate = sampleRate;
+    return(&m_samples[0]);
+}
+
+
+/*!
+ * @brief Records the number of samples actually captured
+ *
+ * @param[in] samplesCaptured - number of valid samples in the buffer
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSignalAnalysis::endCapture(int samplesCaptured)
+{
+    m_sampleCount = samplesCaptured;
+    m_spectrumValid = false;
+}
+
+
+/*!
+ * @brief Returns the RMS of the AC component of the block
+ *
+ * The mean of the block is removed before the RMS is computed.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CSignalAnalysis::rms()
+{
+    if (m_sampleCount <= 0)
+    {
+        return(0.0);
+    }
+
+    const double *x = &m_samples[0];
+    double sum = 0.0;
+    for (int i=0; i<m_sampleCount; i++)
+    {
+        sum += x[i];
+    }
+    double mean = sum / m_sampleCount;
+
+    double sumSquares = 0.0;
+    for (int i=0; i<m_sampleCount; i++)
+    {
+        double d = x[i] - mean;
+        sumSquares += d * d;
+    }
+    return(sqrt(sumSquares / m_sampleCount));
+}
+
+
+/*!
+ * @brief Computes the power spectrum of the block
+ *
+ * The block has its mean removed, is multiplied by a Hann window, zero
+ * padded to the next power of two and transformed with an in-place
+ * radix-2 FFT.
+ *
+ * @return true if a spectrum is available
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSignalAnalysis::computeSpectrum()
+{
+    if (m_spectrumValid)
+    {
+        return(true);
+    }
+    if ((m_sampleCount < 4) || (m_sampleRate <= 0.0))
+    {
+        return(false);
+    }
+
+    //
+    // The transform is done on the smallest power of two that holds the block
+    //
+    int n = 1;
+    while (n < m_sampleCount)
+    {
+        n <<= 1;
+    }
+    m_fftSize = n;
+
+    double mean = 0.0;
+    for (int i=0; i<m_sampleCount; i++)
+    {
+        mean += m_samples[i];
+    }
+    mean /= m_sampleCount;
+
+    std::complex<double> *X = &m_fft[0];
+    for (int i=0; i<m_sampleCount; i++)
+    {
+        double w = 0.5 - 0.5*cos(2.0*M_PI*i/(m_sampleCount-1));
+        X[i] = std::complex<double>((m_samples[i] - mean) * w, 0.0);
+    }
+    for (int i=m_sampleCount; i<n; i++)
+    {
+        X[i] = std::complex<double>(0.0, 0.0);
+    }
+
+    //
+    // Bit reversal permutation
+    //
+    for (int i=1, j=0; i<n; i++)
+    {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::complex<double> t = X[i];
+            X[i] = X[j];
+            X[j] = t;
+        }
+    }
+
+    //
+    // Butterflies
+    //
+    for (int len=2; len<=n; len<<=1)
+    {
+        double angle = -2.0*M_PI/len;
+        std::complex<double> wlen(cos(angle), sin(angle));
+        for (int i=0; i<n; i+=len)
+        {
+            std::complex<double> w(1.0, 0.0);
+            for (int j=0; j<len/2; j++)
+            {
+                std::complex<double> u = X[i+j];
+                std::complex<double> v = X[i+j+len/2] * w;
+                X[i+j] = u + v;
+                X[i+j+len/2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+
+    for (int k=0; k<=n/2; k++)
+    {
+        m_power[k] = std::norm(X[k]);
+    }
+
+    m_spectrumValid = true;
+    return(true);
+}
+
+
+/*!
+ * @brief Converts a (fractional) FFT bin to a frequency in Hz
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CSignalAnalysis::binFrequency(double bin)
+{
+    return(bin * m_sampleRate / m_fftSize);
+}
+
+
+/*!
+ * @brief Returns the frequency of the largest peak in the spectrum
+ *
+ * The DC bin is ignored.  The peak location is refined by fitting
+ * a parabola through the peak bin and its neighbors.
+ *
+ * @return the frequency in Hz, 0 if the block can not be analyzed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CSignalAnalysis::peakFrequency()
+{
+    if (!computeSpectrum())
+    {
+        return(0.0);
+    }
+
+    int half = m_fftSize / 2;
+    int peak = 1;
+    for (int k=2; k<=half; k++)
+    {
+        if (m_power[k] > m_power[peak])
+        {
+            peak = k;
+        }
+    }
+
+    double offset = 0.0;
+    if ((peak > 1) && (peak < half))
+    {
+        double a = log(m_power[peak-1] + 1e-300);
+        double b = log(m_power[peak]   + 1e-300);
+        double c = log(m_power[peak+1] + 1e-300);
+        double denom = a - 2.0*b + c;
+        if (denom != 0.0)
+        {
+            offset = 0.5 * (a - c) / denom;
+        }
+    }
+    return(binFrequency(peak + offset));
+}
+
+
+/*!
+ * @brief Returns the power of a harmonic of the fundamental
+ *
+ * The Hann window spreads a tone over three bins so the power of the
+ * bins around the harmonic is summed.
+ *
+ * @param[in] fundamentalBin - bin of the fundamental (may be fractional)
+ * @param[in] harmonic - 1 for the fundamental, 2 for the second harmonic...
+ * @return the power, 0 if the harmonic is above the Nyquist frequency
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CSignalAnalysis::harmonicPower(double fundamentalBin, int harmonic)
+{
+    int half = m_fftSize / 2;
+    int center = (int) floor(fundamentalBin * harmonic + 0.5);
+    if (center >= half)
+    {
+        return(0.0);
+    }
+
+    double power = 0.0;
+    for (int k=center-1; k<=center+1; k++)
+    {
+        if ((k > 0) && (k <= half))
+        {
+            power += m_power[k];
+        }
+    }
+    return(power);
+}
+
+
+/*!
+ * @brief Returns the total harmonic distortion of the block
+ *
+ * @param[in] harmonics - highest harmonic included (2..harmonics)
+ * @return THD in percent of the fundamental, -1 if the block can not be analyzed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CSignalAnalysis::thd(int harmonics)
+{
+    double peak = peakFrequency();
+    if (peak <= 0.0)
+    {
+        return(-1.0);
+    }
+
+    double fundamentalBin = peak * m_fftSize / m_sampleRate;
+    double fundamental = harmonicPower(fundamentalBin, 1);
+    if (fundamental <= 0.0)
+    {
+        return(-1.0);
+    }
+
+    double distortion = 0.0;
+    for (int h=2; h<=harmonics; h++)
+    {
+        distortion += harmonicPower(fundamentalBin, h);
+    }
+    return(100.0 * sqrt(distortion / fundamental));
+}
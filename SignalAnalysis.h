@@ -0,0 +1,67 @@
+/*!
+ * @file SignalAnalysis.h
+ * @brief Declares the CSignalAnalysis class
+ *
+ * This class holds a block of captured samples and analyzes it
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef SIGNALANALYSIS_H
+#define SIGNALANALYSIS_H
+
+#include <vector>
+#include <complex>
+
+/*!
+ * @brief This class holds the samples captured by the readblock command
+ *
+ * The buffers are allocated once, when the script is loaded, for the
+ * largest block the script captures.  The spectrum is computed with a
+ * radix-2 FFT (Hann window, zero padded to a power of two) the first time
+ * it is needed after a capture.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CSignalAnalysis
+{
+public:
+    CSignalAnalysis();
+    ~CSignalAnalysis();
+
+    void    reserve(int maxSamples);
+    void    clear();
+    double *beginCapture(int sampleCount, double sampleRate);
+    void    endCapture(int samplesCaptured);
+
+    int     getSampleCount()   { return(m_sampleCount); }
+    double  getSampleRate()    { return(m_sampleRate); }
+    double  rms();
+    double  peakFrequency();
+    double  thd(int harmonics = 5);
+
+private:
+    bool    computeSpectrum();
+    double  binFrequency(double bin);
+    double  harmonicPower(double fundamentalBin, int harmonic);
+
+private:
+    std::vector<double>                 m_samples;
+    std::vector<std::complex<double> >  m_fft;
+    std::vector<double>                 m_power;        // |X(k)|^2 for k = 0..N/2
+    int                                 m_sampleCount;
+    double                              m_sampleRate;
+    int                                 m_fftSize;
+    bool                                m_spectrumValid;
+};
+
+#endif // SIGNALANALYSIS_H
@@ -0,0 +1,490 @@
+/*!
+ * @file SleepTuner.cpp
+ * @brief Implements the CSleepTuner class
+ *
+ * This class runs the sleep tuning experiment on a golden board
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include <math.h>
+#include <QRegExp>
+#include "SleepTuner.h"
+
+//
+// Each probed sleep is reduced to these percentages of its scripted value
+//
+static const int s_stagePercent[] = { 75, 50, 25, 10, 0 };
+#define NUM_STAGES  ((int)(sizeof(s_stagePercent)/sizeof(s_stagePercent[0])))
+
+
+/*!
+ * @brief CSleepTuner constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSleepTuner::CSleepTuner()
+{
+    m_script = NULL;
+    m_repeats = 1;
+    m_tolerance = 0.1;
+    m_margin_pct = 25;
+    m_baselinePasses = 0;
+    m_passCount = 0;
+}
+
+
+/*!
+ * @brief CSleepTuner destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSleepTuner::~CSleepTuner()
+{
+    m_steps.clear();
+    m_baseline.clear();
+}
+
+
+/*!
+ * @brief Prepares the experiment for the specified tests
+ *
+ * @param[in] script - the loaded script
+ * @param[in] tests - numbers of the tests to run, in run order
+ * @param[in] repeats - number of passes needed to accept a baseline or a stage
+ * @param[in] tolerance - allowed shift of a value from its baseline, as a fraction of the limit span
+ * @param[in] margin_pct - safety margin added to the smallest accepted sleep
+ * @return the maximum number of passes the experiment can take
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CSleepTuner::start(CTestScript *script, const std::vector<int> &tests, int repeats, double tolerance, int margin_pct)
+{
+    m_script = script;
+    m_tests = tests;
+    m_repeats = (repeats < 1) ? 1 : repeats;
+    m_tolerance = tolerance;
+    m_margin_pct = margin_pct;
+    m_baselinePasses = m_repeats;
+    m_passCount = 0;
+    m_steps.clear();
+    m_baseline.clear();
+    m_activeProbe.clear();
+
+    int mostSteps = 0;
+    for (unsigned int t=0; t<m_tests.size(); t++)
+    {
+        int firstCommand, lastCommand;
+        if (!m_script->getTestCommandRange(m_tests[t], firstCommand, lastCommand))
+        {
+            continue;
+        }
+
+        //
+        // Walk the test backwards so we know if an expect follows each sleep
+        //
+        std::vector<sleepStep_t> testSteps;
+        bool expectFollows = false;
+        for (int i=lastCommand-1; i>=firstCommand; i--)
+        {
+            const CCommand *pCommand = m_script->getCommand(i);
+            if (pCommand->isExpect())
+            {
+                expectFollows = true;
+            }
+            else if ((pCommand->m_type == CCommand::CMD_SLEEP) && expectFollows && (pCommand->m_argInteger > 0))
+            {
+                sleepStep_t step;
+                step.m_commandIndex = i;
+                step.m_testIndex = m_tests[t];
+                step.m_originalMS = pCommand->m_argInteger;
+                step.m_lastGoodMS = pCommand->m_argInteger;
+                step.m_probeMS = pCommand->m_argInteger;
+                step.m_stage = 0;
+                step.m_passesAtStage = 0;
+                step.m_done = false;
+                testSteps.insert(testSteps.begin(), step);
+            }
+        }
+        m_steps.insert(m_steps.end(), testSteps.begin(), testSteps.end());
+        if ((int)testSteps.size() > mostSteps)
+        {
+            mostSteps = testSteps.size();
+        }
+    }
+
+    return(m_baselinePasses + mostSteps * NUM_STAGES * m_repeats);
+}
+
+
+/*!
+ * @brief Reports if every sleep has been tuned
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSleepTuner::isFinished()
+{
+    if (m_passCount < m_baselinePasses)
+    {
+        return(false);
+    }
+    for (unsigned int k=0; k<m_steps.size(); k++)
+    {
+        if (!m_steps[k].m_done)
+        {
+            return(false);
+        }
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Returns the sleep times to use for the next pass
+ *
+ * Sleeps that are done use their smallest accepted value.  The first
+ * sleep of each test that is not done is probed at its current stage.
+ *
+ * @param[out] overrides - command index -> sleep time in ms
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSleepTuner::getOverrides(std::map<int, int> &overrides)
+{
+    overrides.clear();
+    m_activeProbe.clear();
+    if (m_passCount < m_baselinePasses)
+    {
+        return;
+    }
+
+    for (unsigned int k=0; k<m_steps.size(); k++)
+    {
+        sleepStep_t *pStep = &m_steps[k];
+        if (pStep->m_done)
+        {
+            if (pStep->m_lastGoodMS != pStep->m_originalMS)
+            {
+                overrides[pStep->m_commandIndex] = pStep->m_lastGoodMS;
+            }
+            continue;
+        }
+        if (m_activeProbe.find(pStep->m_testIndex) != m_activeProbe.end())
+        {
+            continue;
+        }
+        pStep->m_probeMS = pStep->m_originalMS * s_stagePercent[pStep->m_stage] / 100;
+        overrides[pStep->m_commandIndex] = pStep->m_probeMS;
+        m_activeProbe[pStep->m_testIndex] = k;
+    }
+}
+
+
+/*!
+ * @brief Checks the expects of a test against the baseline
+ *
+ * @return true if every expect of the test ran, passed and did not shift
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSleepTuner::testBehaved(int testIndex, const std::vector<CTestScript::measurement_t> &measurements)
+{
+    std::map<int, baseline_t>::iterator it;
+    for (it = m_baseline.begin(); it != m_baseline.end(); ++it)
+    {
+        baseline_t *pBaseline = &it->second;
+        if (pBaseline->m_testIndex != testIndex)
+        {
+            continue;
+        }
+
+        const CTestScript::measurement_t *pMeasurement = NULL;
+        for (unsigned int m=0; m<measurements.size(); m++)
+        {
+            if (measurements[m].m_commandIndex == it->first)
+            {
+                pMeasurement = &measurements[m];
+            }
+        }
+        if ((pMeasurement == NULL) || !pMeasurement->m_passed)
+        {
+            return(false);
+        }
+        if (pBaseline->m_numeric && pMeasurement->m_valueValid && (pBaseline->m_count > 0))
+        {
+            double mean = pBaseline->m_sum / pBaseline->m_count;
+            double allowed = m_tolerance * (pBaseline->m_max - pBaseline->m_min);
+            if (fabs(pMeasurement->m_value - mean) > allowed)
+            {
+                return(false);
+            }
+        }
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Records the expect results of a completed pass
+ *
+ * @param[in] measurements - the expect results of the pass
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSleepTuner::recordPass(const std::vector<CTestScript::measurement_t> &measurements)
+{
+    //
+    // Baseline passes
+    //
+    if (m_passCount < m_baselinePasses)
+    {
+        for (unsigned int m=0; m<measurements.size(); m++)
+        {
+            const CTestScript::measurement_t *pMeasurement = &measurements[m];
+            std::map<int, baseline_t>::iterator it = m_baseline.find(pMeasurement->m_commandIndex);
+            if (it == m_baseline.end())
+            {
+                const CCommand *pCommand = m_script->getCommand(pMeasurement->m_commandIndex);
+                baseline_t baseline;
+                baseline.m_testIndex = pMeasurement->m_testIndex;
+                baseline.m_sum = 0.0;
+                baseline.m_count = 0;
+                baseline.m_min = pCommand->m_argMin;
+                baseline.m_max = pCommand->m_argMax;
+                baseline.m_numeric = (  (pCommand->m_type == CCommand::CMD_EXPECT)
+                                     || (pCommand->m_type == CCommand::CMD_EXPECT_AVG)
+                                     || (pCommand->m_type == CCommand::CMD_EXPECT_STATS) );
+                baseline.m_failed = false;
+                it = m_baseline.insert(std::make_pair(pMeasurement->m_commandIndex, baseline)).first;
+            }
+            if (!pMeasurement->m_passed)
+            {
+                it->second.m_failed = true;
+            }
+            else if (pMeasurement->m_valueValid)
+            {
+                it->second.m_sum += pMeasurement->m_value;
+                it->second.m_count++;
+            }
+        }
+
+        m_passCount++;
+
+        //
+        // The sleeps of a test that fails on the golden board can not be tuned
+        //
+        if (m_passCount == m_baselinePasses)
+        {
+            std::map<int, baseline_t>::iterator it;
+            for (it = m_baseline.begin(); it != m_baseline.end(); ++it)
+            {
+                if (!it->second.m_failed)
+                    continue;
+                for (unsigned int k=0; k<m_steps.size(); k++)
+                {
+                    if (m_steps[k].m_testIndex == it->second.m_testIndex)
+                    {
+                        m_steps[k].m_done = true;
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    //
+    // Tuning passes
+    //
+    std::map<int, int>::iterator it;
+    for (it = m_activeProbe.begin(); it != m_activeProbe.end(); ++it)
+    {
+        sleepStep_t *pStep = &m_steps[it->second];
+        if (!testBehaved(it->first, measurements))
+        {
+            pStep->m_done = true;
+            continue;
+        }
+
+        pStep->m_passesAtStage++;
+        if (pStep->m_passesAtStage >= m_repeats)
+        {
+            pStep->m_lastGoodMS = pStep->m_probeMS;
+            pStep->m_passesAtStage = 0;
+            pStep->m_stage++;
+            if (pStep->m_stage >= NUM_STAGES)
+            {
+                pStep->m_done = true;
+            }
+        }
+    }
+    m_passCount++;
+}
+
+
+/*!
+ * @brief Returns the recommended time of a sleep
+ *
+ * The smallest accepted time plus the safety margin, rounded up
+ * to 10 ms and never more than the scripted time.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CSleepTuner::recommendedMS(const sleepStep_t &step)
+{
+    if (step.m_lastGoodMS >= step.m_originalMS)
+    {
+        return(step.m_originalMS);
+    }
+
+    int ms = step.m_lastGoodMS * (100 + m_margin_pct) / 100;
+    ms = ((ms + 9) / 10) * 10;
+    if (ms > step.m_originalMS)
+    {
+        ms = step.m_originalMS;
+    }
+    return(ms);
+}
+
+
+/*!
+ * @brief Writes a copy of the script with the tuned sleep times
+ *
+ * Only the number of a tuned sleep line is changed and a comment
+ * with the original time is added.  All other lines are copied as is.
+ *
+ * @param[in] sourceFile - the script that was tuned
+ * @param[in] destFile - name of the patched copy
+ * @return true if successful, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSleepTuner::writeTunedScript(const QString &sourceFile, const QString &destFile)
+{
+    std::map<int, int> tunedLines;
+    for (unsigned int k=0; k<m_steps.size(); k++)
+    {
+        if (m_steps[k].m_done)
+        {
+            tunedLines[m_steps[k].m_commandIndex] = k;
+        }
+    }
+
+    FILE *in = fopen(sourceFile.toLocal8Bit().data(), "r");
+    if (in == NULL)
+    {
+        return(false);
+    }
+    FILE *out = fopen(destFile.toLocal8Bit().data(), "w");
+    if (out == NULL)
+    {
+        fclose(in);
+        return(false);
+    }
+
+    //
+    // Lines are counted the same way as when the script is read
+    //
+    QRegExp sleepPattern("^(\\s*sleep\\s+)(\\d+)");
+    int i = 0;
+    while (!feof(in))
+    {
+        char lineBuffer[1024];
+        if (fgets(lineBuffer, sizeof(lineBuffer), in))
+        {
+            QString line = lineBuffer;
+            std::map<int, int>::iterator it = tunedLines.find(i);
+            if ((it != tunedLines.end()) && (sleepPattern.indexIn(line) == 0))
+            {
+                sleepStep_t *pStep = &m_steps[it->second];
+                int ms = recommendedMS(*pStep);
+                if (ms < pStep->m_originalMS)
+                {
+                    QString replacement = "%1   # tuned from %2";
+                    replacement = replacement.arg(ms).arg(pStep->m_originalMS);
+                    line.replace(sleepPattern.pos(2), sleepPattern.cap(2).length(), replacement);
+                }
+            }
+            fputs(line.toLocal8Bit().data(), out);
+            i++;
+        }
+    }
+
+    fclose(in);
+    fclose(out);
+    return(true);
+}
+
+
+/*!
+ * @brief Formats the results of the experiment as lines of text
+ *
+ * @param[out] lines - lines of the report are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSleepTuner::getReport(std::vector<QString> &lines)
+{
+    char msg[500];
+    sprintf(msg, "Sleep tuning: %d passes, repeats=%d, tolerance=%0.0lf%% of limits, margin=%d%%",
+            m_passCount, m_repeats, m_tolerance*100.0, m_margin_pct);
+    lines.push_back(msg);
+    lines.push_back("    Line  Scripted  Recommended  Status       Test");
+
+    int savedMS = 0;
+    for (unsigned int k=0; k<m_steps.size(); k++)
+    {
+        sleepStep_t *pStep = &m_steps[k];
+        int ms = recommendedMS(*pStep);
+
+        bool baselineFailed = false;
+        std::map<int, baseline_t>::iterator it;
+        for (it = m_baseline.begin(); it != m_baseline.end(); ++it)
+        {
+            if ((it->second.m_testIndex == pStep->m_testIndex) && it->second.m_failed)
+            {
+                baselineFailed = true;
+            }
+        }
+
+        const char *status = "tuned";
+        if (baselineFailed)
+            status = "not tuned (failed on golden board)";
+        else if (!pStep->m_done)
+            status = "incomplete";
+        else if (ms >= pStep->m_originalMS)
+            status = "required";
+
+        if (pStep->m_done && !baselineFailed)
+        {
+            savedMS += pStep->m_originalMS - ms;
+        }
+
+        QString *pName = m_script->getTestName(pStep->m_testIndex);
+        sprintf(msg, "%8d  %8d  %11d  %-11s  %s",
+                pStep->m_commandIndex+1, pStep->m_originalMS, ms, status,
+                (pName != NULL) ? pName->toLocal8Bit().data() : "");
+        lines.push_back(msg);
+    }
+
+    sprintf(msg, "Sleep time saved per run: %0.3lf s", savedMS/1000.0);
+    lines.push_back(msg);
+}
@@ -0,0 +1,94 @@
+/*!
+ * @file SleepTuner.h
+ * @brief Declares the CSleepTuner class
+ *
+ * This class runs the sleep tuning experiment on a golden board
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef SLEEPTUNER_H
+#define SLEEPTUNER_H
+
+#include <map>
+#include <vector>
+#include <QString>
+#include "TestScript.h"
+
+/*!
+ * @brief This class finds the minimum needed time of each scripted sleep
+ *
+ * The experiment is made of passes, each pass being one run of the selected
+ * tests.  The first passes use the scripted sleeps and record the baseline
+ * of every expect.  After that, each test probes one of its sleeps at a time,
+ * shrinking it by stages.  A stage is accepted when every expect of the test
+ * passes and stays within the tolerance of its baseline for the required
+ * number of passes.  The first stage that fails ends the probe of that sleep.
+ *
+ * Only sleeps that are followed by an expect in the same test are tuned.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CSleepTuner
+{
+public:
+    CSleepTuner();
+    ~CSleepTuner();
+
+    int  start(CTestScript *script, const std::vector<int> &tests, int repeats, double tolerance, int margin_pct);
+    bool isFinished();
+    void getOverrides(std::map<int, int> &overrides);
+    void recordPass(const std::vector<CTestScript::measurement_t> &measurements);
+    bool writeTunedScript(const QString &sourceFile, const QString &destFile);
+    void getReport(std::vector<QString> &lines);
+
+private:
+    struct sleepStep_t
+    {
+        int   m_commandIndex;
+        int   m_testIndex;
+        int   m_originalMS;
+        int   m_lastGoodMS;     // smallest value that has been accepted
+        int   m_probeMS;        // value used by the current pass
+        int   m_stage;
+        int   m_passesAtStage;
+        bool  m_done;
+    };
+
+    struct baseline_t
+    {
+        int     m_testIndex;
+        double  m_sum;
+        int     m_count;
+        double  m_min;          // limits of the expect
+        double  m_max;
+        bool    m_numeric;
+        bool    m_failed;       // the golden board failed during the baseline
+    };
+
+    int  recommendedMS(const sleepStep_t &step);
+    bool testBehaved(int testIndex, const std::vector<CTestScript::measurement_t> &measurements);
+
+private:
+    CTestScript                 *m_script;
+    std::vector<int>             m_tests;
+    std::vector<sleepStep_t>     m_steps;
+    std::map<int, baseline_t>    m_baseline;       // expect command index -> baseline
+    std::map<int, int>           m_activeProbe;    // test index -> index into m_steps
+    int                          m_repeats;
+    double                       m_tolerance;      // allowed shift as a fraction of the limit span
+    int                          m_margin_pct;
+    int                          m_baselinePasses;
+    int                          m_passCount;
+};
+
+#endif // SLEEPTUNER_H
@@ -0,0 +1,500 @@
+/*!
+ * @file SpcHistory.cpp
+ * @brief Implements the CSpcHistory class
+ *
+ * This class keeps the statistical process control summary of each expect
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <math.h>
+#include <algorithm>
+#include <QSettings>
+#include "SpcHistory.h"
+
+#define RECENT_VALUES  8     // enough for the longest Western Electric rule
+
+static const char *g_ruleNames[] =
+{
+    "",
+    "1 value beyond 3 sigma",
+    "2 of 3 values beyond 2 sigma",
+    "4 of 5 values beyond 1 sigma",
+    "8 values on one side of the center line"
+};
+
+
+/*!
+ * @brief CSpcHistory constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSpcHistory::CSpcHistory()
+{
+    m_history.clear();
+    m_filename.clear();
+    m_modified = false;
+    m_baselineCount = 25;
+    m_shiftStarts.clear();
+    m_shiftStarts.push_back(QTime(0, 0));
+}
+
+
+/*!
+ * @brief CSpcHistory destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CSpcHistory::~CSpcHistory()
+{
+    m_history.clear();
+    m_shiftSummaries.clear();
+}
+
+
+/*!
+ * @brief Builds the key used to store the statistics of an expect
+ *
+ * The "/" and "\" characters are used by QSettings to separate
+ * groups so they are replaced in the names.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CSpcHistory::makeKey(const QString &scriptVersion, const QString &testName, int lineNumber)
+{
+    QString version = scriptVersion;
+    version.replace('/', '_');
+    version.replace('\\', '_');
+    QString test = testName;
+    test.replace('/', '_');
+    test.replace('\\', '_');
+
+    QString key = "%1/L%2_%3";
+    return(key.arg(version.trimmed()).arg(lineNumber+1).arg(test.trimmed()));
+}
+
+
+/*!
+ * @brief Sets the times of day at which the shifts start
+ *
+ * @param[in] starts - the start times as "HH:mm", invalid times are ignored
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSpcHistory::setShiftStarts(const QStringList &starts)
+{
+    m_shiftStarts.clear();
+    for (int i=0; i<starts.size(); i++)
+    {
+        QTime start = QTime::fromString(starts[i].trimmed(), "HH:mm");
+        if (start.isValid())
+        {
+            m_shiftStarts.push_back(start);
+        }
+    }
+    if (m_shiftStarts.empty())
+    {
+        m_shiftStarts.push_back(QTime(0, 0));
+    }
+    std::sort(m_shiftStarts.begin(), m_shiftStarts.end());
+}
+
+
+/*!
+ * @brief Returns the name of the shift a time falls in
+ *
+ * Times before the first start of the day belong to the last shift of
+ * the day before.
+ *
+ * @param[in] time - the time
+ * @return the date the shift started and its number, e.g. "10/19/2026 shift 2"
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CSpcHistory::getShiftId(const QDateTime &time)
+{
+    QDate date = time.date();
+    int shift = -1;
+    for (unsigned int k=0; k<m_shiftStarts.size(); k++)
+    {
+        if (time.time() >= m_shiftStarts[k])
+        {
+            shift = k;
+        }
+    }
+    if (shift < 0)
+    {
+        date = date.addDays(-1);
+        shift = m_shiftStarts.size() - 1;
+    }
+
+    QString id = "%1 shift %2";
+    return(id.arg(date.toString("MM/dd/yyyy")).arg(shift+1));
+}
+
+
+/*!
+ * @brief Reads the history from the specified ini file
+ *
+ * @param[in] filename - name of the history file
+ * @return true if the file was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSpcHistory::load(const QString &filename)
+{
+    m_history.clear();
+    m_shiftSummaries.clear();
+    m_filename = filename;
+    m_modified = false;
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError)
+    {
+        return(false);
+    }
+
+    QStringList keys = settings.allKeys();
+    for (int i=0; i<keys.size(); i++)
+    {
+        if (!keys[i].endsWith("/Total"))
+        {
+            continue;
+        }
+        QString key = keys[i].left(keys[i].length() - 6);
+        settings.beginGroup(key);
+        spc_t spc;
+        spc.m_scriptVersion = settings.value("Version", "").toString();
+        spc.m_testName = settings.value("Test", "").toString();
+        spc.m_line = settings.value("Line", 0).toInt();
+        spc.m_lsl = settings.value("LSL", 0.0).toDouble();
+        spc.m_usl = settings.value("USL", 0.0).toDouble();
+        spc.m_total.fromString(settings.value("Total", "").toString());
+        spc.m_totalAlarms = settings.value("TotalAlarms", 0).toInt();
+        spc.m_baseline.fromString(settings.value("Baseline", "").toString());
+        spc.m_shiftId = settings.value("ShiftId", "").toString();
+        spc.m_shift.fromString(settings.value("Shift", "").toString());
+        spc.m_shiftAlarms = settings.value("ShiftAlarms", 0).toInt();
+        QStringList recent = settings.value("Recent", "").toString().split(',', QString::SkipEmptyParts);
+        for (int k=0; k<recent.size(); k++)
+        {
+            spc.m_recent.push_back(recent[k].toDouble());
+        }
+        settings.endGroup();
+        m_history[key] = spc;
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Writes the history to the file it was loaded from
+ *
+ * @return true if successful (or there was nothing to write), false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CSpcHistory::save()
+{
+    if (!m_modified || m_filename.isEmpty())
+    {
+        return(true);
+    }
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    settings.clear();
+    std::map<QString, spc_t>::iterator it;
+    for (it = m_history.begin(); it != m_history.end(); ++it)
+    {
+        const spc_t &spc = it->second;
+        QStringList recent;
+        for (unsigned int k=0; k<spc.m_recent.size(); k++)
+        {
+            recent.append(QString::number(spc.m_recent[k], 'g', 17));
+        }
+        settings.beginGroup(it->first);
+        settings.setValue("Version", spc.m_scriptVersion);
+        settings.setValue("Test", spc.m_testName);
+        settings.setValue("Line", spc.m_line);
+        settings.setValue("LSL", spc.m_lsl);
+        settings.setValue("USL", spc.m_usl);
+        settings.setValue("Total", spc.m_total.toString());
+        settings.setValue("TotalAlarms", spc.m_totalAlarms);
+        settings.setValue("Baseline", spc.m_baseline.toString());
+        settings.setValue("ShiftId", spc.m_shiftId);
+        settings.setValue("Shift", spc.m_shift.toString());
+        settings.setValue("ShiftAlarms", spc.m_shiftAlarms);
+        settings.setValue("Recent", recent.join(","));
+        settings.endGroup();
+    }
+    settings.sync();
+    m_modified = false;
+
+    return(settings.status() == QSettings::NoError);
+}
+
+
+/*!
+ * @brief Adds the value of an expect and checks it against the control chart
+ *
+ * @param[in] scriptVersion - version of the script
+ * @param[in] testName - name of the test containing the expect
+ * @param[in] lineNumber - line number of the expect
+ * @param[in] lsl - lower limit of the expect
+ * @param[in] usl - upper limit of the expect
+ * @param[in] value - the value read
+ * @param[in] time - when the value was read
+ * @return a description of the rule the value broke, empty if none
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CSpcHistory::addValue(const QString &scriptVersion, const QString &testName, int lineNumber,
+                              double lsl, double usl, double value, const QDateTime &time)
+{
+    QString key = makeKey(scriptVersion, testName, lineNumber);
+    bool found = (m_history.find(key) != m_history.end());
+    spc_t &spc = m_history[key];
+    if (!found)
+    {
+        spc.m_totalAlarms = 0;
+        spc.m_shiftAlarms = 0;
+    }
+    spc.m_scriptVersion = scriptVersion;
+    spc.m_testName = testName;
+    spc.m_line = lineNumber;
+    spc.m_lsl = lsl;
+    spc.m_usl = usl;
+    m_modified = true;
+
+    //
+    // Hand out the summary of the shift that ended
+    //
+    QString shiftId = getShiftId(time);
+    if (spc.m_shiftId != shiftId)
+    {
+        if (spc.m_shift.count() > 0)
+        {
+            m_shiftSummaries.push_back(spc.m_shiftId + "  " + formatStats(spc, spc.m_shift, spc.m_shiftAlarms));
+        }
+        spc.m_shiftId = shiftId;
+        spc.m_shift.clear();
+        spc.m_shiftAlarms = 0;
+    }
+
+    spc.m_total.add(value);
+    spc.m_shift.add(value);
+    spc.m_recent.push_back(value);
+    if (spc.m_recent.size() > RECENT_VALUES)
+    {
+        spc.m_recent.erase(spc.m_recent.begin());
+    }
+
+    //
+    // The first values of the key make the baseline of its control chart
+    //
+    if (spc.m_baseline.count() == 0)
+    {
+        if (spc.m_total.count() >= m_baselineCount)
+        {
+            spc.m_baseline = spc.m_total;
+        }
+        return(QString());
+    }
+
+    int rule = checkRules(spc);
+    if (rule == 0)
+    {
+        return(QString());
+    }
+    spc.m_totalAlarms++;
+    spc.m_shiftAlarms++;
+
+    QString alarm = "SPC: %1 line %2: value %3 broke rule %4 (%5), center %6, sigma %7";
+    return(alarm.arg(testName).arg(lineNumber+1).arg(value, 0, 'g', 6).arg(rule).arg(g_ruleNames[rule])
+                .arg(spc.m_baseline.mean(), 0, 'g', 6).arg(spc.m_baseline.stdDev(), 0, 'g', 6));
+}
+
+
+/*!
+ * @brief Checks the recent values of an expect against the Western Electric rules
+ *
+ * Only the patterns that the newest value completes are reported so that
+ * one excursion does not raise an alarm for every value after it.
+ *
+ * @param[in] spc - the statistics of the expect
+ * @return the number of the first rule broken, 0 if none
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CSpcHistory::checkRules(const spc_t &spc)
+{
+    double center = spc.m_baseline.mean();
+    double sigma = spc.m_baseline.stdDev();
+    int n = spc.m_recent.size();
+    if ((sigma <= 0.0) || (n == 0))
+    {
+        return(0);
+    }
+
+    std::vector<double> z(n);
+    for (int k=0; k<n; k++)
+    {
+        z[k] = (spc.m_recent[k] - center) / sigma;
+    }
+    double last = z[n-1];
+    double side = (last >= 0.0) ? 1.0 : -1.0;
+
+    // rule 1
+    if (fabs(last) > 3.0)
+    {
+        return(1);
+    }
+
+    // rules 2 and 3, the newest value must be one of the values beyond the limit
+    static const int window[] = { 0, 0, 3, 5 };
+    static const int needed[] = { 0, 0, 2, 4 };
+    static const double limit[] = { 0.0, 0.0, 2.0, 1.0 };
+    for (int rule=2; rule<=3; rule++)
+    {
+        if ((n < window[rule]) || (side*last <= limit[rule]))
+        {
+            continue;
+        }
+        int count = 0;
+        for (int k=n-window[rule]; k<n; k++)
+        {
+            if (side*z[k] > limit[rule])
+            {
+                count++;
+            }
+        }
+        if (count >= needed[rule])
+        {
+            return(rule);
+        }
+    }
+
+    // rule 4
+    if ((n >= 8) && (last != 0.0))
+    {
+        int count = 0;
+        for (int k=n-8; k<n; k++)
+        {
+            if (side*z[k] > 0.0)
+            {
+                count++;
+            }
+        }
+        if (count == 8)
+        {
+            return(4);
+        }
+    }
+    return(0);
+}
+
+
+/*!
+ * @brief Formats the statistics of an expect as one line
+ *
+ * The Cpk is shown as "-" when there are fewer than two values or all of
+ * the values are the same.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CSpcHistory::formatStats(const spc_t &spc, const CRunningStats &stats, int alarms)
+{
+    QString cpk = "-";
+    double sd = stats.stdDev();
+    if ((stats.count() >= 2) && (sd > 0.0))
+    {
+        double value = std::min(spc.m_usl - stats.mean(), stats.mean() - spc.m_lsl) / (3.0*sd);
+        cpk = QString::number(value, 'f', 2);
+    }
+
+    QString line = "%1  %2 line %3: n=%4  mean=%5  sd=%6  min=%7  max=%8  Cpk=%9  alarms=%10";
+    return(line.arg(spc.m_scriptVersion).arg(spc.m_testName).arg(spc.m_line+1).arg(stats.count())
+               .arg(stats.mean(), 0, 'g', 6).arg(sd, 0, 'g', 4).arg(stats.minimum(), 0, 'g', 6)
+               .arg(stats.maximum(), 0, 'g', 6).arg(cpk).arg(alarms));
+}
+
+
+/*!
+ * @brief Formats the statistics of every expect, overall and for the current shift
+ *
+ * @param[out] lines - lines of the summary are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSpcHistory::getSummary(std::vector<QString> &lines)
+{
+    std::map<QString, spc_t>::iterator it;
+    for (it = m_history.begin(); it != m_history.end(); ++it)
+    {
+        const spc_t &spc = it->second;
+        lines.push_back(formatStats(spc, spc.m_total, spc.m_totalAlarms));
+        if (spc.m_shift.count() > 0)
+        {
+            QString line = "        %1: n=%2  mean=%3  alarms=%4";
+            lines.push_back(line.arg(spc.m_shiftId).arg(spc.m_shift.count())
+                                .arg(spc.m_shift.mean(), 0, 'g', 6).arg(spc.m_shiftAlarms));
+        }
+    }
+}
+
+
+/*!
+ * @brief Returns the summaries of the shifts that ended since the last call
+ *
+ * @param[out] lines - the summaries are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSpcHistory::takeShiftSummaries(std::vector<QString> &lines)
+{
+    lines.insert(lines.end(), m_shiftSummaries.begin(), m_shiftSummaries.end());
+    m_shiftSummaries.clear();
+}
+
+
+/*!
+ * @brief Forgets the baselines so that the next values make new ones
+ *
+ * This is used after a deliberate change to the process (e.g. a new
+ * fixture) so that the old center lines do not raise alarms.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CSpcHistory::resetBaselines()
+{
+    std::map<QString, spc_t>::iterator it;
+    for (it = m_history.begin(); it != m_history.end(); ++it)
+    {
+        it->second.m_total.clear();
+        it->second.m_totalAlarms = 0;
+        it->second.m_baseline.clear();
+        it->second.m_recent.clear();
+    }
+    m_modified = true;
+}
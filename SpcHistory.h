@@ -0,0 +1,98 @@
+/*!
+ * @file SpcHistory.h
+ * @brief Declares the CSpcHistory class
+ *
+ * This class keeps the statistical process control summary of each expect
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef SPCHISTORY_H
+#define SPCHISTORY_H
+
+#include <map>
+#include <vector>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QTime>
+#include "RunningStats.h"
+
+/*!
+ * @brief This class holds the running statistics of the values of each expect
+ *
+ * The values of an expect are keyed by script version, test and line.  For
+ * each key the count, mean, variance, min and max are kept since the key was
+ * first seen and for the current shift, and the Cpk is computed against the
+ * limits of the expect.
+ *
+ * Once a key has BaselineCount values its statistics are frozen as the
+ * baseline (center line and sigma) of its control chart.  Each new value is
+ * then checked against the Western Electric rules:
+ *   1 - one value beyond 3 sigma
+ *   2 - two of three values beyond 2 sigma on the same side
+ *   3 - four of five values beyond 1 sigma on the same side
+ *   4 - eight values in a row on the same side of the center line
+ *
+ * The summary of a shift is handed out (see takeShiftSummaries) with the
+ * first value of the key in the next shift.  The history is stored in a
+ * local ini file so that it survives between runs.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CSpcHistory
+{
+public:
+    CSpcHistory();
+    ~CSpcHistory();
+
+    bool    load(const QString &filename);
+    bool    save();
+    void    setBaselineCount(int count) { m_baselineCount = count; }
+    void    setShiftStarts(const QStringList &starts);
+    QString addValue(const QString &scriptVersion, const QString &testName, int lineNumber,
+                     double lsl, double usl, double value, const QDateTime &time);
+    void    getSummary(std::vector<QString> &lines);
+    void    takeShiftSummaries(std::vector<QString> &lines);
+    void    resetBaselines();
+    QString getShiftId(const QDateTime &time);
+
+private:
+    struct spc_t
+    {
+        QString              m_scriptVersion;
+        QString              m_testName;
+        int                  m_line;
+        double               m_lsl;
+        double               m_usl;
+        CRunningStats        m_total;       // since the key was first seen
+        int                  m_totalAlarms;
+        CRunningStats        m_baseline;    // frozen after m_baselineCount values
+        QString              m_shiftId;
+        CRunningStats        m_shift;       // current shift
+        int                  m_shiftAlarms;
+        std::vector<double>  m_recent;      // last values, oldest first
+    };
+    QString makeKey(const QString &scriptVersion, const QString &testName, int lineNumber);
+    int     checkRules(const spc_t &spc);
+    QString formatStats(const spc_t &spc, const CRunningStats &stats, int alarms);
+
+private:
+    std::map<QString, spc_t>  m_history;
+    QString                   m_filename;
+    bool                      m_modified;
+    int                       m_baselineCount;
+    std::vector<QTime>        m_shiftStarts;      // sorted
+    std::vector<QString>      m_shiftSummaries;   // summaries of the shifts that ended
+};
+
+#endif // SPCHISTORY_H
@@ -0,0 +1,375 @@
+/*!
+ * @file StationMetrics.cpp
+ * @brief Implements the CStationMetrics class
+ *
+ * This class counts the throughput and latency of the station
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QMutexLocker>
+#include "StationMetrics.h"
+
+CStationMetrics *CStationMetrics::m_instance = 0;
+
+static const double g_cycleTimeBounds[] = { 30, 60, 120, 180, 300, 450, 600, 900, 1200, 1800 };
+static const double g_testDurationBounds[] = { 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120 };
+static const double g_databaseBounds[] = { 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5 };
+
+#define BOUND_COUNT(bounds)  ((int)(sizeof(bounds)/sizeof(bounds[0])))
+
+
+/*!
+ * @brief CStationMetrics constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CStationMetrics::CStationMetrics()
+{
+    m_started = 0;
+    m_passed = 0;
+    m_failed = 0;
+    m_aborted = 0;
+    m_spoolDepth = 0;
+    initHistogram(m_cycleTime, g_cycleTimeBounds, BOUND_COUNT(g_cycleTimeBounds));
+    initHistogram(m_databaseLatency, g_databaseBounds, BOUND_COUNT(g_databaseBounds));
+}
+
+
+/*!
+ * @brief Returns the pointer to the class object
+ *
+ * The first time this is called the class is instantiated.
+ * There after, a pointer to the instantiated object is returned.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CStationMetrics *CStationMetrics::Instance()
+{
+    if (m_instance == 0)
+        m_instance = new CStationMetrics();
+    return(m_instance);
+}
+
+
+/*!
+ * @brief Sets up an empty histogram
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::initHistogram(histogram_t &histogram, const double *bounds, int count)
+{
+    histogram.m_bounds.assign(bounds, bounds+count);
+    histogram.m_counts.assign(count+1, 0);
+    histogram.m_sum = 0.0;
+    histogram.m_count = 0;
+}
+
+
+/*!
+ * @brief Adds a value to a histogram
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::observe(histogram_t &histogram, double value)
+{
+    unsigned int k = 0;
+    while ((k < histogram.m_bounds.size()) && (value > histogram.m_bounds[k]))
+    {
+        k++;
+    }
+    histogram.m_counts[k]++;
+    histogram.m_sum += value;
+    histogram.m_count++;
+}
+
+
+/*!
+ * @brief Returns the counters of a port, creating them the first time
+ *
+ * The caller holds the mutex.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CStationMetrics::port_t &CStationMetrics::getPort(const QString &port)
+{
+    std::map<QString, port_t>::iterator it = m_ports.find(port);
+    if (it == m_ports.end())
+    {
+        port_t counters;
+        counters.m_bytesIn = 0;
+        counters.m_bytesOut = 0;
+        counters.m_timeouts = 0;
+        counters.m_retries = 0;
+        it = m_ports.insert(std::make_pair(port, counters)).first;
+    }
+    return(it->second);
+}
+
+
+/*!
+ * @brief Counts a unit whose tests were started
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::unitStarted()
+{
+    QMutexLocker lock(&m_mutex);
+    m_started++;
+}
+
+
+/*!
+ * @brief Counts a unit whose run ended
+ *
+ * @param[in] result - how the run ended
+ * @param[in] cycleTime_s - time from the start of the run to the end of OnExit
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::unitFinished(result_t result, double cycleTime_s)
+{
+    QMutexLocker lock(&m_mutex);
+    switch (result)
+    {
+        case UNIT_PASSED:  m_passed++;  break;
+        case UNIT_FAILED:  m_failed++;  break;
+        case UNIT_ABORTED: m_aborted++; break;
+    }
+    observe(m_cycleTime, cycleTime_s);
+}
+
+
+/*!
+ * @brief Adds the duration of a test
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::testFinished(const QString &testName, double duration_s)
+{
+    QMutexLocker lock(&m_mutex);
+    std::map<QString, histogram_t>::iterator it = m_testDuration.find(testName);
+    if (it == m_testDuration.end())
+    {
+        histogram_t histogram;
+        initHistogram(histogram, g_testDurationBounds, BOUND_COUNT(g_testDurationBounds));
+        it = m_testDuration.insert(std::make_pair(testName, histogram)).first;
+    }
+    observe(it->second, duration_s);
+}
+
+
+/*!
+ * @brief Counts bytes received on a serial port
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::bytesIn(const QString &port, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    QMutexLocker lock(&m_mutex);
+    getPort(port).m_bytesIn += count;
+}
+
+
+/*!
+ * @brief Counts bytes sent on a serial port
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::bytesOut(const QString &port, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    QMutexLocker lock(&m_mutex);
+    getPort(port).m_bytesOut += count;
+}
+
+
+/*!
+ * @brief Counts a read of a serial port that timed out
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::readTimeout(const QString &port)
+{
+    QMutexLocker lock(&m_mutex);
+    getPort(port).m_timeouts++;
+}
+
+
+/*!
+ * @brief Counts the group retries of a run on a serial port
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::retries(const QString &port, int count)
+{
+    QMutexLocker lock(&m_mutex);
+    getPort(port).m_retries += count;
+}
+
+
+/*!
+ * @brief Adds the time taken by a serial number lookup in the database
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::databaseLookup(double latency_s)
+{
+    QMutexLocker lock(&m_mutex);
+    observe(m_databaseLatency, latency_s);
+}
+
+
+/*!
+ * @brief Sets the number of reports waiting to be copied to the report directory
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::setSpoolDepth(int depth)
+{
+    QMutexLocker lock(&m_mutex);
+    m_spoolDepth = depth;
+}
+
+
+/*!
+ * @brief Escapes a label value for the Prometheus text format
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CStationMetrics::escapeLabel(const QString &value)
+{
+    QString escaped = value;
+    escaped.replace("\\", "\\\\");
+    escaped.replace("\"", "\\\"");
+    escaped.replace("\n", "\\n");
+    return(escaped);
+}
+
+
+/*!
+ * @brief Appends the lines of a histogram
+ *
+ * @param[in,out] text - the text to append to
+ * @param[in] name - name of the metric
+ * @param[in] labels - other labels of the histogram, e.g. test="Power", empty if none
+ * @param[in] histogram - the histogram
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CStationMetrics::formatHistogram(QByteArray &text, const char *name, const QString &labels, const histogram_t &histogram)
+{
+    QString prefix = labels.isEmpty() ? QString() : labels + ",";
+    quint64 cumulative = 0;
+    for (unsigned int k=0; k<=histogram.m_bounds.size(); k++)
+    {
+        cumulative += histogram.m_counts[k];
+        QString le = (k < histogram.m_bounds.size()) ? QString::number(histogram.m_bounds[k]) : QString("+Inf");
+        QString line = "%1_bucket{%2le=\"%3\"} %4\n";
+        text.append(line.arg(name).arg(prefix).arg(le).arg(cumulative).toUtf8());
+    }
+    QString braces = labels.isEmpty() ? QString() : "{" + labels + "}";
+    QString line = "%1_sum%2 %3\n%1_count%2 %4\n";
+    text.append(line.arg(name).arg(braces).arg(histogram.m_sum, 0, 'g', 10).arg(histogram.m_count).toUtf8());
+}
+
+
+/*!
+ * @brief Formats the metrics in the Prometheus text format (version 0.0.4)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QByteArray CStationMetrics::formatText()
+{
+    QMutexLocker lock(&m_mutex);
+    QByteArray text;
+    QString line;
+
+    text.append("# HELP vapotherm_units_total Units tested, by result.\n");
+    text.append("# TYPE vapotherm_units_total counter\n");
+    line = "vapotherm_units_total{result=\"started\"} %1\n"
+           "vapotherm_units_total{result=\"passed\"} %2\n"
+           "vapotherm_units_total{result=\"failed\"} %3\n"
+           "vapotherm_units_total{result=\"aborted\"} %4\n";
+    text.append(line.arg(m_started).arg(m_passed).arg(m_failed).arg(m_aborted).toUtf8());
+
+    text.append("# HELP vapotherm_cycle_time_seconds Time to test a unit.\n");
+    text.append("# TYPE vapotherm_cycle_time_seconds histogram\n");
+    formatHistogram(text, "vapotherm_cycle_time_seconds", "", m_cycleTime);
+
+    text.append("# HELP vapotherm_test_duration_seconds Time to run a test.\n");
+    text.append("# TYPE vapotherm_test_duration_seconds histogram\n");
+    std::map<QString, histogram_t>::iterator test;
+    for (test = m_testDuration.begin(); test != m_testDuration.end(); ++test)
+    {
+        QString labels = "test=\"%1\"";
+        formatHistogram(text, "vapotherm_test_duration_seconds", labels.arg(escapeLabel(test->first)), test->second);
+    }
+
+    text.append("# HELP vapotherm_serial_bytes_total Bytes moved on a serial port.\n");
+    text.append("# TYPE vapotherm_serial_bytes_total counter\n");
+    std::map<QString, port_t>::iterator port;
+    for (port = m_ports.begin(); port != m_ports.end(); ++port)
+    {
+        line = "vapotherm_serial_bytes_total{port=\"%1\",direction=\"in\"} %2\n"
+               "vapotherm_serial_bytes_total{port=\"%1\",direction=\"out\"} %3\n";
+        text.append(line.arg(escapeLabel(port->first)).arg(port->second.m_bytesIn).arg(port->second.m_bytesOut).toUtf8());
+    }
+    text.append("# HELP vapotherm_serial_timeouts_total Reads of a serial port that timed out.\n");
+    text.append("# TYPE vapotherm_serial_timeouts_total counter\n");
+    for (port = m_ports.begin(); port != m_ports.end(); ++port)
+    {
+        line = "vapotherm_serial_timeouts_total{port=\"%1\"} %2\n";
+        text.append(line.arg(escapeLabel(port->first)).arg(port->second.m_timeouts).toUtf8());
+    }
+    text.append("# HELP vapotherm_serial_retries_total Command group retries on a serial port.\n");
+    text.append("# TYPE vapotherm_serial_retries_total counter\n");
+    for (port = m_ports.begin(); port != m_ports.end(); ++port)
+    {
+        line = "vapotherm_serial_retries_total{port=\"%1\"} %2\n";
+        text.append(line.arg(escapeLabel(port->first)).arg(port->second.m_retries).toUtf8());
+    }
+
+    text.append("# HELP vapotherm_db_lookup_seconds Time to validate a serial number in the database.\n");
+    text.append("# TYPE vapotherm_db_lookup_seconds histogram\n");
+    formatHistogram(text, "vapotherm_db_lookup_seconds", "", m_databaseLatency);
+
+    text.append("# HELP vapotherm_report_spool_depth Reports saved locally and waiting for the report directory.\n");
+    text.append("# TYPE vapotherm_report_spool_depth gauge\n");
+    line = "vapotherm_report_spool_depth %1\n";
+    text.append(line.arg(m_spoolDepth).toUtf8());
+
+    return(text);
+}
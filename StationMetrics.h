@@ -0,0 +1,99 @@
+/*!
+ * @file StationMetrics.h
+ * @brief Declares the CStationMetrics class
+ *
+ * This class counts the throughput and latency of the station
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef STATIONMETRICS_H
+#define STATIONMETRICS_H
+
+#include <map>
+#include <vector>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+
+/*!
+ * @brief This class holds the counters and histograms of the station
+ *
+ * The metrics are updated from the main thread and from the threads of
+ * the panel positions, so every access is made under the mutex.  They
+ * are formatted in the Prometheus text format by formatText() and served
+ * by CMetricsServer.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CStationMetrics
+{
+public:
+    enum result_t
+    {
+        UNIT_PASSED,
+        UNIT_FAILED,
+        UNIT_ABORTED
+    };
+
+    static CStationMetrics *Instance();
+
+    void unitStarted();
+    void unitFinished(result_t result, double cycleTime_s);
+    void testFinished(const QString &testName, double duration_s);
+    void bytesIn(const QString &port, int count);
+    void bytesOut(const QString &port, int count);
+    void readTimeout(const QString &port);
+    void retries(const QString &port, int count);
+    void databaseLookup(double latency_s);
+    void setSpoolDepth(int depth);
+    QByteArray formatText();
+
+private:
+    struct histogram_t
+    {
+        std::vector<double>   m_bounds;     // upper bounds of the buckets, +Inf is implied
+        std::vector<quint64>  m_counts;     // not cumulative, one more than m_bounds
+        double                m_sum;
+        quint64               m_count;
+    };
+    struct port_t
+    {
+        quint64  m_bytesIn;
+        quint64  m_bytesOut;
+        quint64  m_timeouts;
+        quint64  m_retries;
+    };
+
+    CStationMetrics();
+    static void initHistogram(histogram_t &histogram, const double *bounds, int count);
+    static void observe(histogram_t &histogram, double value);
+    static void formatHistogram(QByteArray &text, const char *name, const QString &labels, const histogram_t &histogram);
+    static QString escapeLabel(const QString &value);
+    port_t &getPort(const QString &port);
+
+private:
+    static CStationMetrics *m_instance;   //! instance of the singleton object
+
+    QMutex                         m_mutex;
+    quint64                        m_started;
+    quint64                        m_passed;
+    quint64                        m_failed;
+    quint64                        m_aborted;
+    histogram_t                    m_cycleTime;
+    std::map<QString, histogram_t> m_testDuration;    // test name -> durations
+    std::map<QString, port_t>      m_ports;           // port name -> counters
+    histogram_t                    m_databaseLatency;
+    int                            m_spoolDepth;
+};
+
+#endif // STATIONMETRICS_H
@@ -0,0 +1,233 @@
+/*!
+ * @file TestHistory.cpp
+ * @brief Implements the CTestHistory class
+ *
+ * This class keeps the pass/fail and duration history of each test
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <QSettings>
+#include <QStringList>
+#include "TestHistory.h"
+
+
+/*!
+ * @brief CTestHistory constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestHistory::CTestHistory()
+{
+    m_history.clear();
+    m_filename.clear();
+    m_modified = false;
+}
+
+
+/*!
+ * @brief CTestHistory destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestHistory::~CTestHistory()
+{
+    m_history.clear();
+}
+
+
+/*!
+ * @brief Builds the key used to store the history of a test
+ *
+ * The "/" and "\" characters are used by QSettings to separate
+ * groups so they are replaced in the names.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CTestHistory::makeKey(const QString &scriptVersion, const QString &testName)
+{
+    QString version = scriptVersion.trimmed();
+    version.replace('/', '_');
+    version.replace('\\', '_');
+    if (version.isEmpty())
+    {
+        version = "unversioned";
+    }
+    QString test = testName.trimmed();
+    test.replace('/', '_');
+    test.replace('\\', '_');
+
+    return(version + "/" + test);
+}
+
+
+/*!
+ * @brief Reads the history from the specified ini file
+ *
+ * Each key holds "runs,fails,total ms".
+ *
+ * @param[in] filename - name of the history file
+ * @return true if the file was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestHistory::load(const QString &filename)
+{
+    m_history.clear();
+    m_filename = filename;
+    m_modified = false;
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError)
+    {
+        return(false);
+    }
+
+    QStringList keys = settings.allKeys();
+    for (int i=0; i<keys.size(); i++)
+    {
+        QStringList values = settings.value(keys[i], "").toString().split(',');
+        if (values.size() < 3)
+        {
+            continue;
+        }
+        history_t *pHistory = &m_history[keys[i]];
+        pHistory->m_runs = values[0].toInt();
+        pHistory->m_fails = values[1].toInt();
+        pHistory->m_totalMS = values[2].toDouble();
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Writes the history to the file it was loaded from
+ *
+ * @return true if successful (or there was nothing to write), false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestHistory::save()
+{
+    if (!m_modified || m_filename.isEmpty())
+    {
+        return(true);
+    }
+
+    QSettings settings(m_filename, QSettings::IniFormat);
+    std::map<QString, history_t>::iterator it;
+    for (it = m_history.begin(); it != m_history.end(); ++it)
+    {
+        QString value = "%1,%2,%3";
+        settings.setValue(it->first, value.arg(it->second.m_runs).arg(it->second.m_fails).arg(it->second.m_totalMS, 0, 'f', 0));
+    }
+    settings.sync();
+    m_modified = false;
+
+    return(settings.status() == QSettings::NoError);
+}
+
+
+/*!
+ * @brief Adds the result of one run of a test to the history
+ *
+ * @param[in] scriptVersion - version of the script
+ * @param[in] testName - name of the test
+ * @param[in] failed - true if the test failed
+ * @param[in] duration_ms - run time of the test
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestHistory::addResult(const QString &scriptVersion, const QString &testName, bool failed, int duration_ms)
+{
+    QString key = makeKey(scriptVersion, testName);
+    std::map<QString, history_t>::iterator it = m_history.find(key);
+    if (it == m_history.end())
+    {
+        history_t history;
+        history.m_runs = 0;
+        history.m_fails = 0;
+        history.m_totalMS = 0.0;
+        it = m_history.insert(std::make_pair(key, history)).first;
+    }
+    it->second.m_runs++;
+    if (failed)
+    {
+        it->second.m_fails++;
+    }
+    it->second.m_totalMS += duration_ms;
+    m_modified = true;
+}
+
+
+/*!
+ * @brief Returns the number of recorded runs of a test
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestHistory::getRunCount(const QString &scriptVersion, const QString &testName)
+{
+    std::map<QString, history_t>::iterator it = m_history.find(makeKey(scriptVersion, testName));
+    if (it == m_history.end())
+    {
+        return(0);
+    }
+    return(it->second.m_runs);
+}
+
+
+/*!
+ * @brief Returns the estimated probability that a test fails
+ *
+ * The estimate is (fails + 1) / (runs + 2) so that a test with little
+ * history is neither certain to pass nor certain to fail.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+double CTestHistory::getFailureProbability(const QString &scriptVersion, const QString &testName)
+{
+    int runs = 0;
+    int fails = 0;
+    std::map<QString, history_t>::iterator it = m_history.find(makeKey(scriptVersion, testName));
+    if (it != m_history.end())
+    {
+        runs = it->second.m_runs;
+        fails = it->second.m_fails;
+    }
+    return((fails + 1.0) / (runs + 2.0));
+}
+
+
+/*!
+ * @brief Returns the mean run time of a test
+ *
+ * @param[in] default_ms - value returned if the test has no history
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestHistory::getMeanDurationMS(const QString &scriptVersion, const QString &testName, int default_ms)
+{
+    std::map<QString, history_t>::iterator it = m_history.find(makeKey(scriptVersion, testName));
+    if ((it == m_history.end()) || (it->second.m_runs == 0))
+    {
+        return(default_ms);
+    }
+    return((int) (it->second.m_totalMS / it->second.m_runs));
+}
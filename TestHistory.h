@@ -0,0 +1,60 @@
+/*!
+ * @file TestHistory.h
+ * @brief Declares the CTestHistory class
+ *
+ * This class keeps the pass/fail and duration history of each test
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef TESTHISTORY_H
+#define TESTHISTORY_H
+
+#include <map>
+#include <QString>
+
+/*!
+ * @brief This class holds run counts, fail counts and run times keyed by script version and test
+ *
+ * The history is stored in a local ini file so that it survives between runs.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CTestHistory
+{
+public:
+    CTestHistory();
+    ~CTestHistory();
+
+    bool   load(const QString &filename);
+    bool   save();
+    void   addResult(const QString &scriptVersion, const QString &testName, bool failed, int duration_ms);
+    int    getRunCount(const QString &scriptVersion, const QString &testName);
+    double getFailureProbability(const QString &scriptVersion, const QString &testName);
+    int    getMeanDurationMS(const QString &scriptVersion, const QString &testName, int default_ms);
+
+private:
+    struct history_t
+    {
+        int     m_runs;
+        int     m_fails;
+        double  m_totalMS;
+    };
+    QString makeKey(const QString &scriptVersion, const QString &testName);
+
+private:
+    std::map<QString, history_t>  m_history;
+    QString                       m_filename;
+    bool                          m_modified;
+};
+
+#endif // TESTHISTORY_H
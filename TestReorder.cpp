@@ -0,0 +1,453 @@
+/*!
+ * @file TestReorder.cpp
+ * @brief Implements the CTestReorder class
+ *
+ * This class reorders the tests of a script to reduce fixture switching time
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include "TestReorder.h"
+
+#define MAX_IMPROVEMENT_PASSES  50
+
+
+/*!
+ * @brief CTestReorder constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestReorder::CTestReorder()
+{
+    m_script = NULL;
+    m_outputDelay_ms = 0;
+    m_order.clear();
+    m_blocks.clear();
+    m_originalMS = 0;
+    m_newMS = 0;
+}
+
+
+/*!
+ * @brief CTestReorder destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestReorder::~CTestReorder()
+{
+    m_order.clear();
+    m_blocks.clear();
+}
+
+
+/*!
+ * @brief Reports if a test is part of a normal run
+ *
+ * The OnAbort and OnExit tests are not run in sequence with the others.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestReorder::isScheduled(int n)
+{
+    QString *pName = m_script->getTestName(n);
+    return((*pName != "OnAbort") && (*pName != "OnExit"));
+}
+
+
+/*!
+ * @brief Returns the switching cost of a test and updates the fixture model
+ *
+ * @param[in] n - number of the test
+ * @param[in,out] state - the fixture model before and after the test
+ * @return the cost in ms
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestReorder::testCost(int n, CFixtureState &state)
+{
+    int cost = 0;
+    int firstCommand, lastCommand;
+    m_script->getTestCommandRange(n, firstCommand, lastCommand);
+    for (int i=firstCommand; i<lastCommand; i++)
+    {
+        const CCommand *pCommand = m_script->getCommand(i);
+        if (pCommand->m_type == CCommand::CMD_UNKNOWN)
+        {
+            state.invalidate();
+            continue;
+        }
+        if (pCommand->m_type != CCommand::CMD_SENDLINE_B)
+        {
+            continue;
+        }
+
+        //
+        // Only commands whose reply is not read are skipped by the script
+        //
+        QString command = pCommand->getTransmitString();
+        if (state.isInEffect(command) && !m_script->replyIsUsed(i+1, lastCommand))
+        {
+            continue;
+        }
+
+        int settle_ms = state.getSettleMS(command);
+        if (settle_ms < 0)
+        {
+            settle_ms = 0;
+            for (int k=i+1; k<lastCommand; k++)
+            {
+                const CCommand *pNext = m_script->getCommand(k);
+                if (pNext->m_type == CCommand::CMD_SLEEP)
+                    settle_ms += pNext->m_argInteger;
+                else if (pNext->m_type != CCommand::CMD_COMMENT)
+                    break;
+            }
+        }
+        cost += command.size() * m_outputDelay_ms + settle_ms;
+        state.commandSent(command);
+    }
+    return(cost);
+}
+
+
+/*!
+ * @brief Returns the switching cost of a complete run in the given order
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestReorder::sequenceCost(const std::vector<int> &order)
+{
+    CFixtureState state = m_profile;
+    state.invalidate();
+    int cost = 0;
+    for (unsigned int k=0; k<order.size(); k++)
+    {
+        if (isScheduled(order[k]))
+        {
+            cost += testCost(order[k], state);
+        }
+    }
+    return(cost);
+}
+
+
+/*!
+ * @brief Checks that each test of a group comes after the tests it requires
+ *
+ * @param[in] order - the order to check
+ * @param[in] first - position of the first test of the group
+ * @param[in] last - one past the position of the last test of the group
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestReorder::prerequisitesMet(const std::vector<int> &order, int first, int last)
+{
+    for (int k=first; k<last; k++)
+    {
+        const std::vector<int> &prereqs = m_script->getPrerequisites(order[k]);
+        for (unsigned int p=0; p<prereqs.size(); p++)
+        {
+            for (int j=k+1; j<last; j++)
+            {
+                if (order[j] == prereqs[p])
+                {
+                    return(false);
+                }
+            }
+        }
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Orders the tests of one group
+ *
+ * @param[in] block - the group to order (positions in m_order)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReorder::orderBlock(const block_t &block)
+{
+    std::vector<int> originalOrder = m_order;
+    int originalCost = sequenceCost(m_order);
+
+    //
+    // The fixture state at the start of the group
+    //
+    CFixtureState state = m_profile;
+    state.invalidate();
+    for (int k=0; k<block.m_first; k++)
+    {
+        if (isScheduled(m_order[k]))
+        {
+            testCost(m_order[k], state);
+        }
+    }
+
+    //
+    // Greedy: repeatedly take the ready test that is cheapest from the current state
+    //
+    std::vector<int> remaining(m_order.begin()+block.m_first, m_order.begin()+block.m_last);
+    for (int k=block.m_first; k<block.m_last; k++)
+    {
+        int best = -1;
+        int bestCost = 0;
+        for (unsigned int r=0; r<remaining.size(); r++)
+        {
+            bool ready = true;
+            const std::vector<int> &prereqs = m_script->getPrerequisites(remaining[r]);
+            for (unsigned int p=0; p<prereqs.size() && ready; p++)
+            {
+                for (unsigned int j=0; j<remaining.size(); j++)
+                {
+                    if (remaining[j] == prereqs[p])
+                    {
+                        ready = false;
+                        break;
+                    }
+                }
+            }
+            if (!ready)
+            {
+                continue;
+            }
+
+            CFixtureState trial = state;
+            int cost = testCost(remaining[r], trial);
+            if ((best < 0) || (cost < bestCost))
+            {
+                best = r;
+                bestCost = cost;
+            }
+        }
+        m_order[k] = remaining[best];
+        testCost(remaining[best], state);
+        remaining.erase(remaining.begin()+best);
+    }
+
+    //
+    // Improve: move single tests while that reduces the cost of the run
+    //
+    int cost = sequenceCost(m_order);
+    for (int pass=0; pass<MAX_IMPROVEMENT_PASSES; pass++)
+    {
+        bool improved = false;
+        for (int from=block.m_first; from<block.m_last; from++)
+        {
+            for (int to=block.m_first; to<block.m_last; to++)
+            {
+                if (to == from)
+                {
+                    continue;
+                }
+                std::vector<int> trial = m_order;
+                int n = trial[from];
+                trial.erase(trial.begin()+from);
+                trial.insert(trial.begin()+to, n);
+                if (!prerequisitesMet(trial, block.m_first, block.m_last))
+                {
+                    continue;
+                }
+                int trialCost = sequenceCost(trial);
+                if (trialCost < cost)
+                {
+                    m_order = trial;
+                    cost = trialCost;
+                    improved = true;
+                }
+            }
+        }
+        if (!improved)
+        {
+            break;
+        }
+    }
+
+    if (cost > originalCost)
+    {
+        m_order = originalOrder;
+    }
+}
+
+
+/*!
+ * @brief Finds the order of the tests with the least switching time
+ *
+ * @param[in] script - the loaded script
+ * @param[in] profile - fixture profile with the idempotent and settle lines
+ * @param[in] outputDelay_ms - delay between transmitted characters
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReorder::optimize(CTestScript *script, const CFixtureState &profile, int outputDelay_ms)
+{
+    m_script = script;
+    m_profile = profile;
+    m_outputDelay_ms = outputDelay_ms;
+    m_order.clear();
+    m_blocks.clear();
+
+    int testCount = m_script->getTestCount();
+    for (int n=0; n<testCount; n++)
+    {
+        m_order.push_back(n);
+    }
+    m_originalMS = sequenceCost(m_order);
+
+    //
+    // Find the groups of consecutive tests
+    //
+    int first = 0;
+    while (first < testCount)
+    {
+        QString group = m_script->getTestGroup(first);
+        int last = first + 1;
+        if (!group.isEmpty() && isScheduled(first))
+        {
+            while ((last < testCount) && (m_script->getTestGroup(last) == group) && isScheduled(last))
+            {
+                last++;
+            }
+            if (last - first > 1)
+            {
+                block_t block;
+                block.m_group = group;
+                block.m_first = first;
+                block.m_last = last;
+                m_blocks.push_back(block);
+            }
+        }
+        first = last;
+    }
+
+    for (unsigned int b=0; b<m_blocks.size(); b++)
+    {
+        orderBlock(m_blocks[b]);
+    }
+
+    m_newMS = sequenceCost(m_order);
+}
+
+
+/*!
+ * @brief Writes a copy of the script with the tests in the new order
+ *
+ * Each test is moved together with all of the lines up to the next test.
+ * Lines are counted the same way as when the script is read.
+ *
+ * @param[in] sourceFile - the script that was optimized
+ * @param[in] destFile - the reordered script to write
+ * @return true if successful, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestReorder::writeReorderedScript(const QString &sourceFile, const QString &destFile)
+{
+    std::vector<QString> lines;
+    FILE *in = fopen(sourceFile.toLocal8Bit().data(), "r");
+    if (in == NULL)
+    {
+        return(false);
+    }
+    while (!feof(in))
+    {
+        char lineBuffer[1024];
+        if (fgets(lineBuffer, sizeof(lineBuffer), in))
+        {
+            lines.push_back(lineBuffer);
+        }
+    }
+    fclose(in);
+
+    if (!lines.empty() && !lines.back().endsWith("\n"))
+    {
+        lines.back().append("\n");
+    }
+
+    FILE *out = fopen(destFile.toLocal8Bit().data(), "w");
+    if (out == NULL)
+    {
+        return(false);
+    }
+
+    int firstCommand, lastCommand;
+    int headerEnd = lines.size();
+    if (m_script->getTestCommandRange(0, firstCommand, lastCommand))
+    {
+        headerEnd = firstCommand;
+    }
+    for (int i=0; i<headerEnd; i++)
+    {
+        fputs(lines[i].toLocal8Bit().data(), out);
+    }
+
+    for (unsigned int k=0; k<m_order.size(); k++)
+    {
+        m_script->getTestCommandRange(m_order[k], firstCommand, lastCommand);
+        for (int i=firstCommand; (i<lastCommand) && (i<(int)lines.size()); i++)
+        {
+            fputs(lines[i].toLocal8Bit().data(), out);
+        }
+    }
+
+    fclose(out);
+    return(true);
+}
+
+
+/*!
+ * @brief Formats the results of the last optimization as lines of text
+ *
+ * @param[out] lines - lines of the report are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReorder::getReport(std::vector<QString> &lines)
+{
+    char msg[500];
+
+    sprintf(msg, "Test reorder: script=%s  OutputDelayMS=%d",
+            m_script->getScriptVersion()->toLocal8Bit().data(), m_outputDelay_ms);
+    lines.push_back(msg);
+
+    if (m_blocks.empty())
+    {
+        lines.push_back("No groups of reorderable tests (see the group command).");
+    }
+    for (unsigned int b=0; b<m_blocks.size(); b++)
+    {
+        block_t *pBlock = &m_blocks[b];
+        sprintf(msg, "Group %s (%d tests):", pBlock->m_group.toLocal8Bit().data(), pBlock->m_last - pBlock->m_first);
+        lines.push_back(msg);
+        for (int k=pBlock->m_first; k<pBlock->m_last; k++)
+        {
+            QString line = "    %1";
+            lines.push_back(line.arg(*m_script->getTestName(m_order[k])));
+        }
+    }
+
+    sprintf(msg, "Estimated fixture switching time: %0.3lf s -> %0.3lf s, saved %0.3lf s per board",
+            m_originalMS/1000.0, m_newMS/1000.0, getSavedMS()/1000.0);
+    lines.push_back(msg);
+    lines.push_back("The savings are realized when Fixture/ElideRedundant is enabled.");
+}
@@ -0,0 +1,78 @@
+/*!
+ * @file TestReorder.h
+ * @brief Declares the CTestReorder class
+ *
+ * This class reorders the tests of a script to reduce fixture switching time
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef TESTREORDER_H
+#define TESTREORDER_H
+
+#include <vector>
+#include <QString>
+#include "TestScript.h"
+#include "FixtureState.h"
+
+/*!
+ * @brief This class finds a test order that minimizes the fixture switching time
+ *
+ * Only consecutive tests that share a group name are reordered and a test
+ * is never moved ahead of a test it requires.  The cost of an order is found
+ * by running the fixture commands (sendline_b) through the fixture model: a
+ * command that is already in effect costs nothing (it is elided when
+ * Fixture/ElideRedundant is set), any other command costs its transmit time
+ * plus its settle time.  The settle time comes from the settle lines of the
+ * fixture profile or, if there is none, from the sleeps that follow the
+ * command in the script.
+ *
+ * Each group is ordered greedily (cheapest next test) and then improved by
+ * moving single tests until no move reduces the cost.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CTestReorder
+{
+public:
+    CTestReorder();
+    ~CTestReorder();
+
+    void optimize(CTestScript *script, const CFixtureState &profile, int outputDelay_ms);
+    bool writeReorderedScript(const QString &sourceFile, const QString &destFile);
+    void getReport(std::vector<QString> &lines);
+    int  getSavedMS() { return(m_originalMS - m_newMS); }
+
+private:
+    struct block_t
+    {
+        QString  m_group;
+        int      m_first;       // position in m_order of the first test of the group
+        int      m_last;        // one past the last test of the group
+    };
+    bool isScheduled(int n);
+    int  testCost(int n, CFixtureState &state);
+    int  sequenceCost(const std::vector<int> &order);
+    bool prerequisitesMet(const std::vector<int> &order, int first, int last);
+    void orderBlock(const block_t &block);
+
+private:
+    CTestScript          *m_script;
+    CFixtureState         m_profile;
+    int                   m_outputDelay_ms;
+    std::vector<int>      m_order;          // test numbers in the new order
+    std::vector<block_t>  m_blocks;
+    int                   m_originalMS;
+    int                   m_newMS;
+};
+
+#endif // TESTREORDER_H
@@ -0,0 +1,403 @@
+/*!
+ * @file TestReport.cpp
+ * @brief Implements the CTestReport class
+ *
+ * This class reads a report file back into its records
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <algorithm>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include "TestReport.h"
+
+//
+// Names of the records written by CTestScript::generateProgramRecords()
+//
+static const char *g_programRecords[4] = {"Test Program Name", "Test Program Version", "Test Script Name", "Test Script Version"};
+
+
+/*!
+ * @brief CTestReport constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestReport::CTestReport()
+{
+    m_header.clear();
+    m_records.clear();
+}
+
+
+/*!
+ * @brief CTestReport destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTestReport::~CTestReport()
+{
+    m_header.clear();
+    m_records.clear();
+}
+
+
+/*!
+ * @brief Reads a report file
+ *
+ * @param[in] filename - name of the report file
+ * @return true if the file was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestReport::load(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return(false);
+    }
+
+    std::vector<QString> lines;
+    QTextStream in(&file);
+    while (!in.atEnd())
+    {
+        lines.push_back(in.readLine());
+    }
+    file.close();
+
+    parse(lines);
+    return(true);
+}
+
+
+/*!
+ * @brief Splits the lines of a report into the header and the records
+ *
+ * @param[in] lines - lines of the report
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReport::parse(const std::vector<QString> &lines)
+{
+    m_header.clear();
+    m_records.clear();
+
+    std::vector<QString> pending;
+    bool inRecord = false;
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        const QString &line = lines[i];
+        if (line.startsWith("TestName: "))
+        {
+            if (m_records.empty() && !inRecord)
+            {
+                m_header = pending;
+                pending.clear();
+            }
+            record_t record;
+            record.m_testName = line.mid(10).trimmed();
+            record.m_passed = true;
+            record.m_lines = pending;
+            record.m_lines.push_back(line);
+            m_records.push_back(record);
+            pending.clear();
+            inRecord = true;
+            continue;
+        }
+        if (!inRecord)
+        {
+            pending.push_back(line);
+            continue;
+        }
+
+        record_t &record = m_records.back();
+        record.m_lines.push_back(line);
+        if (line.startsWith("Result: ") && (line.mid(8).trimmed() != "PASS"))
+        {
+            record.m_passed = false;
+        }
+        if (line.startsWith("~#~"))
+        {
+            inRecord = false;
+        }
+    }
+
+    //
+    // Lines after the last record stay at the end
+    //
+    if (m_records.empty())
+    {
+        m_header = pending;
+    }
+    else
+    {
+        for (unsigned int i=0; i<pending.size(); i++)
+        {
+            m_records.back().m_lines.push_back(pending[i]);
+        }
+    }
+}
+
+
+/*!
+ * @brief Returns the value of a header line such as "ImageBarcode"
+ *
+ * @param[in] key - text before the ':'
+ * @return the text after the ':', empty if there is no such line
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CTestReport::getHeaderValue(const QString &key) const
+{
+    QString prefix = key + ":";
+    for (unsigned int i=0; i<m_header.size(); i++)
+    {
+        if (m_header[i].startsWith(prefix))
+        {
+            return(m_header[i].mid(prefix.size()).trimmed());
+        }
+    }
+    return(QString());
+}
+
+
+/*!
+ * @brief Returns the value of one of the program records (e.g. "Test Script Version")
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CTestReport::getProgramValue(const QString &name) const
+{
+    for (unsigned int k=0; k<m_records.size(); k++)
+    {
+        if (m_records[k].m_testName != name)
+        {
+            continue;
+        }
+        for (unsigned int i=0; i<m_records[k].m_lines.size(); i++)
+        {
+            if (m_records[k].m_lines[i].startsWith("Value: "))
+            {
+                return(m_records[k].m_lines[i].mid(7).trimmed());
+            }
+        }
+    }
+    return(QString());
+}
+
+
+/*!
+ * @brief Returns true if the record is one of the program records
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestReport::isProgramRecord(const record_t &record) const
+{
+    for (int k=0; k<4; k++)
+    {
+        if (record.m_testName == g_programRecords[k])
+        {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+
+/*!
+ * @brief Returns the names of the tests with a record that did not pass
+ *
+ * @param[out] names - test names, each listed once
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReport::getFailedTests(QStringList &names) const
+{
+    names.clear();
+    for (unsigned int k=0; k<m_records.size(); k++)
+    {
+        if (!m_records[k].m_passed && !isProgramRecord(m_records[k]) && !names.contains(m_records[k].m_testName))
+        {
+            names.append(m_records[k].m_testName);
+        }
+    }
+}
+
+
+/*!
+ * @brief Merges a retest into this report
+ *
+ * The header and the program records come from the retest.  The records
+ * of a test that was retested replace the records of that test where they
+ * were in this report, and carry a "Retest:" line naming this report.  The
+ * records of the other tests are kept as they were.
+ *
+ * @param[in] retest - report of the retest
+ * @param[in] retestOf - file name of this report
+ * @param[out] lines - the merged report
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReport::merge(const CTestReport &retest, const QString &retestOf, std::vector<QString> &lines) const
+{
+    lines = retest.m_header;
+
+    //
+    // Tests with a record in the retest
+    //
+    QStringList retested;
+    for (unsigned int k=0; k<retest.m_records.size(); k++)
+    {
+        if (isProgramRecord(retest.m_records[k]))
+        {
+            lines.insert(lines.end(), retest.m_records[k].m_lines.begin(), retest.m_records[k].m_lines.end());
+        }
+        else if (!retested.contains(retest.m_records[k].m_testName))
+        {
+            retested.append(retest.m_records[k].m_testName);
+        }
+    }
+
+    QStringList written;
+    for (unsigned int k=0; k<m_records.size(); k++)
+    {
+        const QString &name = m_records[k].m_testName;
+        if (isProgramRecord(m_records[k]) || written.contains(name))
+        {
+            continue;
+        }
+        if (!retested.contains(name))
+        {
+            lines.insert(lines.end(), m_records[k].m_lines.begin(), m_records[k].m_lines.end());
+            continue;
+        }
+        retest.appendRetest(name, retestOf, lines);
+        written.append(name);
+    }
+
+    //
+    // Retested tests that this report did not have go at the end
+    //
+    for (int k=0; k<retested.size(); k++)
+    {
+        if (!written.contains(retested[k]))
+        {
+            retest.appendRetest(retested[k], retestOf, lines);
+        }
+    }
+}
+
+
+/*!
+ * @brief Appends the records of a test, marking each one as a retest
+ *
+ * @param[in] testName - the test
+ * @param[in] retestOf - file name of the report that was retested
+ * @param[in,out] lines - the records are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestReport::appendRetest(const QString &testName, const QString &retestOf, std::vector<QString> &lines) const
+{
+    for (unsigned int k=0; k<m_records.size(); k++)
+    {
+        if (m_records[k].m_testName != testName)
+        {
+            continue;
+        }
+        for (unsigned int i=0; i<m_records[k].m_lines.size(); i++)
+        {
+            if (m_records[k].m_lines[i].startsWith("~#~"))
+            {
+                lines.push_back("Retest: " + retestOf);
+            }
+            lines.push_back(m_records[k].m_lines[i]);
+        }
+    }
+}
+
+
+/*!
+ * @brief Orders reports newest first
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+static bool newerReport(const QFileInfo &a, const QFileInfo &b)
+{
+    return(a.lastModified() > b.lastModified());
+}
+
+
+/*!
+ * @brief Finds the newest report of a serial number
+ *
+ * @param[in] dirs - directories the reports are written to
+ * @param[in] serialNumber - the serial number (ImageBarcode) of the board
+ * @param[out] filename - path of the newest report of the board
+ * @return true if a report was found
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestReport::findLastReport(const QStringList &dirs, const QString &serialNumber, QString &filename)
+{
+    QFileInfoList files;
+    for (int d=0; d<dirs.size(); d++)
+    {
+        QDir dir(dirs[d]);
+        files.append(dir.entryInfoList(QStringList() << "*.txt", QDir::Files));
+    }
+
+    //
+    // Newest first; stop at the first report of the board
+    //
+    std::sort(files.begin(), files.end(), newerReport);
+    QString barcodeLine = "ImageBarcode: " + serialNumber;
+    for (int f=0; f<files.size(); f++)
+    {
+        const QFileInfo &info = files[f];
+
+        QFile file(info.absoluteFilePath());
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            continue;
+        }
+        QTextStream in(&file);
+        while (!in.atEnd())
+        {
+            QString line = in.readLine();
+            if (line.startsWith("TestName: "))
+            {
+                break;    // past the header
+            }
+            if (line.trimmed() == barcodeLine)
+            {
+                filename = info.absoluteFilePath();
+                return(true);
+            }
+        }
+    }
+    return(false);
+}
@@ -0,0 +1,69 @@
+/*!
+ * @file TestReport.h
+ * @brief Declares the CTestReport class
+ *
+ * This class reads a report file back into its records
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef TESTREPORT_H
+#define TESTREPORT_H
+
+#include <vector>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * @brief This class splits a report into its header and its records
+ *
+ * A record starts with a "TestName:" line and ends with a "~#~" line.  The
+ * lines before the first record (TestProgram, Operator, ImageBarcode...)
+ * are the header.  The lines between two records are kept with the record
+ * that follows them so that the report can be written back unchanged.
+ *
+ * This is used by the retest mode to find the tests that failed in the
+ * last report of a board and to merge the retest into that report.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CTestReport
+{
+public:
+    CTestReport();
+    ~CTestReport();
+
+    bool    load(const QString &filename);
+    void    parse(const std::vector<QString> &lines);
+    QString getHeaderValue(const QString &key) const;
+    QString getProgramValue(const QString &name) const;
+    void    getFailedTests(QStringList &names) const;
+    void    merge(const CTestReport &retest, const QString &retestOf, std::vector<QString> &lines) const;
+
+    static bool findLastReport(const QStringList &dirs, const QString &serialNumber, QString &filename);
+
+private:
+    struct record_t
+    {
+        QString               m_testName;
+        bool                  m_passed;
+        std::vector<QString>  m_lines;      // including the lines before the "TestName:" line
+    };
+    bool isProgramRecord(const record_t &record) const;
+    void appendRetest(const QString &testName, const QString &retestOf, std::vector<QString> &lines) const;
+
+private:
+    std::vector<QString>   m_header;
+    std::vector<record_t>  m_records;
+};
+
+#endif // TESTREPORT_H
@@ -13,10 +13,14 @@
  *  Version | Author       | Date        | Description
  *  :--:    | :-----       | :--:        | :----------
  *   1      | J. Peterson  | 02/13/2015  | initial version
+ *   2      | agent        | 10/19/2026  | budgets, adaptive timeouts, retries, fixture state, panels
  *
 */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <algorithm>
 #include <QMessageBox>
 #include <QtCore/QtGlobal>
 #include <QTimer>
@@ -28,6 +32,7 @@
 #include "Abort.h"
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QCryptographicHash>
 
 
 
@@ -45,6 +50,32 @@ CTestScript::CTestScript()
     m_terminateOnError = false;
     m_errorEncountered = false;
     m_terminatedEarly = false;
+    m_timeoutA_ms = 100;
+    m_timeoutB_ms = 100;
+    m_adaptiveTimeouts = false;
+    m_adaptiveMargin_ms = 20;
+    m_adaptiveMinSamples = 100;
+    m_deferredSleep_ms = 0;
+    m_sendTimeValid[0] = false;
+    m_sendTimeValid[1] = false;
+    m_currentTestIndex = -1;
+    m_lastSendPort = -1;
+    m_replyGap_ms = 0;
+    m_elideRedundant = false;
+    m_skipSettleSleep = false;
+    m_sentSinceSleep = false;
+    m_scriptRetries = 0;
+    m_scriptBackoff_ms = 0;
+    m_groupStart = -1;
+    m_groupRetries = 0;
+    m_retrying = false;
+    m_retryCount[0] = 0;
+    m_retryCount[1] = 0;
+    m_nextPromptId = 0;
+    m_pauseId = -1;
+    m_position = 1;
+    m_sharedFixture = false;
+    m_fixtureHeld = false;
 }
 
 
@@ -82,8 +113,16 @@ bool CTestScript::readScriptFile(const char *filename)
     // Clear out the current list of tests and commands
     //
     m_testList.clear();
+    m_testPrereqs.clear();
+    m_testGroups.clear();
     m_commandList.clear();
+    m_sectionHashes.clear();
     m_version.clear();
+    m_scriptRetries = 0;
+    m_scriptBackoff_ms = 0;
+    m_scriptName.clear();
+    m_measurements.clear();
+    m_sleepOverrides.clear();
 
     //
     // If no file name was given then we are done
@@ -96,8 +135,8 @@ bool CTestScript::readScriptFile(const char *filename)
     //
     // Open the file
     //
-    FILE *fp = fopen(filename, "r");
-    if (fp == NULL)
+    std::vector<QByteArray> lines;
+    if (!readLines(filename, lines))
     {
         QMessageBox msgBox;
         msgBox.setText("Could not open script file.");
@@ -107,518 +146,2979 @@ bool CTestScript::readScriptFile(const char *filename)
 
 
     //
-    // Read each line of the script file and parse it.
-    while (!feof(fp))
+    // Parse each line of the script file.
+    //
+    m_commandList.resize(lines.size());
+    for (unsigned int i=0; i<lines.size(); i++)
     {
-        char lineBuffer[1024];
-        if (fgets(lineBuffer, sizeof(lineBuffer), fp))
+        parseLine(lines[i], i);
+    }
+
+    indexCommands(lines);
+
+    m_scriptName = QFileInfo(filename).fileName();
+    return(true);
+}
+
+
+/*!
+ * @brief Reads the script file again, parsing only the sections that changed
+ *
+ * The script is divided in sections: the lines before the first test, then
+ * one section per test.  A section whose text has the same hash as a
+ * section of the loaded script keeps its parsed commands (renumbered to
+ * their new lines); the other sections are parsed.  The prerequisites and
+ * parallel blocks are resolved again for the whole script.
+ *
+ * @param[in] filename - name of the script file
+ * @param[out] changed - false if the file has the same sections as the loaded script
+ * @param[out] reparsed - names of the tests that were parsed ("(header)" for the lines before the first test)
+ * @return false if the file could not be read, the loaded script is then kept
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::updateScriptFile(const char *filename, bool &changed, QStringList &reparsed)
+{
+    changed = false;
+    reparsed.clear();
+
+    std::vector<QByteArray> lines;
+    if ((filename == NULL) || !readLines(filename, lines))
+    {
+        return(false);
+    }
+
+    std::vector<int> starts;
+    findSections(lines, starts);
+    std::vector<int> oldStarts;
+    findSections(m_commandList, oldStarts);
+    if (oldStarts.size() != m_sectionHashes.size())
+    {
+        m_sectionHashes.clear();     // not read from a file, nothing can be kept
+    }
+    std::vector<bool> reused(m_sectionHashes.size(), false);
+
+    std::vector<CCommand> commands;
+    commands.reserve(lines.size());
+    std::vector<int> unknown;     // commands parsed that could not be understood
+    for (unsigned int k=0; k<starts.size(); k++)
+    {
+        int first = starts[k];
+        int last = (k+1 < starts.size()) ? starts[k+1] : lines.size();
+        QByteArray hash = sectionHash(lines, first, last);
+
+        //
+        // Look for the same text in the loaded script, at the same
+        // section first
+        //
+        int match = -1;
+        if ((k < m_sectionHashes.size()) && !reused[k] && (m_sectionHashes[k] == hash))
         {
-            //
-            // create the new command
-            //
-            m_commandList.push_back(CCommand());
-            int i = m_commandList.size() - 1;
-            CCommand *pCommand = &m_commandList[i];
-            pCommand->parse(lineBuffer, i);
-            if (pCommand->m_type == CCommand::CMD_UNKNOWN)
+            match = k;
+        }
+        for (unsigned int j=0; (j<m_sectionHashes.size()) && (match < 0); j++)
+        {
+            if (!reused[j] && (m_sectionHashes[j] == hash))
             {
-                QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
-                QString msg = "<html><head/><body><p><span style=\" font-size:10pt; font-weight:600; color:#F00000;\"><pre>Poorly formed command on line ";
-                QString lineNum;
-                lineNum.setNum(i+1, 10);
-                msg.append(lineNum);
-                msg.append(":\n\n    ");
-                msg.append(lineBuffer);
-                msg.append("\n</pre></span></p></body></html>");
-                QMessageBox::warning(NULL, title, msg);
+                match = j;
             }
-            if (pCommand->m_type == CCommand::CMD_VERSION)
+        }
+
+        if (match >= 0)
+        {
+            reused[match] = true;
+            int oldFirst = oldStarts[match];
+            for (int i=first; i<last; i++)
             {
-                if (!m_version.isEmpty())
-                {
-                    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
-                    QString msg = "<html><head/><body><p><span style=\" font-size:10pt; font-weight:600; color:#F00000;\"><pre>Re-declaration of Version on line: ";
-                    QString lineNum;
-                    lineNum.setNum(i, 10);
-                    msg.append(lineNum);
-                    msg.append(":\n\n    ");
-                    msg.append(lineBuffer);
-                    msg.append("\n</pre></span></p></body></html>");
-                    QMessageBox::warning(NULL, title, msg);
-                }
-                m_version = pCommand->m_scriptVersion;
+                commands.push_back(m_commandList[oldFirst + i - first]);
+                commands.back().m_lineNumber = i;
             }
-            if (pCommand->m_type == CCommand::CMD_TEST)
+            if (match != (int)k)
             {
-                m_testList.push_back(i);
+                changed = true;
             }
+            continue;
         }
-    }
 
-    fclose(fp);
+        changed = true;
+        for (int i=first; i<last; i++)
+        {
+            commands.push_back(CCommand());
+            commands.back().parse(lines[i].constData(), i);
+            if (commands.back().m_type == CCommand::CMD_UNKNOWN)
+            {
+                unknown.push_back(i);
+            }
+        }
+        reparsed.append((k == 0) ? QString("(header)") : commands[first].m_stringArg);
+    }
+    if (starts.size() != m_sectionHashes.size())
+    {
+        changed = true;
+    }
+    if (!changed)
+    {
+        return(true);
+    }
 
+    //
+    // Swap in the new commands, the results of the old ones no longer apply
+    //
+    m_commandList.swap(commands);
+    m_measurements.clear();
+    m_sleepOverrides.clear();
+    for (unsigned int i=0; i<unknown.size(); i++)
+    {
+        warnUnknown(unknown[i]);
+    }
+    indexCommands(lines);
     return(true);
 }
 
 
 /*!
- * @brief Returns the index of the test with the specified name.
+ * @brief Reads the lines of a script file
  *
- * @param[in] name - name of the desired test
- * @return - returns the index of the test if found, -1 otherwise
+ * @param[in] filename - name of the script file
+ * @param[out] lines - the lines, as read
+ * @return false if the file could not be opened
  *
- * @author J. Peterson
- * @date 06/22/2014
+ * @author agent
+ * @date 10/19/2026
 */
-int CTestScript::findTestByName(QString &name)
+bool CTestScript::readLines(const char *filename, std::vector<QByteArray> &lines)
 {
-    int testCount = getTestCount();
-    for (int i=0; i<testCount; i++)
+    lines.clear();
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL)
     {
-        QString *pStr = getTestName(i);
-        if (name == *pStr)
-            return(i);
+        return(false);
     }
-    return(-1);
+
+    while (!feof(fp))
+    {
+        char lineBuffer[1024];
+        if (fgets(lineBuffer, sizeof(lineBuffer), fp))
+        {
+            lines.push_back(QByteArray(lineBuffer));
+        }
+    }
+
+    fclose(fp);
+    return(true);
 }
 
 
+/*!
+ * @brief Parses one line of the script file into the command of the same index
+ *
+ * @param[in] line - the line, as read
+ * @param[in] i - index of the line
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::parseLine(const QByteArray &line, int i)
+{
+    CCommand *pCommand = &m_commandList[i];
+    pCommand->parse(line.constData(), i);
+    if (pCommand->m_type == CCommand::CMD_UNKNOWN)
+    {
+        warnUnknown(i);
+    }
+}
+
 
 /*!
- * @brief Runs the specified test from the currently loaded test script
+ * @brief Reports a command that could not be parsed
  *
- * @param[in] n - number of test to run
- * @return Returns a bool indicating if the tests should be aborted
+ * @param[in] i - index of the command
  *
  * @author J. Peterson
  * @date 06/22/2014
 */
-bool CTestScript::runTest(unsigned int n)
+void CTestScript::warnUnknown(int i)
 {
-    m_errorEncountered = false;
-    m_terminatedEarly = false;
+    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+    QString msg = "<html><head/><body><p><span style=\" font-size:10pt; font-weight:600; color:#F00000;\"><pre>Poorly formed command on line ";
+    QString lineNum;
+    lineNum.setNum(i+1, 10);
+    msg.append(lineNum);
+    msg.append(":\n\n    ");
+    msg.append(m_commandList[i].m_line);
+    msg.append("\n</pre></span></p></body></html>");
+    QMessageBox::warning(NULL, title, msg);
+}
 
-    if (n >= m_testList.size())
+
+/*!
+ * @brief Finds the first line of each section of a script
+ *
+ * The first section is the lines before the first test (it may be empty),
+ * then each test is a section.
+ *
+ * @param[in] lines - lines of the script
+ * @param[out] starts - index of the first line of each section
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::findSections(const std::vector<QByteArray> &lines, std::vector<int> &starts)
+{
+    starts.clear();
+    starts.push_back(0);
+    for (unsigned int i=0; i<lines.size(); i++)
     {
-        return(true);
+        QStringList args = QString(lines[i]).trimmed().split(QRegExp("[ \t]"), QString::SkipEmptyParts);
+        if (!args.isEmpty() && (args[0] == "test"))
+        {
+            starts.push_back(i);
+        }
     }
+}
 
-    int firstCommand = m_testList[n];
-    int lastCommand = (n < m_testList.size()-1) ? m_testList[n+1] : m_commandList.size();
 
-    for (int i=firstCommand; i<lastCommand; i++)
+/*!
+ * @brief Finds the first command of each section of the loaded script
+ *
+ * @param[in] commands - commands of the script
+ * @param[out] starts - index of the first command of each section
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::findSections(const std::vector<CCommand> &commands, std::vector<int> &starts)
+{
+    starts.clear();
+    starts.push_back(0);
+    for (unsigned int i=0; i<commands.size(); i++)
     {
-        if (CAbort::Instance()->abortRequested())
+        if (commands[i].m_type == CCommand::CMD_TEST)
         {
-            m_errorEncountered = true;
-            return(true);
+            starts.push_back(i);
         }
+    }
+}
 
-        CCommand *pCommand = &m_commandList[i];
 
-        switch (pCommand->m_type)
+/*!
+ * @brief Returns the hash of the text of the lines first to last-1
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QByteArray CTestScript::sectionHash(const std::vector<QByteArray> &lines, int first, int last)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int i=first; i<last; i++)
+    {
+        hash.addData(lines[i]);
+    }
+    return(hash.result());
+}
+
+
+/*!
+ * @brief Builds the list of tests and resolves the references between commands
+ *
+ * This is done after the commands have been parsed.  The hash of each
+ * section is kept for updateScriptFile().
+ *
+ * @param[in] lines - lines of the script the commands were parsed from
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::indexCommands(const std::vector<QByteArray> &lines)
+{
+    m_testList.clear();
+    m_testGroups.clear();
+    m_version.clear();
+    m_scriptRetries = 0;
+    m_scriptBackoff_ms = 0;
+    for (unsigned int i=0; i<m_commandList.size(); i++)
+    {
+        CCommand *pCommand = &m_commandList[i];
+        if (pCommand->m_type == CCommand::CMD_VERSION)
         {
-            case CCommand::CMD_TEST:
+            if (!m_version.isEmpty())
             {
-                m_currentTest = pCommand->m_stringArg;
-                m_currentDesc.clear();
-                m_currentUnits.clear();
-                break;
+                QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+                QString msg = "<html><head/><body><p><span style=\" font-size:10pt; font-weight:600; color:#F00000;\"><pre>Re-declaration of Version on line: ";
+                QString lineNum;
+                lineNum.setNum(i, 10);
+                msg.append(lineNum);
+                msg.append(":\n\n    ");
+                msg.append(pCommand->m_line);
+                msg.append("\n</pre></span></p></body></html>");
+                QMessageBox::warning(NULL, title, msg);
             }
+            m_version = pCommand->m_scriptVersion;
+        }
+        if (pCommand->m_type == CCommand::CMD_TEST)
+        {
+            m_testList.push_back(i);
+            m_testGroups.push_back(QString());
+        }
+        if ((pCommand->m_type == CCommand::CMD_GROUP) && !m_testGroups.empty())
+        {
+            m_testGroups.back() = pCommand->m_stringArg;
+        }
+        if ((pCommand->m_type == CCommand::CMD_RETRY) && m_testList.empty() && (pCommand->m_stringArg != "once"))
+        {
+            m_scriptRetries = pCommand->m_argInteger;
+            m_scriptBackoff_ms = pCommand->m_argInteger2;
+        }
+    }
 
-            case CCommand::CMD_VERSION:
+    //
+    // Allocate the capture buffers for the largest readblock now so that
+    // nothing is allocated while the tests run
+    //
+    int maxSamples = 0;
+    for (unsigned int i=0; i<m_commandList.size(); i++)
+    {
+        if (  (m_commandList[i].m_type == CCommand::CMD_READBLOCK)
+           && (m_commandList[i].params_READBLOCK.m_sampleCount > maxSamples) )
+        {
+            maxSamples = m_commandList[i].params_READBLOCK.m_sampleCount;
+        }
+    }
+    m_signal.reserve(maxSamples);
+    m_blockBytes.assign(2*maxSamples, 0);
+
+    resolvePrerequisites();
+    resolveParallelBlocks();
+
+    std::vector<int> starts;
+    findSections(lines, starts);
+    m_sectionHashes.clear();
+    for (unsigned int k=0; k<starts.size(); k++)
+    {
+        int last = (k+1 < starts.size()) ? starts[k+1] : lines.size();
+        m_sectionHashes.push_back(sectionHash(lines, starts[k], last));
+    }
+}
+
+
+/*!
+ * @brief Finds the branches of each parallel block and checks that they can run together
+ *
+ * Each branch may only use one port and the two branches may not use the same
+ * port.  Only the commands that talk to a port, sleeps, units and the expects
+ * that test a single reply are allowed in a branch.  The index of the "} / {"
+ * and of the closing "}" are stored in the parallel command.  A block that is
+ * not well formed is reported and its parallel command is made unknown (the
+ * test fails when it reaches it).
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::resolveParallelBlocks()
+{
+    int count = m_commandList.size();
+    for (int i=0; i<count; i++)
+    {
+        CCommand *pCommand = &m_commandList[i];
+        if ((pCommand->m_type == CCommand::CMD_PARALLEL_NEXT) || (pCommand->m_type == CCommand::CMD_PARALLEL_END))
+        {
+            warnParallelBlock(i, "not inside a parallel block");
+            continue;
+        }
+        if (pCommand->m_type != CCommand::CMD_PARALLEL)
+        {
+            continue;
+        }
+
+        int separator = -1;
+        int end = -1;
+        int port[2] = {-1, -1};
+        int branch = 0;
+        const char *reason = NULL;
+        int bad = i;    // line reported when the block is not well formed
+        for (int k=i+1; (k<count) && (reason == NULL); k++)
+        {
+            CCommand::commandType_t type = m_commandList[k].m_type;
+            if (type == CCommand::CMD_PARALLEL_END)
             {
+                end = k;
                 break;
             }
-#if 0
-            case CCommand::CMD_TYPE:
+            bad = k;
+            if (type == CCommand::CMD_PARALLEL_NEXT)
             {
-                QString line = "TestType: ";
-                line.append(pCommand->m_stringArg);
-                logStringBlack(line.toLocal8Bit());
-                break;
+                if (branch == 1)
+                {
+                    reason = "a parallel block has only two branches";
+                }
+                separator = k;
+                branch = 1;
+                continue;
             }
-#endif
 
-            case CCommand::CMD_DESC:
+            int p = -1;
+            switch (type)
             {
-                m_currentDesc = pCommand->m_stringArg;
+            case CCommand::CMD_SENDLINE_A:
+            case CCommand::CMD_READLINE_A:
+            case CCommand::CMD_FLUSH_A:
+                p = 0;
+                break;
+            case CCommand::CMD_SENDLINE_B:
+            case CCommand::CMD_READLINE_B:
+            case CCommand::CMD_FLUSH_B:
+                p = 1;
                 break;
-            }
-
             case CCommand::CMD_SLEEP:
-            {
-                logStringGray(pCommand->m_line.toLocal8Bit());
-                QEventLoop loop;
-                QTimer::singleShot(pCommand->m_argInteger, &loop, SLOT(quit()));
-                loop.exec();
+            case CCommand::CMD_COMMENT:
+            case CCommand::CMD_UNITS:
+            case CCommand::CMD_EXPECT:
+            case CCommand::CMD_EXPECT_CHAR:
+            case CCommand::CMD_EXPECT_STR:
+                break;
+            default:
+                reason = "command is not allowed in a parallel block";
                 break;
             }
-
-            case CCommand::CMD_PROMPT:
+            if (p >= 0)
             {
-                generateTestHeader();
-                logStringBlack("Nominal: \"YES\"");
-                QMessageBox::StandardButton reply;
-                QString title = "VapoTherm Test";
-                QString prefix = "<font size=20>";
-                QString suffix = "</font>";
-                QString line = prefix + pCommand->m_stringArg + suffix;
-                reply = QMessageBox::question(NULL, title, line, QMessageBox::Yes|QMessageBox::No);
-                if (reply == QMessageBox::No)
+                if (port[branch] < 0)
                 {
-                    m_errorEncountered = true;
-                    logStringRed("Value: \"NO\"");
-                    logStringRed("Result: FAIL");
-                    logStringRed("FailDesc: failed operator inspection");
+                    port[branch] = p;
                 }
-                else
+                else if (port[branch] != p)
                 {
-                    logStringBlack("Value: \"YES\"");
-                    logStringBlack("Result: PASS");
+                    reason = "a branch can only use one port";
                 }
-                generateTestTrailer();
-                break;
             }
+        }
 
-            case CCommand::CMD_PAUSE:
-            {
-                QString title = "VapoTherm Test";
-                QString prefix = "<font size=20>";
-                QString suffix = "</font>";
-                QString line = prefix + pCommand->m_stringArg + suffix;
+        if ((reason == NULL) && ((separator < 0) || (end < 0)))
+        {
+            reason = "parallel block needs a \"} / {\" and a closing \"}\"";
+            bad = i;
+        }
+        if ((reason == NULL) && (port[0] >= 0) && (port[0] == port[1]))
+        {
+            reason = "both branches use the same port";
+            bad = i;
+        }
+
+        if (reason != NULL)
+        {
+            warnParallelBlock(bad, reason);
+            pCommand->m_type = CCommand::CMD_UNKNOWN;
+        }
+        else
+        {
+            pCommand->m_argInteger = separator;
+            pCommand->m_argInteger2 = end;
+        }
+        if (end >= 0)
+        {
+            i = end;
+        }
+    }
+}
+
+
+/*!
+ * @brief Reports a parallel block that can not be run
+ *
+ * @param[in] i - index of the offending command
+ * @param[in] reason - what is wrong with the block
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::warnParallelBlock(int i, const char *reason)
+{
+    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+    QString msg = "<html><head/><body><p><span style=\" font-size:10pt; font-weight:600; color:#F00000;\"><pre>Poorly formed parallel block on line ";
+    QString lineNum;
+    lineNum.setNum(i+1, 10);
+    msg.append(lineNum);
+    msg.append(" (");
+    msg.append(reason);
+    msg.append("):\n\n    ");
+    msg.append(m_commandList[i].m_line);
+    msg.append("\n</pre></span></p></body></html>");
+    QMessageBox::warning(NULL, title, msg);
+}
+
+
+/*!
+ * @brief Sets the panel position that this script runs for
+ *
+ * "%POS%" in a sendline is replaced by the position.  The ids of the operator
+ * prompts are offset by the position so that the positions of a panel can
+ * share the operator queue.
+ *
+ * @param[in] position - position on the panel, starting at 1
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::setPosition(int position)
+{
+    m_position = position;
+    m_nextPromptId = position * 100000;
+}
+
+
+/*!
+ * @brief Sends fixture commands again to put the fixture in a known state
+ *
+ * This is used when a run is resumed from a checkpoint.  The commands are
+ * the ones returned by getFixtureCommands() when the checkpoint was taken.
+ *
+ * @param[in] commands - the fixture commands
+ * @return true if every command was sent and echoed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::restoreFixture(const std::vector<QString> &commands)
+{
+    m_fixtureState.invalidate();
+    bool restored = true;
+    for (unsigned int k=0; k<commands.size(); k++)
+    {
+        bool sent = sendVapoThermCommand(1, commands[k].toLocal8Bit());
+        logCommand(commands[k].toLocal8Bit());
+        bool echoed = readVapoThermResponse(1, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutB_ms);
+        logReply(m_responseBuffer);
+        if (sent && echoed)
+        {
+            m_fixtureState.commandSent(commands[k]);
+        }
+        else
+        {
+            restored = false;
+        }
+    }
+    if (!restored)
+    {
+        m_fixtureState.invalidate();
+    }
+    return(restored);
+}
+
+
+/*!
+ * @brief Replaces "%POS%" with the panel position
+ *
+ * @param[in] text - text of a sendline
+ * @return the text as it is sent
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CTestScript::substitutePosition(const QString &text)
+{
+    if (!text.contains("%POS%"))
+    {
+        return(text);
+    }
+    QString result = text;
+    result.replace("%POS%", QString::number(m_position));
+    return(result);
+}
+
+
+/*!
+ * @brief Reports if a command talks to the fixture (port B)
+ *
+ * @param[in] i - index of the command
+ * @return true if the command needs the fixture
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::usesFixture(int i)
+{
+    const CCommand *pCommand = &m_commandList[i];
+    switch (pCommand->m_type)
+    {
+    case CCommand::CMD_SENDLINE_B:
+    case CCommand::CMD_READLINE_B:
+    case CCommand::CMD_FLUSH_B:
+        return(true);
+    case CCommand::CMD_WAITFOR:
+        return(pCommand->params_WAITFOR.m_channelIndex == 1);
+    case CCommand::CMD_READBLOCK:
+        return(pCommand->params_READBLOCK.m_channelIndex == 1);
+    case CCommand::CMD_EXPECT_AVG:
+    case CCommand::CMD_EXPECT_STATS:
+        return(m_lastSendPort == 1);
+    case CCommand::CMD_PARALLEL:
+        for (int k=i+1; k<pCommand->m_argInteger2; k++)
+        {
+            if (usesFixture(k))
+            {
+                return(true);
+            }
+        }
+        return(false);
+    default:
+        return(false);
+    }
+}
+
+
+/*!
+ * @brief Takes or gives up the shared fixture before a command runs
+ *
+ * The fixture is taken by the first command that talks to it and is kept
+ * through the sleeps and expects that follow.  It is given up when the test
+ * goes on to talk to the DUT or to the operator, so that another position
+ * can use the fixture in the meantime.
+ *
+ * @param[in] i - index of the command about to run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::leaseFixture(int i)
+{
+    if (usesFixture(i))
+    {
+        if (!m_fixtureHeld)
+        {
+            m_fixtureHeld = true;
+            acquireFixture();
+        }
+        return;
+    }
+
+    const CCommand *pCommand = &m_commandList[i];
+    bool givesUp = false;
+    switch (pCommand->m_type)
+    {
+    case CCommand::CMD_SENDLINE_A:
+    case CCommand::CMD_READLINE_A:
+    case CCommand::CMD_PROMPT:
+    case CCommand::CMD_PAUSE:
+    case CCommand::CMD_WAITFOR:
+    case CCommand::CMD_READBLOCK:
+    case CCommand::CMD_PARALLEL:
+        givesUp = true;
+        break;
+    case CCommand::CMD_EXPECT_AVG:
+    case CCommand::CMD_EXPECT_STATS:
+        givesUp = (m_lastSendPort == 0);
+        break;
+    default:
+        break;
+    }
+    if (givesUp && m_fixtureHeld)
+    {
+        m_fixtureHeld = false;
+        releaseFixture();
+    }
+}
+
+
+/*!
+ * @brief Makes this script a copy of a script that is already loaded
+ *
+ * This is used to give each position of a panel its own copy of the
+ * script without parsing (and reporting the problems of) the file again.
+ *
+ * @param[in] source - the loaded script
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::copyScript(const CTestScript &source)
+{
+    m_commandList = source.m_commandList;
+    m_testList = source.m_testList;
+    m_testPrereqs = source.m_testPrereqs;
+    m_testGroups = source.m_testGroups;
+    m_version = source.m_version;
+    m_scriptName = source.m_scriptName;
+    m_scriptRetries = source.m_scriptRetries;
+    m_scriptBackoff_ms = source.m_scriptBackoff_ms;
+    m_sectionHashes = source.m_sectionHashes;
+    m_measurements.clear();
+    m_sleepOverrides.clear();
+
+    int maxSamples = 0;
+    for (unsigned int i=0; i<m_commandList.size(); i++)
+    {
+        if (  (m_commandList[i].m_type == CCommand::CMD_READBLOCK)
+           && (m_commandList[i].params_READBLOCK.m_sampleCount > maxSamples) )
+        {
+            maxSamples = m_commandList[i].params_READBLOCK.m_sampleCount;
+        }
+    }
+    m_signal.reserve(maxSamples);
+    m_blockBytes.assign(2*maxSamples, 0);
+}
+
+
+/*!
+ * @brief Writes the records that identify the program and script of a run
+ *
+ * @param[in] program - file name of the test program
+ * @param[in] programVersion - version of the test program
+ * @param[in] scriptFile - file name of the script
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::generateProgramRecords(const QString &program, const QString &programVersion, const QString &scriptFile)
+{
+    time_t rawtime;
+    struct tm *t;
+    time (&rawtime);
+    t = localtime (&rawtime);
+    char    tmpStr[100];
+    sprintf(tmpStr, "%02d/%02d/%04d", t->tm_mon+1, t->tm_mday, t->tm_year+1900);
+    QString dateLine = "Date: ";
+    dateLine.append(tmpStr);
+    sprintf(tmpStr, "%02d:%02d:%02d", t->tm_hour, t->tm_min, t->tm_sec);
+    QString timeLine = "Time: ";
+    timeLine.append(tmpStr);
+
+    const char *names[4] = {"Test Program Name", "Test Program Version", "Test Script Name", "Test Script Version"};
+    QString values[4] = {program, programVersion, scriptFile, m_version};
+    for (int k=0; k<4; k++)
+    {
+        QString line = "TestName: ";
+        line.append(names[k]);
+        logStringBlack(line.toLocal8Bit());
+        line = "TestType: ";
+        line.append(names[k]);
+        logStringBlack(line.toLocal8Bit());
+        logStringBlack(dateLine.toLocal8Bit());
+        logStringBlack(timeLine.toLocal8Bit());
+        line = "Value: ";
+        line.append(values[k]);
+        logStringBlack(line.toLocal8Bit());
+        logStringBlack("Result: PASS");
+        logStringBlack("~#~\n");
+    }
+}
+
+
+/*!
+ * @brief Enables waiting on replies based on the history of observed latencies
+ *
+ * When enabled, a sleep that is followed by a readline is not executed.
+ * Instead the readline waits for the reply for up to the sleep time plus the
+ * port timeout (the hard limit).  Once a readline has enough history, a reply
+ * later than the 99.9th percentile of its latencies plus the margin is logged
+ * as late; the readline only fails at the hard limit.
+ *
+ * @param[in] enable - true to enable adaptive timeouts
+ * @param[in] margin_ms - margin added to the 99.9th percentile
+ * @param[in] minSamples - number of samples needed before the history is used
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::setAdaptiveTimeouts(bool enable, int margin_ms, int minSamples)
+{
+    m_adaptiveTimeouts = enable;
+    m_adaptiveMargin_ms = margin_ms;
+    m_adaptiveMinSamples = minSamples;
+}
+
+
+/*!
+ * @brief Returns the index of the test with the specified name.
+ *
+ * @param[in] name - name of the desired test
+ * @return - returns the index of the test if found, -1 otherwise
+ *
+ * @author J. Peterson
+ * @date 06/22/2014
+*/
+int CTestScript::findTestByName(QString &name)
+{
+    int testCount = getTestCount();
+    for (int i=0; i<testCount; i++)
+    {
+        QString *pStr = getTestName(i);
+        if (name == *pStr)
+            return(i);
+    }
+    return(-1);
+}
+
+
+
+/*!
+ * @brief Returns the nearest test before test n with the specified name.
+ *
+ * @param[in] name - name of the desired test
+ * @param[in] n - number of the test that is searching
+ * @return - returns the index of the test if found, -1 otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestScript::findPrecedingTestByName(const QString &name, int n)
+{
+    for (int i=n-1; i>=0; i--)
+    {
+        if (name == *getTestName(i))
+            return(i);
+    }
+    return(-1);
+}
+
+
+/*!
+ * @brief Builds the list of prerequisites of each test from the requires commands
+ *
+ * Test names may contain commas, so the longest run of comma separated
+ * pieces that names a test is taken first.  A prerequisite must be one of the
+ * tests before the test that requires it; if a name is used more than once
+ * the nearest one is used.  Names that can not be resolved are reported
+ * and ignored.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::resolvePrerequisites()
+{
+    int testCount = getTestCount();
+    m_testPrereqs.assign(testCount, std::vector<int>());
+
+    for (int n=0; n<testCount; n++)
+    {
+        int firstCommand, lastCommand;
+        getTestCommandRange(n, firstCommand, lastCommand);
+        for (int i=firstCommand; i<lastCommand; i++)
+        {
+            const CCommand *pCommand = &m_commandList[i];
+            if (pCommand->m_type != CCommand::CMD_REQUIRES)
+            {
+                continue;
+            }
+
+            QStringList pieces = pCommand->m_stringArg.split(",");
+            int k = 0;
+            while (k < pieces.size())
+            {
+                int found = -1;
+                int used = 1;
+                for (int j=pieces.size(); j>k; j--)
+                {
+                    QString name = pieces.mid(k, j-k).join(",").trimmed();
+                    found = findPrecedingTestByName(name, n);
+                    if (found >= 0)
+                    {
+                        used = j - k;
+                        break;
+                    }
+                }
+
+                if (found >= 0)
+                {
+                    if (std::find(m_testPrereqs[n].begin(), m_testPrereqs[n].end(), found) == m_testPrereqs[n].end())
+                    {
+                        m_testPrereqs[n].push_back(found);
+                    }
+                }
+                else if (!pieces[k].trimmed().isEmpty())
+                {
+                    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+                    QString msg = "<html><head/><body><p><span style=\" font-size:10pt; font-weight:600; color:#F00000;\"><pre>No earlier test named \"";
+                    msg.append(pieces[k].trimmed());
+                    msg.append("\" for requires on line ");
+                    QString lineNum;
+                    lineNum.setNum(pCommand->m_lineNumber+1, 10);
+                    msg.append(lineNum);
+                    msg.append(":\n\n    ");
+                    msg.append(pCommand->m_line);
+                    msg.append("\n</pre></span></p></body></html>");
+                    QMessageBox::warning(NULL, title, msg);
+                }
+                k += used;
+            }
+        }
+    }
+}
+
+
+/*!
+ * @brief Returns the tests that must not fail for a test to run
+ *
+ * @param[in] n - number of the test
+ * @return the numbers of the required tests
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+const std::vector<int> &CTestScript::getPrerequisites(unsigned int n)
+{
+    static const std::vector<int> none;
+    if (n >= m_testPrereqs.size())
+    {
+        return(none);
+    }
+    return(m_testPrereqs[n]);
+}
+
+
+/*!
+ * @brief Called when the operator answers an async prompt
+ *
+ * The record is not written here since a test may be in the middle of
+ * writing one; it is written at the next command boundary.
+ *
+ * @param[in] id - the prompt that was answered
+ * @param[in] yes - true if the operator answered yes
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::operatorPromptAnswered(int id, bool yes)
+{
+    if (id == m_pauseId)
+    {
+        m_pauseId = -1;
+        return;
+    }
+    for (unsigned int k=0; k<m_asyncPrompts.size(); k++)
+    {
+        if (m_asyncPrompts[k].m_id == id)
+        {
+            m_asyncPrompts[k].m_answered = true;
+            m_asyncPrompts[k].m_yes = yes;
+            break;
+        }
+    }
+}
+
+
+/*!
+ * @brief Writes the records of the async prompts that have been answered
+ *
+ * Each record carries the name and description of the test that posted
+ * the prompt.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::flushAsyncPrompts()
+{
+    unsigned int k = 0;
+    while (k < m_asyncPrompts.size())
+    {
+        asyncPrompt_t prompt = m_asyncPrompts[k];
+        if (!prompt.m_answered)
+        {
+            k++;
+            continue;
+        }
+        m_asyncPrompts.erase(m_asyncPrompts.begin()+k);
+
+        QString currentTest = m_currentTest;
+        QString currentDesc = m_currentDesc;
+        m_currentTest = prompt.m_testName;
+        m_currentDesc = prompt.m_testDesc;
+
+        generateTestHeader();
+        logStringBlack("Nominal: \"YES\"");
+        if (!prompt.m_yes)
+        {
+            logStringRed("Value: \"NO\"");
+            logStringRed("Result: FAIL");
+            logStringRed("FailDesc: failed operator inspection");
+            if (std::find(m_asyncFailedTests.begin(), m_asyncFailedTests.end(), prompt.m_testIndex) == m_asyncFailedTests.end())
+            {
+                m_asyncFailedTests.push_back(prompt.m_testIndex);
+            }
+        }
+        else
+        {
+            logStringBlack("Value: \"YES\"");
+            logStringBlack("Result: PASS");
+        }
+        generateTestTrailer();
+
+        m_currentTest = currentTest;
+        m_currentDesc = currentDesc;
+    }
+}
+
+
+/*!
+ * @brief Forgets all async prompts and their answers
+ *
+ * Called at the start of a run and when a run is aborted.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::cancelAsyncPrompts()
+{
+    m_asyncPrompts.clear();
+    m_asyncFailedTests.clear();
+}
+
+
+/*!
+ * @brief Returns the reorder group of a test
+ *
+ * @param[in] n - number of the test
+ * @return the group name, empty if the test is not in a group
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString CTestScript::getTestGroup(unsigned int n)
+{
+    if (n >= m_testGroups.size())
+    {
+        return(QString());
+    }
+    return(m_testGroups[n]);
+}
+
+
+/*!
+ * @brief Writes the record of a test that was skipped
+ *
+ * @param[in] n - number of the test
+ * @param[in] reason - why the test was not run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::reportNotRun(unsigned int n, const QString &reason)
+{
+    int firstCommand, lastCommand;
+    if (!getTestCommandRange(n, firstCommand, lastCommand))
+    {
+        return;
+    }
+
+    m_currentTest = m_commandList[firstCommand].m_stringArg;
+    m_currentDesc.clear();
+    m_currentUnits.clear();
+    for (int i=firstCommand; i<lastCommand; i++)
+    {
+        if (m_commandList[i].m_type == CCommand::CMD_DESC)
+        {
+            m_currentDesc = m_commandList[i].m_stringArg;
+            break;
+        }
+    }
+
+    generateTestHeader();
+    logStringRed("Result: NOT_RUN");
+    QString line = "FailDesc: " + reason;
+    logStringRed(line.toLocal8Bit());
+    generateTestTrailer();
+}
+
+/*!
+ * @brief Returns the next command that is not a comment or test annotation
+ *
+ * @param[in] i - index of the first command to consider
+ * @param[in] lastCommand - index one past the last command of the test
+ * @return the index of the command, -1 if there is none
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestScript::nextActiveCommand(int i, int lastCommand)
+{
+    for ( ; i<lastCommand; i++)
+    {
+        CCommand::commandType_t type = m_commandList[i].m_type;
+        if (  (type != CCommand::CMD_COMMENT) && (type != CCommand::CMD_UNITS)
+           && (type != CCommand::CMD_DESC) && (type != CCommand::CMD_REQUIRES)
+           && (type != CCommand::CMD_GROUP) )
+        {
+            return(i);
+        }
+    }
+    return(-1);
+}
+
+
+/*!
+ * @brief Reports if a fixture reply is used by the commands after a sendline_b
+ *
+ * @param[in] i - index of the command after the sendline_b
+ * @param[in] lastCommand - index one past the last command of the test
+ * @return true if the next command (other than sleeps) reads from the fixture or tests a reply
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::replyIsUsed(int i, int lastCommand)
+{
+    int next = nextActiveCommand(i, lastCommand);
+    while ((next >= 0) && (m_commandList[next].m_type == CCommand::CMD_SLEEP))
+    {
+        next = nextActiveCommand(next+1, lastCommand);
+    }
+    if (next < 0)
+    {
+        return(false);
+    }
+
+    const CCommand *pCommand = &m_commandList[next];
+    switch (pCommand->m_type)
+    {
+    case CCommand::CMD_READLINE_B:
+        return(true);
+    case CCommand::CMD_WAITFOR:
+        return(pCommand->params_WAITFOR.m_channelIndex == 1);
+    case CCommand::CMD_READBLOCK:
+        return(pCommand->params_READBLOCK.m_channelIndex == 1);
+    default:
+        return(pCommand->isExpect());
+    }
+}
+
+
+/*!
+ * @brief Starts a new send/read/expect group at a sendline command
+ *
+ * The group is what is run again when its reply is missing or unreadable.
+ * A "retry ... once" applies to the group that follows it, otherwise the
+ * retry policy of the test (or of the script) is used.
+ *
+ * @param[in] i - index of the sendline command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::startGroup(int i)
+{
+    m_replyChecked = false;
+    if (m_retrying && (i == m_groupStart))
+    {
+        m_retrying = false;
+        return;
+    }
+
+    m_retrying = false;
+    m_groupStart = i;
+    m_groupRetries = 0;
+    m_groupErrorAtStart = m_errorEncountered;
+    if (m_onceRetries >= 0)
+    {
+        m_groupRetryLimit = m_onceRetries;
+        m_groupBackoff_ms = m_onceBackoff_ms;
+        m_onceRetries = -1;
+    }
+    else
+    {
+        m_groupRetryLimit = m_testRetries;
+        m_groupBackoff_ms = m_testBackoff_ms;
+    }
+}
+
+
+/*!
+ * @brief Runs the current group again if the retry policy allows it
+ *
+ * The error state is restored to what it was at the start of the group
+ * and the loop index is moved back so that the sendline is the next command.
+ *
+ * @param[in,out] i - index of the current command
+ * @param[in] reason - why the group is retried (for the log)
+ * @return true if the group will be retried
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::retryGroup(int &i, const char *reason)
+{
+    if ((m_groupStart < 0) || (m_groupRetries >= m_groupRetryLimit))
+    {
+        return(false);
+    }
+    if (CAbort::Instance()->abortRequested())
+    {
+        return(false);
+    }
+
+    m_groupRetries++;
+    int port = (m_commandList[m_groupStart].m_type == CCommand::CMD_SENDLINE_A) ? 0 : 1;
+    m_retryCount[port]++;
+
+    char msg[500];
+    sprintf(msg, "Retry %d of %d: %s", m_groupRetries, m_groupRetryLimit, reason);
+    logStringGray(msg);
+    if (m_groupBackoff_ms > 0)
+    {
+        QEventLoop loop;
+        QTimer::singleShot(m_groupBackoff_ms, &loop, SLOT(quit()));
+        loop.exec();
+    }
+
+    m_errorEncountered = m_groupErrorAtStart;
+    m_skipSettleSleep = false;
+    m_deferredSleep_ms = 0;
+    m_retrying = true;
+    i = m_groupStart - 1;   // the loop increments i
+    return(true);
+}
+
+
+/*!
+ * @brief Reports if the echo of a sendline shows the command was corrupted
+ *
+ * Only an echo that was received and differs from the command counts;
+ * a missing echo is not treated as corruption.
+ *
+ * @param[in] pCommand - the sendline command
+ * @return true if the echo in the response buffer does not contain the command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::echoIsGarbled(const CCommand *pCommand)
+{
+    QString echo = QString(m_responseBuffer).trimmed();
+    if (echo.isEmpty())
+    {
+        return(false);
+    }
+    return(!echo.contains(substitutePosition(pCommand->getTransmitString()), Qt::CaseInsensitive));
+}
+
+
+/*!
+ * @brief Checks the reply against all of the expects that test it
+ *
+ * Only the first expect after a reply checks it; the expects that follow
+ * it directly (testing other fields of the same reply) are checked at the
+ * same time so that no record is written for a reply that is retried.
+ * A value that is read but is outside the limits is usable.
+ *
+ * @param[in] i - index of the expect command
+ * @param[in] lastCommand - index one past the last command of the test
+ * @return false if a field is missing or can not be read
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::replyIsUsable(int i, int lastCommand)
+{
+    if (m_replyChecked)
+    {
+        return(true);
+    }
+    m_replyChecked = true;
+
+    QStringList args = QString(m_responseBuffer).trimmed().split(QRegExp(" "), QString::SkipEmptyParts);
+    for (int k=i; (k >= 0) && (k < lastCommand); k=nextActiveCommand(k+1, lastCommand))
+    {
+        const CCommand *pCommand = &m_commandList[k];
+        switch (pCommand->m_type)
+        {
+        case CCommand::CMD_EXPECT:
+        case CCommand::CMD_EXPECT_AVG:
+        case CCommand::CMD_EXPECT_STATS:
+            {
+                bool ok = false;
+                if (pCommand->m_argNumber <= args.size())
+                {
+                    args[pCommand->m_argNumber-1].toDouble(&ok);
+                }
+                if (!ok)
+                    return(false);
+                break;
+            }
+        case CCommand::CMD_EXPECT_CHAR:
+            if (  (pCommand->m_argNumber > args.size())
+               || (pCommand->m_charNumber > args[pCommand->m_argNumber-1].size()) )
+                return(false);
+            break;
+        case CCommand::CMD_EXPECT_STR:
+            if (pCommand->m_argNumber > args.size())
+                return(false);
+            break;
+        default:
+            return(true);
+        }
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Adds the number of retries of the group to the test record
+ *
+ * Once a record has been written for a group the group can not be
+ * run again (the record would be duplicated).
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::logRetries()
+{
+    m_groupStart = -1;
+    if (m_groupRetries > 0)
+    {
+        char msg[100];
+        sprintf(msg, "Retries: %d", m_groupRetries);
+        logStringBlack(msg);
+    }
+}
+
+
+/*!
+ * @brief Reads a reply for a readline command
+ *
+ * Normally this is a read with the timeout of the port.  If the sleep before
+ * the readline was replaced by an adaptive wait, the read waits for up to the
+ * time the script would have taken without adaptive timeouts.  The latency of
+ * every reply is added to the history of the readline, and a reply later than
+ * the history expects is logged as late.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @param[in] pCommand - the readline command
+ * @return true if a reply was read, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::readReply(int portIndex, CCommand *pCommand)
+{
+    int timeout_ms = (portIndex == 0) ? m_timeoutA_ms : m_timeoutB_ms;
+    if (!m_adaptiveTimeouts || (m_deferredSleep_ms <= 0))
+    {
+        return(readVapoThermResponse(portIndex, m_responseBuffer, sizeof(m_responseBuffer), timeout_ms));
+    }
+
+    int hardLimit_ms = m_deferredSleep_ms + timeout_ms;
+    int expected_ms = -1;
+    m_deferredSleep_ms = 0;
+    if (m_latencyHistory.getSampleCount(m_scriptName, m_currentTest, pCommand->m_lineNumber) >= m_adaptiveMinSamples)
+    {
+        expected_ms = m_latencyHistory.getPercentile(m_scriptName, m_currentTest, pCommand->m_lineNumber, 99.9) + m_adaptiveMargin_ms;
+    }
+
+    //
+    // A late reply still passes; only the hard limit fails the readline
+    //
+    QTime t;
+    t.start();
+    if (!readVapoThermResponse(portIndex, m_responseBuffer, sizeof(m_responseBuffer), hardLimit_ms))
+    {
+        return(false);
+    }
+
+    int latency_ms = m_sendTimeValid[portIndex] ? m_sendTime[portIndex].elapsed() : t.elapsed();
+    m_latencyHistory.addSample(m_scriptName, m_currentTest, pCommand->m_lineNumber, latency_ms);
+    if ((expected_ms >= 0) && (latency_ms > expected_ms))
+    {
+        char msg[200];
+        sprintf(msg, "Reply was late: %d ms (expected within %d ms, hard limit %d ms)", latency_ms, expected_ms, hardLimit_ms);
+        logStringGray(msg);
+    }
+    return(true);
+}
+
+
+
+/*!
+ * @brief Runs the two branches of a parallel block at the same time
+ *
+ * Each branch uses its own port.  The branches are stepped in turn without
+ * blocking: a sendline is paced out by the main window while the other branch
+ * goes on, and a readline only takes a reply once a whole line has arrived.
+ * A reply read by a branch is only seen by the expects of that branch.
+ * Each branch keeps its own error; with terminate on error a branch stops at
+ * its first error and the other branch still runs to the join.
+ *
+ * @param[in,out] i - index of the parallel command, set to the closing "}"
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::runParallel(int &i)
+{
+    CCommand *pCommand = &m_commandList[i];
+    logStringGray(pCommand->m_line.toLocal8Bit());
+
+    branch_t branches[2];
+    branches[0].m_next = i + 1;
+    branches[0].m_end = pCommand->m_argInteger;
+    branches[1].m_next = pCommand->m_argInteger + 1;
+    branches[1].m_end = pCommand->m_argInteger2;
+    for (int b=0; b<2; b++)
+    {
+        branches[b].m_state = BRANCH_NEXT;
+        branches[b].m_command = -1;
+        branches[b].m_port = -1;
+        branches[b].m_error = false;
+        branches[b].m_reply[0] = '\0';
+        for (int k=branches[b].m_next; (k<branches[b].m_end) && (branches[b].m_port < 0); k++)
+        {
+            switch (m_commandList[k].m_type)
+            {
+            case CCommand::CMD_SENDLINE_A:
+            case CCommand::CMD_READLINE_A:
+            case CCommand::CMD_FLUSH_A:
+                branches[b].m_port = 0;
+                break;
+            case CCommand::CMD_SENDLINE_B:
+            case CCommand::CMD_READLINE_B:
+            case CCommand::CMD_FLUSH_B:
+                branches[b].m_port = 1;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    //
+    // A group can not be retried across the block
+    //
+    m_groupStart = -1;
+    m_groupRetries = 0;
+
+    bool aborted = false;
+    while ((branches[0].m_state != BRANCH_DONE) || (branches[1].m_state != BRANCH_DONE))
+    {
+        if (CAbort::Instance()->abortRequested())
+        {
+            aborted = true;
+            break;
+        }
+
+        bool busy = false;
+        for (int b=0; b<2; b++)
+        {
+            if (branches[b].m_state != BRANCH_DONE)
+            {
+                busy |= stepBranch(branches[b]);
+            }
+        }
+
+        //
+        // Wait a little when both branches are waiting on a port or a sleep
+        //
+        qApp->processEvents();
+        if (!busy)
+        {
+            QEventLoop loop;
+            QTimer::singleShot(1, &loop, SLOT(quit()));
+            loop.exec();
+        }
+    }
+
+    //
+    // Join: report the error of each branch
+    //
+    for (int b=0; b<2; b++)
+    {
+        char msg[500];
+        const char *portName = (branches[b].m_port == 1) ? "B" : "A";
+        if (aborted && (branches[b].m_state != BRANCH_DONE))
+        {
+            sprintf(msg, "parallel: branch %d (port %s) aborted", b+1, portName);
+            logStringRed(msg);
+            if (branches[b].m_port == 1)
+            {
+                m_fixtureState.invalidate();
+            }
+        }
+        else if (branches[b].m_error)
+        {
+            sprintf(msg, "parallel: branch %d (port %s) failed: %s", b+1, portName,
+                    branches[b].m_errorDesc.toLocal8Bit().data());
+            logStringRed(msg);
+            m_errorEncountered = true;
+        }
+        else
+        {
+            sprintf(msg, "parallel: branch %d (port %s) done", b+1, portName);
+            logStringGray(msg);
+        }
+    }
+    if (aborted)
+    {
+        m_errorEncountered = true;
+    }
+
+    m_responseBuffer[0] = '\0';
+    m_replyChecked = false;
+    m_lastSendPort = -1;
+    m_replyGap_ms = 0;
+    m_deferredSleep_ms = 0;
+    m_skipSettleSleep = false;
+    i = pCommand->m_argInteger2;
+}
+
+
+/*!
+ * @brief Moves a branch of a parallel block along without blocking
+ *
+ * @param[in,out] branch - the branch
+ * @return true if the branch did something, false if it is waiting
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::stepBranch(branch_t &branch)
+{
+    switch (branch.m_state)
+    {
+    case BRANCH_SENDING:
+        {
+            int status = pollVapoThermOutput(branch.m_port);
+            if (status == 0)
+            {
+                return(false);
+            }
+            if (status < 0)
+            {
+                branch.m_sent = false;
+            }
+            branch.m_reply[0] = '\0';
+            branch.m_timer.start();
+            branch.m_wait_ms = (branch.m_port == 0) ? m_timeoutA_ms : m_timeoutB_ms;
+            branch.m_state = BRANCH_ECHO;
+            return(true);
+        }
+
+    case BRANCH_ECHO:
+        {
+            bool echoed = pollVapoThermResponse(branch.m_port, branch.m_reply, sizeof(branch.m_reply));
+            if (!echoed && (branch.m_timer.elapsed() < branch.m_wait_ms))
+            {
+                return(false);
+            }
+            if (!echoed)
+            {
+                readTimedOut(branch.m_port);
+            }
+            logReply(branch.m_reply);
+            if (branch.m_port == 1)
+            {
+                QString fixtureCommand = substitutePosition(m_commandList[branch.m_command].getTransmitString());
+                if (branch.m_sent && echoed)
+                {
+                    m_fixtureState.commandSent(fixtureCommand);
+                }
+                else
+                {
+                    m_fixtureState.invalidate();
+                }
+            }
+            if (!branch.m_sent)
+            {
+                branchFailed(branch, "failed to send " + m_commandList[branch.m_command].getTransmitString());
+            }
+            if (branch.m_state != BRANCH_DONE)
+            {
+                branch.m_state = BRANCH_NEXT;
+            }
+            return(true);
+        }
+
+    case BRANCH_READING:
+        {
+            if (pollVapoThermResponse(branch.m_port, branch.m_reply, sizeof(branch.m_reply)))
+            {
+                logReply(branch.m_reply);
+                branch.m_state = BRANCH_NEXT;
+                return(true);
+            }
+            if (branch.m_timer.elapsed() < branch.m_wait_ms)
+            {
+                return(false);
+            }
+            branch.m_reply[0] = '\0';
+            readTimedOut(branch.m_port);
+            logStringGray("Failed to read from device or fixture");
+            if (branch.m_port == 1)
+            {
+                m_fixtureState.invalidate();
+            }
+            branchFailed(branch, "no reply on line " + QString::number(m_commandList[branch.m_command].m_lineNumber+1));
+            if (branch.m_state != BRANCH_DONE)
+            {
+                branch.m_state = BRANCH_NEXT;
+            }
+            return(true);
+        }
+
+    case BRANCH_SLEEPING:
+        {
+            if (branch.m_timer.elapsed() < branch.m_wait_ms)
+            {
+                return(false);
+            }
+            branch.m_state = BRANCH_NEXT;
+            return(true);
+        }
+
+    case BRANCH_DONE:
+        return(false);
+
+    case BRANCH_NEXT:
+    default:
+        break;
+    }
+
+    if (branch.m_next >= branch.m_end)
+    {
+        branch.m_state = BRANCH_DONE;
+        return(true);
+    }
+
+    int i = branch.m_next++;
+    CCommand *pCommand = &m_commandList[i];
+    branch.m_command = i;
+    switch (pCommand->m_type)
+    {
+    case CCommand::CMD_SENDLINE_A:
+    case CCommand::CMD_SENDLINE_B:
+        logCommand(pCommand->m_stringArg.toLocal8Bit());
+        if (m_sharedFixture && (branch.m_port == 1) && pCommand->m_stringArg.contains("%POS%"))
+        {
+            fixtureSelection(pCommand->getTransmitString());
+        }
+        branch.m_sent = startVapoThermCommand(branch.m_port, substitutePosition(pCommand->getTransmitString()).toLocal8Bit());
+        branch.m_state = BRANCH_SENDING;
+        break;
+
+    case CCommand::CMD_READLINE_A:
+    case CCommand::CMD_READLINE_B:
+        branch.m_reply[0] = '\0';
+        branch.m_timer.start();
+        branch.m_wait_ms = (branch.m_port == 0) ? m_timeoutA_ms : m_timeoutB_ms;
+        branch.m_state = BRANCH_READING;
+        break;
+
+    case CCommand::CMD_FLUSH_A:
+    case CCommand::CMD_FLUSH_B:
+        flushIncomingData(branch.m_port);
+        break;
+
+    case CCommand::CMD_SLEEP:
+        {
+            int sleep_ms = pCommand->m_argInteger;
+            std::map<int, int>::iterator it = m_sleepOverrides.find(i);
+            if (it != m_sleepOverrides.end())
+            {
+                sleep_ms = it->second;
+            }
+            logStringGray(pCommand->m_line.toLocal8Bit());
+            branch.m_timer.start();
+            branch.m_wait_ms = sleep_ms;
+            branch.m_state = BRANCH_SLEEPING;
+            break;
+        }
+
+    case CCommand::CMD_UNITS:
+        m_currentUnits = pCommand->m_stringArg;
+        break;
+
+    case CCommand::CMD_EXPECT:
+    case CCommand::CMD_EXPECT_CHAR:
+    case CCommand::CMD_EXPECT_STR:
+        {
+            //
+            // The expect is tested against the reply of this branch and
+            // its error is kept with the branch
+            //
+            bool errorEncountered = m_errorEncountered;
+            m_errorEncountered = false;
+            strcpy(m_responseBuffer, branch.m_reply);
+            if (pCommand->m_type == CCommand::CMD_EXPECT)
+            {
+                expectField(i, pCommand);
+            }
+            else if (pCommand->m_type == CCommand::CMD_EXPECT_CHAR)
+            {
+                expectChar(i, pCommand);
+            }
+            else
+            {
+                expectString(i, pCommand);
+            }
+            if (m_errorEncountered)
+            {
+                branchFailed(branch, "expect failed on line " + QString::number(pCommand->m_lineNumber+1));
+            }
+            m_errorEncountered = errorEncountered;
+            break;
+        }
+
+    case CCommand::CMD_COMMENT:
+    default:
+        if (pCommand->m_line.length() > 0)
+        {
+            logStringGray(pCommand->m_line.toLocal8Bit());
+        }
+        break;
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Records the error of a branch of a parallel block
+ *
+ * Only the first error of the branch is kept.  With terminate on error
+ * the branch runs no more commands.
+ *
+ * @param[in,out] branch - the branch
+ * @param[in] desc - description of the error
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::branchFailed(branch_t &branch, const QString &desc)
+{
+    if (!branch.m_error)
+    {
+        branch.m_error = true;
+        branch.m_errorDesc = desc;
+    }
+    if (m_terminateOnError)
+    {
+        branch.m_state = BRANCH_DONE;
+    }
+}
+
+
+
+/*!
+ * @brief Runs the specified test from the currently loaded test script
+ *
+ * @param[in] n - number of test to run
+ * @return Returns a bool indicating if the tests should be aborted
+ *
+ * @author J. Peterson
+ * @date 06/22/2014
+*/
+bool CTestScript::runTest(unsigned int n)
+{
+    bool result = runCommands(n);
+
+    //
+    // A shared fixture is never held between tests
+    //
+    if (m_fixtureHeld)
+    {
+        m_fixtureHeld = false;
+        releaseFixture();
+    }
+    return(result);
+}
+
+
+/*!
+ * @brief Runs the commands of a test
+ *
+ * @param[in] n - number of test to run
+ * @return Returns a bool indicating if the tests should be aborted
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::runCommands(unsigned int n)
+{
+    m_errorEncountered = false;
+    m_terminatedEarly = false;
+    m_deferredSleep_ms = 0;
+    m_sendTimeValid[0] = false;
+    m_sendTimeValid[1] = false;
+    m_currentTestIndex = n;
+    m_lastSendPort = -1;
+    m_replyGap_ms = 0;
+    m_signal.clear();
+    m_skipSettleSleep = false;
+    m_testRetries = m_scriptRetries;
+    m_testBackoff_ms = m_scriptBackoff_ms;
+    m_onceRetries = -1;
+    m_groupStart = -1;
+    m_groupRetries = 0;
+    m_retrying = false;
+    m_replyChecked = false;
+    m_measurementTime.start();
+
+    int firstCommand, lastCommand;
+    if (!getTestCommandRange(n, firstCommand, lastCommand))
+    {
+        return(true);
+    }
+
+    for (int i=firstCommand; i<lastCommand; i++)
+    {
+        if (CAbort::Instance()->abortRequested())
+        {
+            m_errorEncountered = true;
+            m_fixtureState.invalidate();
+            return(true);
+        }
+
+        CCommand *pCommand = &m_commandList[i];
+
+        //
+        // Write the records of the async prompts answered since the last command
+        //
+        flushAsyncPrompts();
+
+        //
+        // On a panel the fixture is shared by the positions
+        //
+        if (m_sharedFixture)
+        {
+            leaseFixture(i);
+        }
+
+        //
+        // Only the sleeps right after an elided fixture command are skipped
+        //
+        if ((pCommand->m_type != CCommand::CMD_SLEEP) && (nextActiveCommand(i, i+1) == i))
+        {
+            m_skipSettleSleep = false;
+        }
+
+        switch (pCommand->m_type)
+        {
+            case CCommand::CMD_TEST:
+            {
+                m_currentTest = pCommand->m_stringArg;
+                m_currentDesc.clear();
+                m_currentUnits.clear();
+                break;
+            }
+
+            case CCommand::CMD_VERSION:
+            {
+                break;
+            }
+#if 0
+            case CCommand::CMD_TYPE:
+            {
+                QString line = "TestType: ";
+                line.append(pCommand->m_stringArg);
+                logStringBlack(line.toLocal8Bit());
+                break;
+            }
+#endif
+
+            case CCommand::CMD_DESC:
+            {
+                m_currentDesc = pCommand->m_stringArg;
+                break;
+            }
+
+            case CCommand::CMD_REQUIRES:
+            case CCommand::CMD_GROUP:
+            {
+                // resolved when the script is loaded
+                break;
+            }
+
+            case CCommand::CMD_RETRY:
+            {
+                if (pCommand->m_stringArg == "once")
+                {
+                    m_onceRetries = pCommand->m_argInteger;
+                    m_onceBackoff_ms = pCommand->m_argInteger2;
+                }
+                else
+                {
+                    m_testRetries = pCommand->m_argInteger;
+                    m_testBackoff_ms = pCommand->m_argInteger2;
+                }
+                break;
+            }
+
+            case CCommand::CMD_SLEEP:
+            {
+                //
+                // The fixture did not change so there is nothing to settle
+                //
+                m_sentSinceSleep = false;
+                if (m_skipSettleSleep)
+                {
+                    QString line = pCommand->m_line + "   (elided)";
+                    logStringGray(line.toLocal8Bit());
+                    break;
+                }
+
+                //
+                // With adaptive timeouts, a sleep that pads the wait for a reply
+                // is replaced by waiting on the readline that follows it.
+                //
+                int next = nextActiveCommand(i+1, lastCommand);
+                if ( m_adaptiveTimeouts && (next >= 0)
+                   && ( (m_commandList[next].m_type == CCommand::CMD_READLINE_A)
+                     || (m_commandList[next].m_type == CCommand::CMD_READLINE_B) ) )
+                {
+                    QString line = pCommand->m_line + "   (adaptive)";
+                    logStringGray(line.toLocal8Bit());
+                    m_deferredSleep_ms += pCommand->m_argInteger;
+                    m_replyGap_ms += pCommand->m_argInteger;
+                    break;
+                }
+
+                //
+                // The sleep tuning experiment replaces the scripted sleep time
+                //
+                int sleep_ms = pCommand->m_argInteger;
+                std::map<int, int>::iterator it = m_sleepOverrides.find(i);
+                if (it != m_sleepOverrides.end())
+                {
+                    sleep_ms = it->second;
+                    QString line = pCommand->m_line + "   (tuning: %1)";
+                    logStringGray(line.arg(sleep_ms).toLocal8Bit());
+                }
+                else
+                {
+                    logStringGray(pCommand->m_line.toLocal8Bit());
+                }
+                QEventLoop loop;
+                QTimer::singleShot(sleep_ms, &loop, SLOT(quit()));
+                loop.exec();
+                m_replyGap_ms += sleep_ms;
+                break;
+            }
+
+            case CCommand::CMD_PROMPT:
+            {
+                //
+                // Async prompts go to the operator queue and the record is
+                // written when the operator answers
+                //
+                if ((pCommand->m_argInteger == 1) || m_sharedFixture)
+                {
+                    asyncPrompt_t prompt;
+                    prompt.m_id = m_nextPromptId++;
+                    prompt.m_testIndex = m_currentTestIndex;
+                    prompt.m_testName = m_currentTest;
+                    prompt.m_testDesc = m_currentDesc;
+                    prompt.m_answered = false;
+                    prompt.m_yes = false;
+                    m_asyncPrompts.push_back(prompt);
+                    QString line = pCommand->m_line + "   (posted to operator queue)";
+                    logStringGray(line.toLocal8Bit());
+                    postOperatorPrompt(prompt.m_id, m_currentTest, pCommand->m_stringArg);
+                    break;
+                }
+
+                generateTestHeader();
+                logStringBlack("Nominal: \"YES\"");
+                QMessageBox::StandardButton reply;
+                QString title = "VapoTherm Test";
+                QString prefix = "<font size=20>";
+                QString suffix = "</font>";
+                QString line = prefix + pCommand->m_stringArg + suffix;
+                reply = QMessageBox::question(NULL, title, line, QMessageBox::Yes|QMessageBox::No);
+                if (reply == QMessageBox::No)
+                {
+                    m_errorEncountered = true;
+                    logStringRed("Value: \"NO\"");
+                    logStringRed("Result: FAIL");
+                    logStringRed("FailDesc: failed operator inspection");
+                }
+                else
+                {
+                    logStringBlack("Value: \"YES\"");
+                    logStringBlack("Result: PASS");
+                }
+                generateTestTrailer();
+                break;
+            }
+
+            case CCommand::CMD_PAUSE:
+            {
+                //
+                // On a panel the pause is answered from the operator queue
+                //
+                if (m_sharedFixture)
+                {
+                    logStringGray(pCommand->m_line.toLocal8Bit());
+                    m_pauseId = m_nextPromptId++;
+                    postOperatorPrompt(m_pauseId, m_currentTest, pCommand->m_stringArg + " (answer to continue)");
+                    while ((m_pauseId >= 0) && !CAbort::Instance()->abortRequested())
+                    {
+                        QEventLoop loop;
+                        QTimer::singleShot(10, &loop, SLOT(quit()));
+                        loop.exec();
+                    }
+                    m_pauseId = -1;
+                    break;
+                }
+
+                QString title = "VapoTherm Test";
+                QString prefix = "<font size=20>";
+                QString suffix = "</font>";
+                QString line = prefix + pCommand->m_stringArg + suffix;
                 QMessageBox::information(NULL, title, line, QMessageBox::Ok);
                 break;
             }
 
-            case CCommand::CMD_SENDLINE_A:
+            case CCommand::CMD_SENDLINE_A:
+            {
+                startGroup(i);
+                if (!sendVapoThermCommand(0, substitutePosition(pCommand->m_stringArg).toLocal8Bit()))
+                {
+                    m_errorEncountered = true;
+                }
+                m_sentSinceSleep = true;
+                logCommand(pCommand->m_stringArg.toLocal8Bit());
+                readVapoThermResponse(0, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutA_ms);
+                logReply(m_responseBuffer);
+                if (echoIsGarbled(pCommand) && retryGroup(i, "echo does not match command"))
+                {
+                    break;
+                }
+                m_sendTime[0].start();
+                m_sendTimeValid[0] = true;
+                m_lastSendPort = 0;
+                m_lastSendCommand = substitutePosition(pCommand->m_stringArg);
+                m_replyGap_ms = 0;
+                break;
+            }
+
+            case CCommand::CMD_READLINE_A:
+            {
+                qApp->processEvents();
+                m_responseBuffer[0] = '\0';
+                m_replyChecked = false;
+                if (!readReply(0, pCommand))
+                {
+                    logStringGray("Failed to read from device or fixture");
+                    if (retryGroup(i, "no reply"))
+                    {
+                        break;
+                    }
+                    m_errorEncountered = true;
+                }
+                else
+                {
+                    logReply(m_responseBuffer);
+                }
+                break;
+            }
+
+            case CCommand::CMD_SENDLINE_B:
+            {
+                //
+                // Skip fixture commands that would not change the fixture
+                // (when nothing reads a reply to them).  The sleep after it
+                // is only skipped when no command sent since the last sleep
+                // needs it to settle.
+                //
+                QString fixtureCommand = substitutePosition(pCommand->getTransmitString());
+                if ( m_elideRedundant && m_fixtureState.isInEffect(fixtureCommand)
+                   && !replyIsUsed(i+1, lastCommand) )
+                {
+                    QString line = pCommand->m_line + "   (elided: already in effect)";
+                    logStringGray(line.toLocal8Bit());
+                    m_skipSettleSleep = !m_sentSinceSleep;
+                    break;
+                }
+
+                startGroup(i);
+                if (m_sharedFixture && pCommand->m_stringArg.contains("%POS%"))
+                {
+                    fixtureSelection(pCommand->getTransmitString());
+                }
+                bool sent = sendVapoThermCommand(1, substitutePosition(pCommand->m_stringArg).toLocal8Bit());
+                if (!sent)
+                {
+                    m_errorEncountered = true;
+                }
+                m_sentSinceSleep = true;
+                logCommand(pCommand->m_stringArg.toLocal8Bit());
+                bool echoed = readVapoThermResponse(1, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutB_ms);
+                logReply(m_responseBuffer);
+                if (sent && echoed)
+                {
+                    m_fixtureState.commandSent(fixtureCommand);
+                }
+                else
+                {
+                    m_fixtureState.invalidate();
+                }
+                if (echoIsGarbled(pCommand))
+                {
+                    m_fixtureState.invalidate();
+                    if (retryGroup(i, "echo does not match command"))
+                    {
+                        break;
+                    }
+                }
+                m_sendTime[1].start();
+                m_sendTimeValid[1] = true;
+                m_lastSendPort = 1;
+                m_lastSendCommand = substitutePosition(pCommand->m_stringArg);
+                m_replyGap_ms = 0;
+                break;
+            }
+
+            case CCommand::CMD_READLINE_B:
+            {
+                qApp->processEvents();
+                m_responseBuffer[0] = '\0';
+                m_replyChecked = false;
+                if (!readReply(1, pCommand))
+                {
+                    logStringGray("Failed to read from device or fixture");
+                    m_fixtureState.invalidate();
+                    if (retryGroup(i, "no reply"))
+                    {
+                        break;
+                    }
+                    m_errorEncountered = true;
+                }
+                else
+                {
+                    logReply(m_responseBuffer);
+                }
+                break;
+            }
+
+            case CCommand::CMD_FLUSH_A:
+            {
+                flushIncomingData(0);
+                break;
+            }
+
+            case CCommand::CMD_FLUSH_B:
+            {
+                flushIncomingData(1);
+                break;
+            }
+
+            case CCommand::CMD_UNITS:
+            {
+                m_currentUnits = pCommand->m_stringArg;
+                //QString line = "Units: ";
+                //line.append(pCommand->m_stringArg);
+                //logStringGray(line);
+                break;
+            }
+
+            case CCommand::CMD_EXPECT:
+            {
+                if (!replyIsUsable(i, lastCommand) && retryGroup(i, "reply is missing or unreadable"))
+                {
+                    break;
+                }
+                expectField(i, pCommand);
+                break;
+            }
+
+        case CCommand::CMD_EXPECT_CHAR:
+            {
+                if (!replyIsUsable(i, lastCommand) && retryGroup(i, "reply is missing or unreadable"))
+                {
+                    break;
+                }
+                expectChar(i, pCommand);
+                break;
+            }
+
+        case CCommand::CMD_EXPECT_STR:
+            {
+                if (!replyIsUsable(i, lastCommand) && retryGroup(i, "reply is missing or unreadable"))
+                {
+                    break;
+                }
+                expectString(i, pCommand);
+                break;
+            }
+
+        case CCommand::CMD_EXPECT_AVG:
+        case CCommand::CMD_EXPECT_STATS:
+            {
+                if (!replyIsUsable(i, lastCommand) && retryGroup(i, "reply is missing or unreadable"))
+                {
+                    break;
+                }
+                expectStatistics(i, pCommand);
+                break;
+            }
+
+        case CCommand::CMD_READBLOCK:
             {
-                if (!sendVapoThermCommand(0, pCommand->m_stringArg.toLocal8Bit()))
+                logStringGray(pCommand->m_line.toLocal8Bit());
+                if (!readBlock(pCommand))
                 {
+                    if (retryGroup(i, "block incomplete"))
+                    {
+                        break;
+                    }
                     m_errorEncountered = true;
                 }
-                logCommand(pCommand->m_stringArg.toLocal8Bit());
-                readVapoThermResponse(0, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutA_ms);
-                logReply(m_responseBuffer);
                 break;
             }
 
-            case CCommand::CMD_READLINE_A:
+        case CCommand::CMD_EXPECT_RMS:
+        case CCommand::CMD_EXPECT_PEAK_FREQ:
+        case CCommand::CMD_EXPECT_THD:
+            {
+                expectSignal(i, pCommand);
+                break;
+            }
+
+        case CCommand::CMD_WAITFOR:
+        {
+            logStringGray(pCommand->m_line.toLocal8Bit());
+            qApp->processEvents();
+            m_errorEncountered = true;
+            int timeout = pCommand->params_WAITFOR.m_timeoutMS;
+            int channel = pCommand->params_WAITFOR.m_channelIndex;
+            QTime t;
+            t.start();
+            while (t.elapsed() < timeout)
             {
                 qApp->processEvents();
                 m_responseBuffer[0] = '\0';
-                if (!readVapoThermResponse(0, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutA_ms))
+                if (readVapoThermResponse(channel, m_responseBuffer, sizeof(m_responseBuffer), timeout))
                 {
-                    logStringGray("Failed to read from device or fixture");
-                    m_errorEncountered = true;
+                    logReply(m_responseBuffer);
+                    QString str = m_responseBuffer;
+                    if (str.contains(pCommand->params_WAITFOR.m_expectedString))
+                    {
+                        m_errorEncountered = false;
+                        break;
+                    }
                 }
-                else
+            }
+            if (m_errorEncountered)
+            {
+                logStringGray("WAITFOR: command timed out");
+            }
+            else
+            {
+                QString str = "WAITFOR: found expected string (";
+                str.append(pCommand->params_WAITFOR.m_expectedString);
+                str.append(")");
+                logStringGray(str.toLocal8Bit());
+            }
+            break;
+        }
+
+        case CCommand::CMD_PARALLEL:
+            {
+                runParallel(i);
+                break;
+            }
+
+        case CCommand::CMD_PARALLEL_NEXT:
+        case CCommand::CMD_PARALLEL_END:
+            {
+                // only reached for a block that was reported when it was loaded
+                break;
+            }
+
+        case CCommand::CMD_COMMENT:
+            {
+                if (pCommand->m_line.length() > 0)
                 {
-                    logReply(m_responseBuffer);
+                    logStringGray(pCommand->m_line.toLocal8Bit());
                 }
                 break;
             }
 
-            case CCommand::CMD_SENDLINE_B:
+        case CCommand::CMD_END_ON_ERROR:
+        {
+            if (m_errorEncountered)
+            {
+                m_terminatedEarly = true;
+                return(false);
+            }
+            break;
+        }
+
+        case CCommand::CMD_UNKNOWN:
+        default:
+            {
+                QString msg = "Unknown directive: " + pCommand->m_line;
+                logStringRed(msg.toLocal8Bit());
+                m_errorEncountered = true;
+                m_fixtureState.invalidate();
+                break;
+            }
+        }
+
+        //
+        // Give the UI a chance to update
+        //
+        qApp->processEvents();
+
+        if (m_errorEncountered && m_terminateOnError)
+        {
+            break;
+        }
+    }
+
+    return(true);
+}
+
+
+
+/*!
+ * @brief Tests that a numeric field of the reply is within limits (expect)
+ *
+ * The reply is in the response buffer.  A record is written with the result.
+ *
+ * @param[in] commandIndex - index of the expect command
+ * @param[in] pCommand - the expect command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::expectField(int commandIndex, CCommand *pCommand)
+{
+    generateTestHeader();
+    logRetries();
+    logStringGray(pCommand->m_line.toLocal8Bit());
+    QString line = m_responseBuffer;
+    line = line.trimmed();
+    QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
+    char msg[500];
+    sprintf(msg, "LowerLimit: %0.3lf", pCommand->m_argMin);
+    logStringBlack(msg);
+    sprintf(msg, "UpperLimit: %0.3lf", pCommand->m_argMax);
+    logStringBlack(msg);
+
+    bool passed = false;
+    bool valueValid = false;
+    double testNumber = 0.0;
+    if (args.size() < pCommand->m_argNumber)
+    {
+        logStringBlack("Value: none");
+        logStringRed("Result: FAIL");
+        logStringRed("FailDesc: expected field not found");
+        m_errorEncountered = true;
+    }
+    else
+    {
+        bool ok;
+        testNumber = args[pCommand->m_argNumber-1].toDouble(&ok);
+        valueValid = ok;
+        if (!ok)
+        {
+            logStringBlack("Value: none");
+            logStringRed("Result: FAIL");
+            logStringRed("FailDesc: unexpected data returned from device or fixture");
+            m_errorEncountered = true;
+        }
+        else if ((testNumber < pCommand->m_argMin) || (testNumber > pCommand->m_argMax))
+        {
+            sprintf(msg, "Value: %0.3lf", testNumber);
+            logStringBlack(msg);
+            logStringRed("Result: FAIL");
+            m_errorEncountered = true;
+        }
+        else
+        {
+            sprintf(msg, "Value: %0.3lf", testNumber);
+            logStringBlack(msg);
+            logStringBlack("Result: PASS");
+            passed = true;
+        }
+    }
+    generateTestTrailer();
+    addMeasurement(commandIndex, valueValid, testNumber, passed);
+}
+
+
+/*!
+ * @brief Tests a character of a field of the reply (expect_char)
+ *
+ * The reply is in the response buffer.  A record is written with the result.
+ *
+ * @param[in] commandIndex - index of the expect command
+ * @param[in] pCommand - the expect command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::expectChar(int commandIndex, CCommand *pCommand)
+{
+    generateTestHeader();
+    logRetries();
+    logStringGray(pCommand->m_line.toLocal8Bit());
+    QString line = m_responseBuffer;
+    line = line.trimmed();
+    QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
+    char msg[500];
+    sprintf(msg, "Nominal: \'%c\'", pCommand->m_expectedChar);
+    logStringBlack(msg);
+
+    bool passed = false;
+    if (pCommand->m_argNumber > args.size())
+    {
+        logStringBlack("Value: none");
+        logStringRed("Result: FAIL");
+        logStringRed("FailDesc: failed reading data from device or fixture");
+        m_errorEncountered = true;
+    }
+    else
+    {
+        QString *arg = &args[pCommand->m_argNumber-1];
+        int argLength = arg->size();
+        if (pCommand->m_charNumber > argLength)
+        {
+            logStringBlack("Value: none");
+            logStringRed("Result: FAIL");
+            logStringRed("FailDesc: argument length is too short");
+            m_errorEncountered = true;
+        }
+        else if (arg->toLocal8Bit()[pCommand->m_charNumber-1] != pCommand->m_expectedChar)
+        {
+            char msg[200];
+
+            char c = arg->toLocal8Bit().at(pCommand->m_charNumber-1);
+            sprintf(msg, "Value: \'%c\'", c);
+            logStringRed(msg);
+            logStringRed("Result: FAIL");
+            m_errorEncountered = true;
+        }
+        else
+        {
+            char c = arg->toLocal8Bit().at(pCommand->m_charNumber-1);
+            sprintf(msg, "Value: \'%c\'", c);
+            logStringBlack(msg);
+            logStringBlack("Result: PASS");
+            passed = true;
+        }
+    }
+    generateTestTrailer();
+    addMeasurement(commandIndex, false, 0.0, passed);
+}
+
+
+/*!
+ * @brief Tests that a field of the reply matches a string (expect_str)
+ *
+ * The reply is in the response buffer.  A record is written with the result.
+ *
+ * @param[in] commandIndex - index of the expect command
+ * @param[in] pCommand - the expect command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::expectString(int commandIndex, CCommand *pCommand)
+{
+    generateTestHeader();
+    logRetries();
+    logStringGray(pCommand->m_line.toLocal8Bit());
+    QString line = m_responseBuffer;
+    line = line.trimmed();
+    QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
+    char msg[500];
+    sprintf(msg, "Nominal: \"%s\"", pCommand->m_stringArg.toLocal8Bit().data());
+    logStringBlack(msg);
+    bool passed = false;
+    if (pCommand->m_argNumber > args.size())
+    {
+        logStringBlack("Value: none");
+        logStringRed("Result: FAIL");
+        logStringRed("FailDesc: failed to read data from device or fixture");
+        m_errorEncountered = true;
+    }
+    else
+    {
+        sprintf(msg, "Value: \"%s\"", args[pCommand->m_argNumber-1].toLocal8Bit().data());
+        logStringBlack(msg);
+        QString *arg = &args[pCommand->m_argNumber-1];
+        if (arg != pCommand->m_stringArg)
+        {
+            logStringRed("Result: FAIL");
+            logStringRed("FailDesc: expected string not found");
+            m_errorEncountered = true;
+        }
+        else
+        {
+            logStringBlack("Result: PASS");
+            passed = true;
+        }
+    }
+    generateTestTrailer();
+    addMeasurement(commandIndex, false, 0.0, passed);
+}
+
+
+/*!
+ * @brief Reports the number of test in the current script
+ *
+ * @return number of tests in script
+ *
+ * @author J. Peterson
+ * @date 06/22/2014
+*/
+int CTestScript::getTestCount()
+{
+    return(m_testList.size());
+}
+
+
+/*!
+ * @brief returns the command description/name
+ *
+ * @return returns a pointer to the QString that is the command description
+ *
+ * @author J. Peterson
+ * @date 06/22/2014
+*/
+QString *CTestScript::getTestName(unsigned int n)
+{
+    if (n >= m_testList.size())
+    {
+        return(NULL);
+    }
+
+    int commandIndex = m_testList[n];
+    return(&m_commandList[commandIndex].m_stringArg);
+}
+
+/*!
+ * @brief Records the result of an expect command for the current run
+ *
+ * @param[in] commandIndex - index of the expect command
+ * @param[in] valueValid - true if a numeric value was read
+ * @param[in] value - the value that was tested
+ * @param[in] passed - true if the expect passed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::addMeasurement(int commandIndex, bool valueValid, double value, bool passed)
+{
+    measurement_t measurement;
+    measurement.m_commandIndex = commandIndex;
+    measurement.m_testIndex = m_currentTestIndex;
+    measurement.m_valueValid = valueValid;
+    measurement.m_value = value;
+    measurement.m_passed = passed;
+    measurement.m_time = QDateTime::currentDateTime();
+    measurement.m_duration_ms = m_measurementTime.restart();
+    m_measurements.push_back(measurement);
+}
+
+
+/*!
+ * @brief Extracts a numeric field from a reply
+ *
+ * The fields are separated by spaces, the same as for the expect command.
+ *
+ * @param[in] response - the reply from the device or fixture
+ * @param[in] field - field number, starting at 1
+ * @param[out] value - the value of the field
+ * @return true if the field exists and is a number, false otherwise
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::getNumericField(const char *response, int field, double &value)
+{
+    QString line = response;
+    line = line.trimmed();
+    QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
+    if ((field < 1) || (args.size() < field))
+    {
+        return(false);
+    }
+
+    bool ok;
+    value = args[field-1].toDouble(&ok);
+    return(ok);
+}
+
+
+/*!
+ * @brief Runs the expect_avg and expect_stats commands
+ *
+ * The reply already read is the first sample.  The last sendline of the
+ * test is then resent and its reply read until the requested number of
+ * samples is taken.  The samples are not logged individually; only the
+ * statistics are written to the report.
+ *
+ * expect_avg passes when the mean is within the limits, expect_stats passes
+ * when every sample (the min and the max) is within the limits.  Both fail
+ * when fewer samples than requested were taken, after retrying the group
+ * if the retry policy allows it, and when there is no sendline to resend.
+ *
+ * @param[in,out] i - index of the command, moved back if the group is retried
+ * @param[in] pCommand - the expect_avg or expect_stats command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::expectStatistics(int &i, CCommand *pCommand)
+{
+    CRunningStats stats;
+    double value;
+    if (getNumericField(m_responseBuffer, pCommand->m_argNumber, value))
+    {
+        stats.add(value);
+    }
+
+    //
+    // Take the remaining samples
+    //
+    bool canResend = (m_lastSendPort >= 0);
+    if ((pCommand->m_argInteger > 1) && canResend)
+    {
+        int port = m_lastSendPort;
+        int timeout_ms = (port == 0) ? m_timeoutA_ms : m_timeoutB_ms;
+        QString line = "Resending \"%1\" for %2 more samples";
+        logStringGray(line.arg(m_lastSendCommand).arg(pCommand->m_argInteger-1).toLocal8Bit());
+
+        for (int k=1; k<pCommand->m_argInteger; k++)
+        {
+            if (CAbort::Instance()->abortRequested())
             {
-                if (!sendVapoThermCommand(1, pCommand->m_stringArg.toLocal8Bit()))
-                {
-                    m_errorEncountered = true;
-                }
-                logCommand(pCommand->m_stringArg.toLocal8Bit());
-                readVapoThermResponse(1, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutB_ms);
-                logReply(m_responseBuffer);
                 break;
             }
-
-            case CCommand::CMD_READLINE_B:
+            if (!sendVapoThermCommand(port, m_lastSendCommand.toLocal8Bit()))
             {
-                qApp->processEvents();
-                m_responseBuffer[0] = '\0';
-                if (!readVapoThermResponse(1, m_responseBuffer, sizeof(m_responseBuffer), m_timeoutB_ms))
-                {
-                    logStringGray("Failed to read from device or fixture");
-                    m_errorEncountered = true;
-                }
-                else
-                {
-                    logReply(m_responseBuffer);
-                }
-                break;
+                continue;
             }
-
-            case CCommand::CMD_FLUSH_A:
+            readVapoThermResponse(port, m_responseBuffer, sizeof(m_responseBuffer), timeout_ms);
+            m_responseBuffer[0] = '\0';
+            if (  readVapoThermResponse(port, m_responseBuffer, sizeof(m_responseBuffer), m_replyGap_ms + timeout_ms)
+               && getNumericField(m_responseBuffer, pCommand->m_argNumber, value) )
             {
-                flushIncomingData(0);
-                break;
+                stats.add(value);
             }
+        }
+    }
 
-            case CCommand::CMD_FLUSH_B:
+    //
+    // A missing sample could be the one out of range, the result is only
+    // judged on all of them
+    //
+    bool complete = canResend ? (stats.count() >= pCommand->m_argInteger) : (pCommand->m_argInteger <= 1);
+    if (!complete && canResend && retryGroup(i, "samples missing"))
+    {
+        return;
+    }
+
+    generateTestHeader();
+    logRetries();
+    logStringGray(pCommand->m_line.toLocal8Bit());
+    char msg[500];
+    sprintf(msg, "LowerLimit: %0.3lf", pCommand->m_argMin);
+    logStringBlack(msg);
+    sprintf(msg, "UpperLimit: %0.3lf", pCommand->m_argMax);
+    logStringBlack(msg);
+
+    bool passed = false;
+    if (stats.count() == 0)
+    {
+        logStringBlack("Value: none");
+        logStringRed("Result: FAIL");
+        logStringRed("FailDesc: expected field not found");
+    }
+    else
+    {
+        sprintf(msg, "Value: %0.3lf", stats.mean());
+        logStringBlack(msg);
+        sprintf(msg, "SampleCount: %d", stats.count());
+        logStringBlack(msg);
+        sprintf(msg, "SampleMean: %0.3lf", stats.mean());
+        logStringBlack(msg);
+        sprintf(msg, "SampleStdDev: %0.4lf", stats.stdDev());
+        logStringBlack(msg);
+        sprintf(msg, "SampleMin: %0.3lf", stats.minimum());
+        logStringBlack(msg);
+        sprintf(msg, "SampleMax: %0.3lf", stats.maximum());
+        logStringBlack(msg);
+
+        if (!complete)
+        {
+            passed = false;
+        }
+        else if (pCommand->m_type == CCommand::CMD_EXPECT_AVG)
+        {
+            passed = (stats.mean() >= pCommand->m_argMin) && (stats.mean() <= pCommand->m_argMax);
+        }
+        else
+        {
+            passed = (stats.minimum() >= pCommand->m_argMin) && (stats.maximum() <= pCommand->m_argMax);
+        }
+
+        if (passed)
+        {
+            logStringBlack("Result: PASS");
+        }
+        else
+        {
+            logStringRed("Result: FAIL");
+            if (!canResend && !complete)
             {
-                flushIncomingData(1);
-                break;
+                logStringRed("FailDesc: no sendline in the test to resend for the samples");
             }
-
-            case CCommand::CMD_UNITS:
+            else if (!complete)
             {
-                m_currentUnits = pCommand->m_stringArg;
-                //QString line = "Units: ";
-                //line.append(pCommand->m_stringArg);
-                //logStringGray(line);
-                break;
+                sprintf(msg, "FailDesc: %d of %d samples were read", stats.count(), pCommand->m_argInteger);
+                logStringRed(msg);
             }
-
-            case CCommand::CMD_EXPECT:
+            else if (pCommand->m_type == CCommand::CMD_EXPECT_STATS)
             {
-                generateTestHeader();
-                logStringGray(pCommand->m_line.toLocal8Bit());
-                QString line = m_responseBuffer;
-                line = line.trimmed();
-                QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
-                char msg[500];
-                sprintf(msg, "LowerLimit: %0.3lf", pCommand->m_argMin);
-                logStringBlack(msg);
-                sprintf(msg, "UpperLimit: %0.3lf", pCommand->m_argMax);
-                logStringBlack(msg);
-
-                if (args.size() < pCommand->m_argNumber)
-                {
-                    logStringBlack("Value: none");
-                    logStringRed("Result: FAIL");
-                    logStringRed("FailDesc: expected field not found");
-                    m_errorEncountered = true;
-                }
-                else
-                {
-                    bool ok;
-                    double testNumber = args[pCommand->m_argNumber-1].toDouble(&ok);
-                    if (!ok)
-                    {
-                        logStringBlack("Value: none");
-                        logStringRed("Result: FAIL");
-                        logStringRed("FailDesc: unexpected data returned from device or fixture");
-                        m_errorEncountered = true;
-                    }
-                    else if ((testNumber < pCommand->m_argMin) || (testNumber > pCommand->m_argMax))
-                    {
-                        sprintf(msg, "Value: %0.3lf", testNumber);
-                        logStringBlack(msg);
-                        logStringRed("Result: FAIL");
-                        m_errorEncountered = true;
-                    }
-                    else
-                    {
-                        sprintf(msg, "Value: %0.3lf", testNumber);
-                        logStringBlack(msg);
-                        logStringBlack("Result: PASS");
-                    }
-                }
-                generateTestTrailer();
-                break;
+                logStringRed("FailDesc: one or more samples out of range");
             }
+        }
+    }
 
-        case CCommand::CMD_EXPECT_CHAR:
-            {
-                generateTestHeader();
-                logStringGray(pCommand->m_line.toLocal8Bit());
-                QString line = m_responseBuffer;
-                line = line.trimmed();
-                QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
-                char msg[500];
-                sprintf(msg, "Nominal: \'%c\'", pCommand->m_expectedChar);
-                logStringBlack(msg);
+    if (!passed)
+    {
+        m_errorEncountered = true;
+    }
+    generateTestTrailer();
+    addMeasurement(i, (stats.count() > 0), stats.mean(), passed);
+}
 
-                if (pCommand->m_argNumber > args.size())
-                {
-                    logStringBlack("Value: none");
-                    logStringRed("Result: FAIL");
-                    logStringRed("FailDesc: failed reading data from device or fixture");
-                    m_errorEncountered = true;
-                }
-                else
-                {
-                    QString *arg = &args[pCommand->m_argNumber-1];
-                    int argLength = arg->size();
-                    if (pCommand->m_charNumber > argLength)
-                    {
-                        logStringBlack("Value: none");
-                        logStringRed("Result: FAIL");
-                        logStringRed("FailDesc: argument length is too short");
-                        m_errorEncountered = true;
-                    }
-                    else if (arg->toLocal8Bit()[pCommand->m_charNumber-1] != pCommand->m_expectedChar)
-                    {
-                        char msg[200];
 
-                        char c = arg->toLocal8Bit().at(pCommand->m_charNumber-1);
-                        sprintf(msg, "Value: \'%c\'", c);
-                        logStringRed(msg);
-                        logStringRed("Result: FAIL");
-                        m_errorEncountered = true;
-                    }
-                    else
-                    {
-                        char c = arg->toLocal8Bit().at(pCommand->m_charNumber-1);
-                        sprintf(msg, "Value: \'%c\'", c);
-                        logStringBlack(msg);
-                        logStringBlack("Result: PASS");
-                    }
-                }
-                generateTestTrailer();
-                break;
-            }
+/*!
+ * @brief Captures a block of samples from the fixture
+ *
+ * Text blocks are read a line at a time and every number on a line (separated
+ * by white space, commas or semicolons) is a sample.  Binary blocks are read
+ * as raw bytes.  The read ends when the block is full or a read times out.
+ *
+ * @param[in] pCommand - the readblock command
+ * @return true if the complete block was captured
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool CTestScript::readBlock(CCommand *pCommand)
+{
+    int port = pCommand->params_READBLOCK.m_channelIndex;
+    int sampleCount = pCommand->params_READBLOCK.m_sampleCount;
+    int timeout_ms = (port == 0) ? m_timeoutA_ms : m_timeoutB_ms;
 
-        case CCommand::CMD_EXPECT_STR:
-            {
-                generateTestHeader();
-                logStringGray(pCommand->m_line.toLocal8Bit());
-                QString line = m_responseBuffer;
-                line = line.trimmed();
-                QStringList args = line.split(QRegExp(" "), QString::SkipEmptyParts);
-                char msg[500];
-                sprintf(msg, "Nominal: \"%s\"", pCommand->m_stringArg.toLocal8Bit().data());
-                logStringBlack(msg);
-                if (pCommand->m_argNumber > args.size())
-                {
-                    logStringBlack("Value: none");
-                    logStringRed("Result: FAIL");
-                    logStringRed("FailDesc: failed to read data from device or fixture");
-                    m_errorEncountered = true;
-                }
-                else
-                {
-                    sprintf(msg, "Value: \"%s\"", args[pCommand->m_argNumber-1].toLocal8Bit().data());
-                    logStringBlack(msg);
-                    QString *arg = &args[pCommand->m_argNumber-1];
-                    if (arg != pCommand->m_stringArg)
-                    {
-                        logStringRed("Result: FAIL");
-                        logStringRed("FailDesc: expected string not found");
-                        m_errorEncountered = true;
-                    }
-                    else
-                    {
-                        logStringBlack("Result: PASS");
-                    }
-                }
-                generateTestTrailer();
-                break;
-            }
+    double *samples = m_signal.beginCapture(sampleCount, pCommand->params_READBLOCK.m_sampleRate);
+    if (samples == NULL)
+    {
+        logStringRed("READBLOCK: no capture buffer");
+        return(false);
+    }
 
-        case CCommand::CMD_WAITFOR:
+    int captured = 0;
+    switch (pCommand->params_READBLOCK.m_format)
+    {
+    case CCommand::BLOCK_U8:
         {
-            logStringGray(pCommand->m_line.toLocal8Bit());
-            qApp->processEvents();
-            m_errorEncountered = true;
-            int timeout = pCommand->params_WAITFOR.m_timeoutMS;
-            int channel = pCommand->params_WAITFOR.m_channelIndex;
-            QTime t;
-            t.start();
-            while (t.elapsed() < timeout)
-            {
-                qApp->processEvents();
-                m_responseBuffer[0] = '\0';
-                if (readVapoThermResponse(channel, m_responseBuffer, sizeof(m_responseBuffer), timeout))
-                {
-                    logReply(m_responseBuffer);
-                    QString str = m_responseBuffer;
-                    if (str.contains(*pCommand->params_WAITFOR.m_expectedString))
-                    {
-                        m_errorEncountered = false;
-                        break;
-                    }
-                }
-            }
-            if (m_errorEncountered)
-            {
-                logStringGray("WAITFOR: command timed out");
-            }
-            else
+            captured = readVapoThermBytes(port, &m_blockBytes[0], sampleCount, timeout_ms);
+            const unsigned char *bytes = (const unsigned char *) &m_blockBytes[0];
+            for (int k=0; k<captured; k++)
             {
-                QString str = "WAITFOR: found expected string (";
-                str.append(pCommand->params_WAITFOR.m_expectedString);
-                str.append(")");
-                logStringGray(str.toLocal8Bit());
+                samples[k] = bytes[k];
             }
             break;
         }
 
-        case CCommand::CMD_COMMENT:
-            {
-                if (pCommand->m_line.length() > 0)
-                {
-                    logStringGray(pCommand->m_line.toLocal8Bit());
-                }
-                break;
-            }
-
-        case CCommand::CMD_END_ON_ERROR:
+    case CCommand::BLOCK_S16:
         {
-            if (m_errorEncountered)
+            int byteCount = readVapoThermBytes(port, &m_blockBytes[0], 2*sampleCount, timeout_ms);
+            captured = byteCount / 2;
+            const unsigned char *bytes = (const unsigned char *) &m_blockBytes[0];
+            for (int k=0; k<captured; k++)
             {
-                m_terminatedEarly = true;
-                return(false);
+                samples[k] = (short) (bytes[2*k] | (bytes[2*k+1] << 8));
             }
             break;
         }
 
-        case CCommand::CMD_UNKNOWN:
-        default:
+    case CCommand::BLOCK_TEXT:
+    default:
+        while (captured < sampleCount)
+        {
+            if (CAbort::Instance()->abortRequested())
+            {
+                break;
+            }
+            m_responseBuffer[0] = '\0';
+            if (!readVapoThermResponse(port, m_responseBuffer, sizeof(m_responseBuffer), timeout_ms))
             {
-                QString msg = "Unknown directive: " + pCommand->m_line;
-                logStringRed(msg.toLocal8Bit());
-                m_errorEncountered = true;
                 break;
             }
+            const char *p = m_responseBuffer;
+            while ((*p != '\0') && (captured < sampleCount))
+            {
+                char *end;
+                double value = strtod(p, &end);
+                if (end == p)
+                {
+                    p++;        // skip separators and anything that is not a number
+                }
+                else
+                {
+                    samples[captured++] = value;
+                    p = end;
+                }
+            }
         }
+        break;
+    }
+    m_signal.endCapture(captured);
 
-        //
-        // Give the UI a chance to update
-        //
-        qApp->processEvents();
+    char msg[500];
+    sprintf(msg, "READBLOCK: captured %d of %d samples", captured, sampleCount);
+    if (captured < sampleCount)
+    {
+        logStringRed(msg);
+        return(false);
+    }
+    logStringGray(msg);
+    return(true);
+}
 
-        if (m_errorEncountered && m_terminateOnError)
+
+/*!
+ * @brief Tests a property of the block captured by the last readblock
+ *
+ * expect_rms tests the RMS with the mean removed, expect_peak_freq tests the
+ * frequency (Hz) of the largest peak of the spectrum and expect_thd tests the
+ * total harmonic distortion (percent, harmonics 2 through 5).
+ *
+ * @param[in] commandIndex - index of the command
+ * @param[in] pCommand - the expect_rms, expect_peak_freq or expect_thd command
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTestScript::expectSignal(int commandIndex, CCommand *pCommand)
+{
+    generateTestHeader();
+    logRetries();
+    logStringGray(pCommand->m_line.toLocal8Bit());
+    char msg[500];
+    sprintf(msg, "LowerLimit: %0.3lf", pCommand->m_argMin);
+    logStringBlack(msg);
+    sprintf(msg, "UpperLimit: %0.3lf", pCommand->m_argMax);
+    logStringBlack(msg);
+
+    bool passed = false;
+    bool valueValid = false;
+    double value = 0.0;
+    if (m_signal.getSampleCount() == 0)
+    {
+        logStringBlack("Value: none");
+        logStringRed("Result: FAIL");
+        logStringRed("FailDesc: no block captured");
+    }
+    else
+    {
+        switch (pCommand->m_type)
         {
+        case CCommand::CMD_EXPECT_RMS:
+            value = m_signal.rms();
+            valueValid = true;
+            break;
+        case CCommand::CMD_EXPECT_PEAK_FREQ:
+            value = m_signal.peakFrequency();
+            valueValid = (value > 0.0);
+            break;
+        case CCommand::CMD_EXPECT_THD:
+        default:
+            value = m_signal.thd();
+            valueValid = (value >= 0.0);
             break;
         }
+
+        if (!valueValid)
+        {
+            logStringBlack("Value: none");
+            logStringRed("Result: FAIL");
+            logStringRed("FailDesc: block could not be analyzed (sample rate not given or too few samples)");
+        }
+        else
+        {
+            sprintf(msg, "Value: %0.3lf", value);
+            logStringBlack(msg);
+            sprintf(msg, "SampleCount: %d", m_signal.getSampleCount());
+            logStringBlack(msg);
+            passed = (value >= pCommand->m_argMin) && (value <= pCommand->m_argMax);
+            if (passed)
+            {
+                logStringBlack("Result: PASS");
+            }
+            else
+            {
+                logStringRed("Result: FAIL");
+            }
+        }
     }
 
-    return(true);
+    if (!passed)
+    {
+        m_errorEncountered = true;
+    }
+    generateTestTrailer();
+    addMeasurement(commandIndex, valueValid, value, passed);
 }
 
 
+/*!
+ * @brief Reports the number of commands (script file lines) in the current script
+ *
+ * @return number of commands in script
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTestScript::getCommandCount()
+{
+    return(m_commandList.size());
+}
+
 
 /*!
- * @brief Reports the number of test in the current script
+ * @brief returns the specified command
  *
- * @return number of tests in script
+ * @param[in] i - index of the command (zero based script file line number)
+ * @return returns a pointer to the command, NULL if out of range
  *
- * @author J. Peterson
- * @date 06/22/2014
+ * @author agent
+ * @date 10/19/2026
 */
-int CTestScript::getTestCount()
+const CCommand *CTestScript::getCommand(unsigned int i)
 {
-    return(m_testList.size());
+    if (i >= m_commandList.size())
+    {
+        return(NULL);
+    }
+    return(&m_commandList[i]);
 }
 
 
 /*!
- * @brief returns the command description/name
+ * @brief returns the range of commands that make up a test
  *
- * @return returns a pointer to the QString that is the command description
+ * @param[in] n - number of the test
+ * @param[out] firstCommand - index of the "test" command
+ * @param[out] lastCommand - index one past the last command of the test
+ * @return returns false if the test does not exist
  *
- * @author J. Peterson
- * @date 06/22/2014
+ * @author agent
+ * @date 10/19/2026
 */
-QString *CTestScript::getTestName(unsigned int n)
+bool CTestScript::getTestCommandRange(unsigned int n, int &firstCommand, int &lastCommand)
 {
     if (n >= m_testList.size())
     {
-        return(NULL);
+        return(false);
     }
 
-    int commandIndex = m_testList[n];
-    return(&m_commandList[commandIndex].m_stringArg);
+    firstCommand = m_testList[n];
+    lastCommand = (n < m_testList.size()-1) ? m_testList[n+1] : m_commandList.size();
+    return(true);
 }
 
 /*!
@@ -13,14 +13,24 @@
  *  Version | Author       | Date        | Description
  *  :--:    | :-----       | :--:        | :----------
  *   1      | J. Peterson  | 02/13/2015  | initial version
+ *   2      | agent        | 10/19/2026  | budgets, adaptive timeouts, retries, fixture state, panels
  *
 */
 #ifndef TESTSCRIPT_H
 #define TESTSCRIPT_H
 #include <vector>
+#include <map>
 
 #include <QObject>
+#include <QByteArray>
+#include <QStringList>
+#include <QTime>
+#include <QDateTime>
 #include "Command.h"
+#include "LatencyHistory.h"
+#include "RunningStats.h"
+#include "SignalAnalysis.h"
+#include "FixtureState.h"
 
 
 
@@ -41,19 +51,67 @@ class CTestScript : public QObject
 {
     Q_OBJECT
 
+public:
+    /*!
+     * @brief The result of one expect command
+     */
+    struct measurement_t
+    {
+        int     m_commandIndex;   // index of the expect command
+        int     m_testIndex;      // number of the test that ran it
+        bool    m_valueValid;     // true if a numeric value was read
+        double  m_value;
+        bool    m_passed;
+        QDateTime m_time;         // when the expect finished
+        int     m_duration_ms;    // since the start of the test or the previous expect
+    };
+
 public:
     CTestScript();
     ~CTestScript();
 
     bool readScriptFile(const char *filename);
+    bool updateScriptFile(const char *filename, bool &changed, QStringList &reparsed);
+    void copyScript(const CTestScript &source);
     int  getTestCount();
     QString *getTestName(unsigned int n);
+    int  getCommandCount();
+    const CCommand *getCommand(unsigned int i);
+    bool getTestCommandRange(unsigned int n, int &firstCommand, int &lastCommand);
+    const std::vector<int> &getPrerequisites(unsigned int n);
+    QString getTestGroup(unsigned int n);
+    void reportNotRun(unsigned int n, const QString &reason);
     const QString *getScriptVersion();
     bool runTest(unsigned int n);
     bool sawError() { return(m_errorEncountered); }
     bool terminatedEarly() { return(m_terminatedEarly); }
     void terminateOnError(bool terminate) {m_terminateOnError = terminate;}
     void setTimeouts(int timeoutA_ms, int timeoutB_ms) {m_timeoutA_ms = timeoutA_ms; m_timeoutB_ms = timeoutB_ms;}
+    void setAdaptiveTimeouts(bool enable, int margin_ms, int minSamples);
+    bool loadLatencyHistory(const QString &filename) { return(m_latencyHistory.load(filename)); }
+    bool saveLatencyHistory() { return(m_latencyHistory.save()); }
+    void setSleepOverrides(const std::map<int, int> &overrides) { m_sleepOverrides = overrides; }
+    void clearSleepOverrides() { m_sleepOverrides.clear(); }
+    const std::vector<measurement_t> &getMeasurements() { return(m_measurements); }
+    void clearMeasurements() { m_measurements.clear(); }
+    bool loadFixtureProfile(const QString &filename) { return(m_fixtureState.loadProfile(filename)); }
+    void setElideRedundant(bool elide) { m_elideRedundant = elide; }
+    void invalidateFixtureState() { m_fixtureState.invalidate(); }
+    void getFixtureCommands(std::vector<QString> &commands) { m_fixtureState.getCommands(commands); }
+    bool restoreFixture(const std::vector<QString> &commands);
+    bool replyIsUsed(int i, int lastCommand);
+    int  getRetryCount(int portIndex) { return(m_retryCount[portIndex]); }
+    void clearRetryCounts() { m_retryCount[0] = 0; m_retryCount[1] = 0; }
+    int  getPendingPromptCount() { return(m_asyncPrompts.size()); }
+    void flushAsyncPrompts();
+    void cancelAsyncPrompts();
+    const std::vector<int> &getAsyncFailedTests() { return(m_asyncFailedTests); }
+    void setPosition(int position);
+    void setSharedFixture(bool shared) { m_sharedFixture = shared; }
+    void generateProgramRecords(const QString &program, const QString &programVersion, const QString &scriptFile);
+
+public slots:
+    void operatorPromptAnswered(int id, bool yes);
 
 signals:
     void logStringBlack(const char *string);
@@ -63,16 +121,59 @@ signals:
     void logReply(const char *reply);
     bool sendVapoThermCommand(int portIndex, const char *command);
     bool readVapoThermResponse(int portIndex, char *buffer, const int bufferSize, const int msTimeout);
+    int  readVapoThermBytes(int portIndex, char *buffer, const int count, const int msTimeout);
     void flushIncomingData(int portIndex);
+    bool startVapoThermCommand(int portIndex, const char *command);
+    int  pollVapoThermOutput(int portIndex);
+    bool pollVapoThermResponse(int portIndex, char *buffer, const int bufferSize);
+    void readTimedOut(int portIndex);
+    void postOperatorPrompt(int id, const QString &testName, const QString &question);
+    void acquireFixture();
+    void releaseFixture();
+    void fixtureSelection(const QString &tag);
 
 private:
+    bool readLines(const char *filename, std::vector<QByteArray> &lines);
+    void parseLine(const QByteArray &line, int i);
+    void warnUnknown(int i);
+    void findSections(const std::vector<QByteArray> &lines, std::vector<int> &starts);
+    void findSections(const std::vector<CCommand> &commands, std::vector<int> &starts);
+    QByteArray sectionHash(const std::vector<QByteArray> &lines, int first, int last);
+    void indexCommands(const std::vector<QByteArray> &lines);
     int findTestByName(QString &name);
+    int findPrecedingTestByName(const QString &name, int n);
+    void resolvePrerequisites();
+    void resolveParallelBlocks();
+    void warnParallelBlock(int i, const char *reason);
+    int nextActiveCommand(int i, int lastCommand);
+    bool runCommands(unsigned int n);
+    QString substitutePosition(const QString &text);
+    bool usesFixture(int i);
+    void leaseFixture(int i);
+    bool readReply(int portIndex, CCommand *pCommand);
+    void addMeasurement(int commandIndex, bool valueValid, double value, bool passed);
+    bool getNumericField(const char *response, int field, double &value);
+    void expectField(int commandIndex, CCommand *pCommand);
+    void expectChar(int commandIndex, CCommand *pCommand);
+    void expectString(int commandIndex, CCommand *pCommand);
+    void expectStatistics(int &i, CCommand *pCommand);
+    bool readBlock(CCommand *pCommand);
+    void expectSignal(int commandIndex, CCommand *pCommand);
+    void startGroup(int i);
+    bool retryGroup(int &i, const char *reason);
+    bool replyIsUsable(int i, int lastCommand);
+    bool echoIsGarbled(const CCommand *pCommand);
+    void logRetries();
+    void runParallel(int &i);
     void generateTestHeader();
     void generateTestTrailer();
 
 private:
     std::vector<CCommand>        m_commandList;
     std::vector<unsigned int>    m_testList;
+    std::vector<std::vector<int> > m_testPrereqs;   // tests that each test requires
+    std::vector<QString>         m_testGroups;      // reorder group of each test, empty if none
+    std::vector<QByteArray>      m_sectionHashes;   // hash of the lines before the first test, then of each test
     char                         m_responseBuffer[10*1024];   // this should be way bigger than is needed
     bool                         m_errorEncountered;
     bool                         m_terminateOnError;
@@ -83,6 +184,91 @@ private:
     QString                      m_currentTest;
     QString                      m_currentDesc;
     QString                      m_currentUnits;
+    QString                      m_scriptName;
+
+    CLatencyHistory              m_latencyHistory;
+    bool                         m_adaptiveTimeouts;
+    int                          m_adaptiveMargin_ms;
+    int                          m_adaptiveMinSamples;
+    int                          m_deferredSleep_ms;  // sleep time replaced by waiting on the next readline
+    QTime                        m_sendTime[2];       // end of the last transmit on each port
+    bool                         m_sendTimeValid[2];
+
+    int                          m_currentTestIndex;
+    std::vector<measurement_t>   m_measurements;    // results of the expect commands since last cleared
+    QTime                        m_measurementTime; // start of the current measurement
+    std::map<int, int>           m_sleepOverrides;  // command index -> sleep ms (sleep tuning only)
+
+    int                          m_lastSendPort;    // port of the last sendline, -1 if none in this test
+    QString                      m_lastSendCommand;
+    int                          m_replyGap_ms;     // scripted sleep time since the last sendline
+
+    CSignalAnalysis              m_signal;          // block captured by the last readblock
+    std::vector<char>            m_blockBytes;      // raw bytes of a binary readblock (sized at load time)
+
+    CFixtureState                m_fixtureState;
+    bool                         m_elideRedundant;  // skip fixture commands that are already in effect
+    bool                         m_skipSettleSleep; // the last fixture command was elided
+    bool                         m_sentSinceSleep;  // a command was sent since the last sleep
+
+    int                          m_scriptRetries;   // retry policy given before the first test
+    int                          m_scriptBackoff_ms;
+    int                          m_testRetries;     // retry policy of the current test
+    int                          m_testBackoff_ms;
+    int                          m_onceRetries;     // retry policy of the next group only, -1 if none
+    int                          m_onceBackoff_ms;
+    int                          m_groupStart;      // index of the sendline that started the group, -1 if none
+    int                          m_groupRetryLimit;
+    int                          m_groupBackoff_ms;
+    int                          m_groupRetries;    // retries used by the current group
+    bool                         m_groupErrorAtStart;
+    bool                         m_retrying;        // the group is being run again
+    bool                         m_replyChecked;    // the reply was checked by the first expect
+    int                          m_retryCount[2];   // retries on each port since last cleared
+
+    struct asyncPrompt_t
+    {
+        int      m_id;
+        int      m_testIndex;
+        QString  m_testName;
+        QString  m_testDesc;
+        bool     m_answered;
+        bool     m_yes;
+    };
+    std::vector<asyncPrompt_t>   m_asyncPrompts;    // posted prompts whose records are not yet written
+    std::vector<int>             m_asyncFailedTests; // tests with an async prompt answered "no"
+    int                          m_nextPromptId;
+    int                          m_pauseId;         // pause waiting on the operator queue, -1 if none
+
+    int                          m_position;        // panel position (1 when not on a panel)
+    bool                         m_sharedFixture;   // the fixture is shared by the positions of a panel
+    bool                         m_fixtureHeld;
+
+    enum branchState_t
+    {
+        BRANCH_NEXT,        // ready to run the next command
+        BRANCH_SENDING,     // the sendline is being paced out
+        BRANCH_ECHO,        // waiting for the echo of the sendline
+        BRANCH_READING,     // waiting for the reply of a readline
+        BRANCH_SLEEPING,
+        BRANCH_DONE
+    };
+    struct branch_t
+    {
+        int            m_port;       // port used by the branch, -1 if none
+        int            m_next;       // index of the next command of the branch
+        int            m_end;        // index one past the last command of the branch
+        int            m_command;    // index of the command being run
+        branchState_t  m_state;
+        QTime          m_timer;      // start of the current read or sleep
+        int            m_wait_ms;
+        bool           m_sent;
+        bool           m_error;
+        QString        m_errorDesc;  // first error of the branch
+        char           m_reply[1024];
+    };
+    bool stepBranch(branch_t &branch);
+    void branchFailed(branch_t &branch, const QString &desc);
 };
 
 #endif // TESTSCRIPT_H
@@ -0,0 +1,319 @@
+/*!
+ * @file TimeBudget.cpp
+ * @brief Implements the CTimeBudget class
+ *
+ * This class performs a static cycle-time analysis of a loaded test script
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#include <stdio.h>
+#include "TimeBudget.h"
+
+
+/*!
+ * @brief CTimeBudget constructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTimeBudget::CTimeBudget()
+{
+    m_tests.clear();
+    m_outputDelay_ms = 0;
+    m_timeoutA_ms = 0;
+    m_timeoutB_ms = 0;
+}
+
+
+/*!
+ * @brief CTimeBudget destructor
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+CTimeBudget::~CTimeBudget()
+{
+    m_tests.clear();
+}
+
+
+/*!
+ * @brief Walks the command list of the script and totals the time of each test
+ *
+ * The sendline commands are charged for the paced transmit of every character
+ * (the CR-LF terminator is written in a single call and is not paced) plus the
+ * read of the reply that follows the transmit.  Only the slower branch of a
+ * parallel block is counted.
+ *
+ * @param[in] script - the loaded script to analyze
+ * @param[in] outputDelay_ms - delay between transmitted characters
+ * @param[in] timeoutA_ms - read timeout for port A
+ * @param[in] timeoutB_ms - read timeout for port B
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTimeBudget::analyze(CTestScript *script, int outputDelay_ms, int timeoutA_ms, int timeoutB_ms)
+{
+    m_tests.clear();
+    m_outputDelay_ms = outputDelay_ms;
+    m_timeoutA_ms = timeoutA_ms;
+    m_timeoutB_ms = timeoutB_ms;
+    m_scriptVersion = *script->getScriptVersion();
+
+    int testCount = script->getTestCount();
+    for (int n=0; n<testCount; n++)
+    {
+        testBudget_t budget;
+        budget.m_name = *script->getTestName(n);
+        budget.m_sleepMS = 0;
+        budget.m_pacingMS = 0;
+        budget.m_timeoutMS = 0;
+        budget.m_waitforMS = 0;
+        budget.m_captureMS = 0;
+        budget.m_longestWaitforMS = 0;
+        budget.m_longestWaitforLine = -1;
+        budget.m_operatorSteps = 0;
+
+        int lastSendPacingMS = 0;   // for the resends of expect_avg/expect_stats
+        int lastSendTimeoutMS = 0;
+        int replyGapMS = 0;
+
+        bool inParallel = false;    // the branches of a parallel block overlap
+        testBudget_t blockStart;
+        testBudget_t firstBranch;
+
+        int firstCommand, lastCommand;
+        script->getTestCommandRange(n, firstCommand, lastCommand);
+        for (int i=firstCommand; i<lastCommand; i++)
+        {
+            const CCommand *pCommand = script->getCommand(i);
+            switch (pCommand->m_type)
+            {
+            case CCommand::CMD_SLEEP:
+                budget.m_sleepMS += pCommand->m_argInteger;
+                replyGapMS += pCommand->m_argInteger;
+                break;
+
+            case CCommand::CMD_SENDLINE_A:
+                lastSendPacingMS = pCommand->getTransmitString().size() * outputDelay_ms;
+                lastSendTimeoutMS = timeoutA_ms;
+                replyGapMS = 0;
+                budget.m_pacingMS += lastSendPacingMS;
+                budget.m_timeoutMS += timeoutA_ms;
+                break;
+
+            case CCommand::CMD_SENDLINE_B:
+                lastSendPacingMS = pCommand->getTransmitString().size() * outputDelay_ms;
+                lastSendTimeoutMS = timeoutB_ms;
+                replyGapMS = 0;
+                budget.m_pacingMS += lastSendPacingMS;
+                budget.m_timeoutMS += timeoutB_ms;
+                break;
+
+            case CCommand::CMD_EXPECT_AVG:
+            case CCommand::CMD_EXPECT_STATS:
+                //
+                // each extra sample resends the last command and waits
+                // for the echo and then for the reply
+                //
+                budget.m_pacingMS += (pCommand->m_argInteger - 1) * lastSendPacingMS;
+                budget.m_timeoutMS += (pCommand->m_argInteger - 1) * (2*lastSendTimeoutMS + replyGapMS);
+                break;
+
+            case CCommand::CMD_READLINE_A:
+                budget.m_timeoutMS += timeoutA_ms;
+                break;
+
+            case CCommand::CMD_READLINE_B:
+                budget.m_timeoutMS += timeoutB_ms;
+                break;
+
+            case CCommand::CMD_READBLOCK:
+                if (pCommand->params_READBLOCK.m_sampleRate > 0.0)
+                {
+                    budget.m_captureMS += (int) (1000.0 * pCommand->params_READBLOCK.m_sampleCount / pCommand->params_READBLOCK.m_sampleRate);
+                }
+                budget.m_timeoutMS += (pCommand->params_READBLOCK.m_channelIndex == 0) ? timeoutA_ms : timeoutB_ms;
+                break;
+
+            case CCommand::CMD_WAITFOR:
+                budget.m_waitforMS += pCommand->params_WAITFOR.m_timeoutMS;
+                if (pCommand->params_WAITFOR.m_timeoutMS > budget.m_longestWaitforMS)
+                {
+                    budget.m_longestWaitforMS = pCommand->params_WAITFOR.m_timeoutMS;
+                    budget.m_longestWaitforLine = pCommand->m_lineNumber;
+                }
+                break;
+
+            case CCommand::CMD_PARALLEL:
+                inParallel = true;
+                blockStart = budget;
+                break;
+
+            case CCommand::CMD_PARALLEL_NEXT:
+                if (inParallel)
+                {
+                    firstBranch = budget;
+                    budget = blockStart;
+                }
+                break;
+
+            case CCommand::CMD_PARALLEL_END:
+                //
+                // the block takes as long as its slower branch
+                //
+                if (inParallel && (worstCaseMS(firstBranch) > worstCaseMS(budget)))
+                {
+                    budget = firstBranch;
+                }
+                inParallel = false;
+                break;
+
+            case CCommand::CMD_PROMPT:
+            case CCommand::CMD_PAUSE:
+                budget.m_operatorSteps++;
+                break;
+
+            default:
+                break;
+            }
+        }
+        m_tests.push_back(budget);
+    }
+}
+
+
+/*!
+ * @brief Returns the guaranteed minimum time of a test
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTimeBudget::minimumMS(const testBudget_t &budget)
+{
+    return(budget.m_sleepMS + budget.m_pacingMS + budget.m_captureMS);
+}
+
+
+/*!
+ * @brief Returns the time of a test when every read and waitfor times out
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTimeBudget::worstCaseMS(const testBudget_t &budget)
+{
+    return(minimumMS(budget) + budget.m_timeoutMS + budget.m_waitforMS);
+}
+
+
+/*!
+ * @brief Returns the guaranteed minimum time of a complete run
+ *
+ * The OnAbort test is only run when a script is aborted and is
+ * not included in the total.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTimeBudget::getMinimumMS()
+{
+    int total = 0;
+    for (unsigned int i=0; i<m_tests.size(); i++)
+    {
+        if (m_tests[i].m_name != "OnAbort")
+        {
+            total += minimumMS(m_tests[i]);
+        }
+    }
+    return(total);
+}
+
+
+/*!
+ * @brief Returns the worst case time of a complete run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int CTimeBudget::getWorstCaseMS()
+{
+    int total = 0;
+    for (unsigned int i=0; i<m_tests.size(); i++)
+    {
+        if (m_tests[i].m_name != "OnAbort")
+        {
+            total += worstCaseMS(m_tests[i]);
+        }
+    }
+    return(total);
+}
+
+
+/*!
+ * @brief Formats the results of the last analysis as lines of text
+ *
+ * @param[out] lines - lines of the report are appended to this list
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void CTimeBudget::getReport(std::vector<QString> &lines)
+{
+    char msg[500];
+
+    sprintf(msg, "Cycle-time estimate: script=%s  OutputDelayMS=%d  TimeoutMS_A=%d  TimeoutMS_B=%d",
+            m_scriptVersion.toLocal8Bit().data(), m_outputDelay_ms, m_timeoutA_ms, m_timeoutB_ms);
+    lines.push_back(msg);
+    lines.push_back("   Minimum  WorstCase     Sleep    Pacing   Capture  Timeouts   Waitfor  Test");
+
+    int longestWaitforMS = 0;
+    int longestWaitforLine = -1;
+    QString longestWaitforTest;
+    int operatorSteps = 0;
+    for (unsigned int i=0; i<m_tests.size(); i++)
+    {
+        testBudget_t *pBudget = &m_tests[i];
+        sprintf(msg, "%10.3lf %10.3lf %9.3lf %9.3lf %9.3lf %9.3lf %9.3lf  %s",
+                minimumMS(*pBudget)/1000.0, worstCaseMS(*pBudget)/1000.0,
+                pBudget->m_sleepMS/1000.0, pBudget->m_pacingMS/1000.0, pBudget->m_captureMS/1000.0,
+                pBudget->m_timeoutMS/1000.0, pBudget->m_waitforMS/1000.0,
+                pBudget->m_name.toLocal8Bit().data());
+        lines.push_back(msg);
+
+        if (pBudget->m_longestWaitforMS > longestWaitforMS)
+        {
+            longestWaitforMS = pBudget->m_longestWaitforMS;
+            longestWaitforLine = pBudget->m_longestWaitforLine;
+            longestWaitforTest = pBudget->m_name;
+        }
+        operatorSteps += pBudget->m_operatorSteps;
+    }
+
+    sprintf(msg, "Whole script (excluding OnAbort): minimum %0.3lf s, worst case %0.3lf s",
+            getMinimumMS()/1000.0, getWorstCaseMS()/1000.0);
+    lines.push_back(msg);
+
+    if (longestWaitforLine >= 0)
+    {
+        sprintf(msg, "Longest waitfor: %0.3lf s on line %d (%s)",
+                longestWaitforMS/1000.0, longestWaitforLine+1, longestWaitforTest.toLocal8Bit().data());
+        lines.push_back(msg);
+    }
+
+    if (operatorSteps > 0)
+    {
+        sprintf(msg, "Operator steps (prompt/pause) not included in the estimate: %d", operatorSteps);
+        lines.push_back(msg);
+    }
+}
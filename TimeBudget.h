@@ -0,0 +1,72 @@
+/*!
+ * @file TimeBudget.h
+ * @brief Declares the CTimeBudget class
+ *
+ * This class performs a static cycle-time analysis of a loaded test script
+ *
+ * @author    	agent
+ * @date        10/19/2026
+ * @copyright	(C) Copyright Enercon Technologies 2026, All rights reserved.
+ *
+ * Revision History
+ * ----------------
+ *  Version | Author       | Date        | Description
+ *  :--:    | :-----       | :--:        | :----------
+ *   1      | agent        | 10/19/2026  | initial version
+ *
+*/
+#ifndef TIMEBUDGET_H
+#define TIMEBUDGET_H
+
+#include <vector>
+#include <QString>
+#include "TestScript.h"
+
+/*!
+ * @brief This class estimates the run time of a test script
+ *
+ * The estimate is built from the parsed command list without touching
+ * the serial ports.  For each test the guaranteed minimum time (sleeps
+ * plus transmit pacing) and the worst case time (minimum plus every
+ * read timing out) are computed.
+ *
+ * @date 10/19/2026
+ * @author agent
+ */
+class CTimeBudget
+{
+public:
+    struct testBudget_t
+    {
+        QString  m_name;
+        int      m_sleepMS;          // sum of the sleep commands
+        int      m_pacingMS;         // characters transmitted * output delay
+        int      m_timeoutMS;        // sum of the read timeouts
+        int      m_waitforMS;        // sum of the waitfor timeouts
+        int      m_captureMS;        // duration of the readblock captures (when the rate is given)
+        int      m_longestWaitforMS; // longest single waitfor
+        int      m_longestWaitforLine;
+        int      m_operatorSteps;    // prompt and pause commands (not estimated)
+    };
+
+    CTimeBudget();
+    ~CTimeBudget();
+
+    void analyze(CTestScript *script, int outputDelay_ms, int timeoutA_ms, int timeoutB_ms);
+    void getReport(std::vector<QString> &lines);
+    int  getMinimumMS();
+    int  getWorstCaseMS();
+
+private:
+    int minimumMS(const testBudget_t &budget);
+    int worstCaseMS(const testBudget_t &budget);
+
+private:
+    std::vector<testBudget_t>  m_tests;
+    QString                    m_scriptVersion;
+    int                        m_outputDelay_ms;
+    int                        m_timeoutA_ms;
+    int                        m_timeoutB_ms;
+};
+
+#endif // TIMEBUDGET_H
@@ -7,6 +7,7 @@
 QT       += core gui
 QT       += serialport
 QT       += sql
+QT       += network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -18,11 +19,59 @@ SOURCES += main.cpp\
     mainwindow.cpp \
     TestScript.cpp \
     Abort.cpp \
-    Command.cpp
+    Command.cpp \
+    TimeBudget.cpp \
+    LatencyHistory.cpp \
+    SleepTuner.cpp \
+    RunningStats.cpp \
+    SignalAnalysis.cpp \
+    TestHistory.cpp \
+    FixtureState.cpp \
+    TestReorder.cpp \
+    OperatorQueue.cpp \
+    SerialChannel.cpp \
+    FixtureArbiter.cpp \
+    PanelPosition.cpp \
+    RunCheckpoint.cpp \
+    TestReport.cpp \
+    MeasurementStore.cpp \
+    ReportIndexer.cpp \
+    SpcHistory.cpp \
+    GoldenUnit.cpp \
+    StationMetrics.cpp \
+    MetricsServer.cpp \
+    RemoteControl.cpp \
+    SerialValidator.cpp \
+    ReportSpooler.cpp \
+    ScriptLibrary.cpp
 
 HEADERS  += mainwindow.h \
     TestScript.h \
     Abort.h \
-    Command.h
+    Command.h \
+    TimeBudget.h \
+    LatencyHistory.h \
+    SleepTuner.h \
+    RunningStats.h \
+    SignalAnalysis.h \
+    TestHistory.h \
+    FixtureState.h \
+    TestReorder.h \
+    OperatorQueue.h \
+    SerialChannel.h \
+    FixtureArbiter.h \
+    PanelPosition.h \
+    RunCheckpoint.h \
+    TestReport.h \
+    MeasurementStore.h \
+    ReportIndexer.h \
+    SpcHistory.h \
+    GoldenUnit.h \
+    StationMetrics.h \
+    MetricsServer.h \
+    RemoteControl.h \
+    SerialValidator.h \
+    ReportSpooler.h \
+    ScriptLibrary.h
 
 FORMS    += mainwindow.ui
@@ -1,11 +1,166 @@
 #include "mainwindow.h"
+#include <stdio.h>
 #include <QApplication>
+#include <QSettings>
+#include <QStringList>
+#include "TestScript.h"
+#include "TimeBudget.h"
+#include "TestReorder.h"
+
+/*!
+ * @brief Command line cycle-time estimate of a script
+ *
+ *     VapothermTest --estimate <script file> [output file]
+ *
+ * The serial parameters are taken from the ini file.  The report is
+ * written to stdout and, if given, to the output file.
+ *
+ * @return exit code for the process
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+static int estimateScript(const QStringList &args)
+{
+    if (args.size() < 3)
+    {
+        fprintf(stderr, "usage: %s --estimate <script file> [output file]\n", args[0].toLocal8Bit().data());
+        return(1);
+    }
+
+    QSettings settings("VapothermTest.ini", QSettings::IniFormat);
+    int outputDelay_ms = settings.value("Serial/OutputDelayMS", 120).toInt();
+    int timeoutA_ms = settings.value("Serial/TimeoutMS_A", 100).toInt();
+    int timeoutB_ms = settings.value("Serial/TimeoutMS_B", 100).toInt();
+
+    CTestScript script;
+    if (!script.readScriptFile(args[2].toLocal8Bit()))
+    {
+        fprintf(stderr, "could not read script file: %s\n", args[2].toLocal8Bit().data());
+        return(1);
+    }
+
+    CTimeBudget budget;
+    budget.analyze(&script, outputDelay_ms, timeoutA_ms, timeoutB_ms);
+    std::vector<QString> lines;
+    budget.getReport(lines);
+
+    FILE *fp = NULL;
+    if (args.size() >= 4)
+    {
+        fp = fopen(args[3].toLocal8Bit().data(), "w");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "could not create output file: %s\n", args[3].toLocal8Bit().data());
+            return(1);
+        }
+    }
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        printf("%s\n", lines[i].toLocal8Bit().data());
+        if (fp != NULL)
+        {
+            fprintf(fp, "%s\n", lines[i].toLocal8Bit().data());
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    return(0);
+}
+
+
+/*!
+ * @brief Command line reordering of the tests of a script
+ *
+ *     VapothermTest --reorder <script file> <fixture profile> <output script> [report file]
+ *
+ * The tests in each group are reordered to reduce the fixture switching
+ * time.  The report is written to stdout and, if given, to the report file.
+ *
+ * @return exit code for the process
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+static int reorderScript(const QStringList &args)
+{
+    if (args.size() < 5)
+    {
+        fprintf(stderr, "usage: %s --reorder <script file> <fixture profile> <output script> [report file]\n", args[0].toLocal8Bit().data());
+        return(1);
+    }
+
+    QSettings settings("VapothermTest.ini", QSettings::IniFormat);
+    int outputDelay_ms = settings.value("Serial/OutputDelayMS", 120).toInt();
+
+    CTestScript script;
+    if (!script.readScriptFile(args[2].toLocal8Bit()))
+    {
+        fprintf(stderr, "could not read script file: %s\n", args[2].toLocal8Bit().data());
+        return(1);
+    }
+
+    CFixtureState profile;
+    if (!profile.loadProfile(args[3]))
+    {
+        fprintf(stderr, "could not read fixture profile: %s\n", args[3].toLocal8Bit().data());
+        return(1);
+    }
+
+    CTestReorder reorder;
+    reorder.optimize(&script, profile, outputDelay_ms);
+    if (!reorder.writeReorderedScript(args[2], args[4]))
+    {
+        fprintf(stderr, "could not create output script: %s\n", args[4].toLocal8Bit().data());
+        return(1);
+    }
+    std::vector<QString> lines;
+    reorder.getReport(lines);
+
+    FILE *fp = NULL;
+    if (args.size() >= 6)
+    {
+        fp = fopen(args[5].toLocal8Bit().data(), "w");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "could not create report file: %s\n", args[5].toLocal8Bit().data());
+            return(1);
+        }
+    }
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        printf("%s\n", lines[i].toLocal8Bit().data());
+        if (fp != NULL)
+        {
+            fprintf(fp, "%s\n", lines[i].toLocal8Bit().data());
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    return(0);
+}
+
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    QStringList args = a.arguments();
+    if ((args.size() >= 2) && (args[1] == "--estimate"))
+    {
+        return(estimateScript(args));
+    }
+    if ((args.size() >= 2) && (args[1] == "--reorder"))
+    {
+        return(reorderScript(args));
+    }
+
     MainWindow w;
     w.show();
-    
+
     return a.exec();
 }
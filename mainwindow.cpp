@@ -11,9 +11,13 @@
  *  Version | Author       | Date        | Description
  *  :--:    | :-----       | :--:        | :----------
  *   1      | J. Peterson  | 02/13/2015  | initial version
+ *   2      | agent        | 10/19/2026  | metrics, remote control, auto-start, product selection
  *
 */
 #include <time.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
 #include <QLabel>
 #include <QString>
 #include <QColor>
@@ -21,6 +25,10 @@
 #include <QTimer>
 #include <QCheckBox>
 #include <QFileDialog>
+#include <QInputDialog>
+#include <QTextStream>
+#include <QTextDocumentFragment>
+#include <QJsonArray>
 #include <QSerialPortInfo>
 #include <QDateTime>
 #include <QSql>
@@ -30,8 +38,20 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "Abort.h"
+#include "TimeBudget.h"
+#include "SleepTuner.h"
+#include "TestReport.h"
+#include "ReportIndexer.h"
+#include "RunningStats.h"
+#include "StationMetrics.h"
 
 #define LOCAL_REPORT_DIRECTORY "Reports"
+#define LATENCY_HISTORY_FILE   "LatencyHistory.ini"
+#define TEST_HISTORY_FILE      "TestHistory.ini"
+#define CHECKPOINT_FILE        "RunCheckpoint.ini"
+#define SPC_HISTORY_FILE       "SpcHistory.ini"
+#define SPC_SHIFT_FILE         "SpcShiftSummary.txt"
+#define GOLDEN_UNIT_FILE       "GoldenUnit.ini"
 
 
 QString g_stringNotConnected  = "<html><head/><body><p><span style=\" font-size:8pt; font-weight:600; color:#F00000;\">NotConnected</span></p></body></html>";
@@ -67,9 +87,21 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->pushButtonStartTests->setEnabled(false);
     ui->pushButton_Abort->setEnabled(false);
 
-    m_inputBufferIndex = 0;
-    m_inputBufferCount = 0;
+    m_pendingIndex[0] = -1;
+    m_pendingIndex[1] = -1;
 
+    m_operatorQueue = new COperatorQueue(this);
+    addDockWidget(Qt::RightDockWidgetArea, m_operatorQueue);
+    m_fixtureArbiter = new CFixtureArbiter(this);
+    m_panelDone = 0;
+    m_panelFinished = 0;
+    m_panelFullRun = false;
+
+    m_scriptReloadPending = false;
+    m_scriptReloadTimer.setSingleShot(true);
+    m_scriptReloadTimer.setInterval(300);
+    connect(&m_scriptReloadTimer, SIGNAL(timeout()), this, SLOT(reloadChangedScript()));
+    connect(&m_scriptWatcher, SIGNAL(fileChanged(const QString &)), this, SLOT(scriptFileChanged(const QString &)));
 
     QList<QSerialPortInfo> commPortList = QSerialPortInfo::availablePorts();
     ui->comboBox_serialPorts_A->setEnabled(false);
@@ -113,6 +145,8 @@ MainWindow::MainWindow(QWidget *parent) :
     // Terminate on Error
     //
     m_terminateOnFirstError = m_settings->value("TerminateOnError", "false").toBool();
+    m_failFastOrdering = m_settings->value("FailFastOrdering", "false").toBool();
+    ui->actionFail_fast_ordering->setChecked(m_failFastOrdering);
     ui->actionTerminate_on_first_error->setChecked(m_terminateOnFirstError);
 
     //
@@ -123,11 +157,116 @@ MainWindow::MainWindow(QWidget *parent) :
     m_outputDelay_ms = m_settings->value("Serial/OutputDelayMS", 120).toInt();
     m_timeoutA_ms = m_settings->value("Serial/TimeoutMS_A", 100).toInt();
     m_timeoutB_ms = m_settings->value("Serial/TimeoutMS_B", 100).toInt();
+    m_adaptiveTimeouts = m_settings->value("Serial/AdaptiveTimeouts", "false").toBool();
+    m_adaptiveMargin_ms = m_settings->value("Serial/AdaptiveMarginMS", 20).toInt();
+    m_adaptiveMinSamples = m_settings->value("Serial/AdaptiveMinSamples", 100).toInt();
+    ui->actionAdaptive_timeouts->setChecked(m_adaptiveTimeouts);
+
+    //
+    // Sleep tuning experiment (golden board stations only)
+    //
+    m_sleepTuningEnabled = m_settings->value("SleepTuning/Enabled", "false").toBool();
+    m_sleepTuningRepeats = m_settings->value("SleepTuning/Repeats", 2).toInt();
+    m_sleepTuningTolerance = m_settings->value("SleepTuning/Tolerance", 0.10).toDouble();
+    m_sleepTuningMargin_pct = m_settings->value("SleepTuning/MarginPercent", 25).toInt();
+    ui->actionSleep_Tuning_Experiment->setEnabled(m_sleepTuningEnabled);
+
+    //
+    // Fixture profile used to skip redundant fixture commands
+    //
+    m_fixtureProfile = m_settings->value("Fixture/Profile", "").toString();
+    m_elideRedundant = m_settings->value("Fixture/ElideRedundant", "false").toBool();
+    if (!m_fixtureProfile.isEmpty())
+    {
+        QString profile = m_fixtureProfile;
+        if (QFileInfo(profile).isRelative())
+        {
+            profile = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath() + "/" + profile;
+        }
+        m_fixtureProfileLoaded = m_script.loadFixtureProfile(profile);
+        m_fixtureArbiter->loadProfile(profile);
+    }
+    else
+    {
+        m_fixtureProfileLoaded = false;
+    }
+
+    //
+    // Scripts of the products that are selected by serial number
+    //
+    m_productRules = m_settings->value("Products/Rules", "").toString();
+    reloadProductRules();
+
     QString portA = m_settings->value("Serial/PortA", NOT_CONNECTED).toString();
     QString portB = m_settings->value("Serial/PortB", NOT_CONNECTED).toString();
     commPortSelected_A(portA);
     commPortSelected_B(portB);
 
+    //
+    // Panel positions, each with its own DUT port (the fixture is port B)
+    //
+    int positions = m_settings->value("Panel/Positions", 0).toInt();
+    for (int i=1; i<=positions; i++)
+    {
+        QString key = "Panel/Port%1";
+        m_panelPorts.append(m_settings->value(key.arg(i), NOT_CONNECTED).toString());
+    }
+    ui->actionRun_Panel->setEnabled(!m_panelPorts.isEmpty());
+
+    //
+    // Checkpoint used to resume a run after a crash or power loss
+    //
+    m_checkpointEnabled = m_settings->value("Checkpoint/Enabled", "true").toBool();
+    m_reinitTest = m_settings->value("Checkpoint/ReinitTest", "").toString();
+
+    //
+    // Local database of the measurements
+    //
+    m_storeMeasurements = m_settings->value("Measurements/Enabled", "true").toBool();
+    m_measurementDatabase = m_settings->value("Measurements/Database", "Measurements.db").toString();
+
+    //
+    // Statistical process control of the expects
+    //
+    m_spcEnabled = m_settings->value("SPC/Enabled", "true").toBool();
+    m_spcBaselineCount = m_settings->value("SPC/BaselineCount", 25).toInt();
+    m_spcShiftStarts = m_settings->value("SPC/ShiftStarts", QStringList() << "06:00" << "14:00" << "22:00").toStringList();
+    ui->actionSPC_Summary->setEnabled(m_spcEnabled);
+    ui->actionReset_SPC_Baselines->setEnabled(m_spcEnabled);
+
+    //
+    // Golden board of the fixture
+    //
+    m_goldenSerialNumber = m_settings->value("Golden/SerialNumber", "").toString().trimmed();
+    m_goldenTolerance_pct = m_settings->value("Golden/TolerancePercent", 5.0).toDouble();
+    m_goldenAtShiftStart = m_settings->value("Golden/RequireAtShiftStart", "true").toBool();
+
+    //
+    // Metrics served to the monitoring system, port 0 turns them off
+    //
+    m_metricsPort = m_settings->value("Metrics/Port", 9109).toInt();
+
+    //
+    // Remote control by the MES, port 0 turns it off
+    //
+    m_remotePort = m_settings->value("Remote/Port", 0).toInt();
+    m_remoteAddress = m_settings->value("Remote/Address", "127.0.0.1").toString();
+    m_busy = false;
+    m_remoteRun = false;
+    m_remoteConfirm = false;
+
+    //
+    // Start the run when the fixture lid closes on a scanned unit
+    //
+    m_autoStart = m_settings->value("AutoStart/Enabled", "false").toBool();
+    m_lidCommand = m_settings->value("AutoStart/LidCommand", "").toString();
+    m_lidClosedReply = m_settings->value("AutoStart/LidClosedReply", "OK").toString();
+    m_lidSettle_ms = m_settings->value("AutoStart/LidSettleMS", 200).toInt();
+    m_lidPoll_ms = m_settings->value("AutoStart/PollMS", 250).toInt();
+    m_lidPolling = false;
+    m_lidWasOpen = false;
+    m_autoRun = false;
+
     //
     // Database parameters
     //
@@ -172,6 +311,63 @@ MainWindow::MainWindow(QWidget *parent) :
     }
     delete(qf);
 
+    //
+    // Reply latency history used by the adaptive timeouts
+    //
+    QString historyFile = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath();
+    historyFile += "/";
+    historyFile += LATENCY_HISTORY_FILE;
+    m_script.loadLatencyHistory(historyFile);
+
+    //
+    // Pass/fail history used by the fail-fast ordering
+    //
+    historyFile = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath();
+    historyFile += "/";
+    historyFile += TEST_HISTORY_FILE;
+    m_testHistory.load(historyFile);
+
+    //
+    // Running statistics of the expects
+    //
+    historyFile = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath();
+    historyFile += "/";
+    historyFile += SPC_HISTORY_FILE;
+    m_spcHistory.setBaselineCount(m_spcBaselineCount);
+    m_spcHistory.setShiftStarts(m_spcShiftStarts);
+    m_spcHistory.load(historyFile);
+
+    //
+    // Baseline of the golden board
+    //
+    historyFile = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath();
+    historyFile += "/";
+    historyFile += GOLDEN_UNIT_FILE;
+    m_goldenUnit.setDefaultTolerance(m_goldenTolerance_pct);
+    m_goldenUnit.load(historyFile);
+
+    //
+    // Checkpoint of the run in progress
+    //
+    QString checkpointFile = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath();
+    checkpointFile += "/";
+    checkpointFile += CHECKPOINT_FILE;
+    m_checkpoint.setFilename(checkpointFile);
+
+    //
+    // Measurement database, written by a background thread
+    //
+    m_measurementDatabasePath = m_measurementDatabase;
+    if (QFileInfo(m_measurementDatabasePath).isRelative())
+    {
+        m_measurementDatabasePath = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath() + "/" + m_measurementDatabase;
+    }
+    if (m_storeMeasurements)
+    {
+        connect(&m_measurementStore, SIGNAL(storeError(const QString &)), this, SLOT(measurementStoreError(const QString &)));
+        m_measurementStore.start(m_measurementDatabasePath);
+    }
+
     //
     // Unsaved Reports
     //
@@ -200,6 +396,38 @@ MainWindow::MainWindow(QWidget *parent) :
         delete(qf);
     }
 
+    CStationMetrics::Instance()->setSpoolDepth(m_alternatReportFiles.size());
+    m_reportSpooler.setDirectories(m_reportDir, m_localReportDirectory);
+    m_reportSpooler.setPending(m_alternatReportFiles);
+    connect(&m_reportSpooler, SIGNAL(spooled(const QString &, bool, const QStringList &)),
+            this, SLOT(reportSpooled(const QString &, bool, const QStringList &)));
+    connect(&m_reportSpooler, SIGNAL(spoolError(const QString &)), this, SLOT(reportSpoolError(const QString &)));
+    m_reportSpooler.start();
+    if ((m_metricsPort > 0) && !m_metricsServer.start(m_metricsPort))
+    {
+        QString msg = "The metrics could not be served on port %1: %2";
+        logStringRedToWindow(msg.arg(m_metricsPort).arg(m_metricsServer.errorString()).toLocal8Bit());
+    }
+    connect(&m_remoteControl, SIGNAL(request(int, const QJsonObject &)), this, SLOT(remoteRequest(int, const QJsonObject &)));
+
+    if (m_autoStart)
+    {
+        m_serialValidator.setDatabase(m_databaseServer, m_databaseName, m_databaseUser, m_databasePwd, m_databaseZNum);
+        connect(&m_serialValidator, SIGNAL(validated(const QString &, bool, const QString &)),
+                this, SLOT(serialNumberValidated(const QString &, bool, const QString &)));
+        m_serialValidator.start();
+        if (!m_lidCommand.isEmpty())
+        {
+            connect(&m_lidTimer, SIGNAL(timeout()), this, SLOT(pollFixtureLid()));
+            m_lidTimer.start(m_lidPoll_ms);
+        }
+    }
+    if ((m_remotePort > 0) && !m_remoteControl.start(QHostAddress(m_remoteAddress), m_remotePort))
+    {
+        QString msg = "Remote control could not listen on %1:%2: %3";
+        logStringRedToWindow(msg.arg(m_remoteAddress).arg(m_remotePort).arg(m_remoteControl.errorString()).toLocal8Bit());
+    }
+
     connect(&m_script, SIGNAL(logStringBlack(const char*)), this, SLOT(logStringBlack(const char*)));
     connect(&m_script, SIGNAL(logStringGray(const char*)), this, SLOT(logStringGray(const char*)));
     connect(&m_script, SIGNAL(logStringRed(const char*)), this, SLOT(logStringRed(const char*)));
@@ -207,12 +435,26 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(&m_script, SIGNAL(logReply(const char *)), this, SLOT(logReply(const char*)));
     connect(&m_script, SIGNAL(sendVapoThermCommand(int, const char *)), this, SLOT(sendVapoThermCommand(int, const char *)));
     connect(&m_script, SIGNAL(readVapoThermResponse(int, char *, const int , const int )), this, SLOT(readVapoThermResponse(int, char *, const int , const int )));
+    connect(&m_script, SIGNAL(readVapoThermBytes(int, char *, const int , const int )), this, SLOT(readVapoThermBytes(int, char *, const int , const int )));
     connect(&m_script, SIGNAL(flushIncomingData(int)), this, SLOT(flushIncomingData(int)));
+    connect(&m_script, SIGNAL(startVapoThermCommand(int, const char *)), this, SLOT(startVapoThermCommand(int, const char *)));
+    connect(&m_script, SIGNAL(pollVapoThermOutput(int)), this, SLOT(pollVapoThermOutput(int)));
+    connect(&m_script, SIGNAL(pollVapoThermResponse(int, char *, const int)), this, SLOT(pollVapoThermResponse(int, char *, const int)));
+    connect(&m_script, SIGNAL(readTimedOut(int)), this, SLOT(readTimedOut(int)));
+    connect(&m_script, SIGNAL(postOperatorPrompt(int, const QString &, const QString &)), m_operatorQueue, SLOT(addPrompt(int, const QString &, const QString &)));
+    connect(m_operatorQueue, SIGNAL(answered(int, bool)), &m_script, SLOT(operatorPromptAnswered(int, bool)));
+    connect(m_fixtureArbiter, SIGNAL(logStringGray(const char*)), this, SLOT(logStringGray(const char*)));
 }
 
 
 MainWindow::~MainWindow()
 {
+    //
+    // Finish writing the reports
+    //
+    m_reportSpooler.stop();
+    m_alternatReportFiles = m_reportSpooler.getPending();
+
     //
     // Close connection to the database.
     //
@@ -229,6 +471,7 @@ MainWindow::~MainWindow()
     m_settings->setValue("Script", m_scriptFileName);
     m_settings->setValue("ReportDir", m_reportDir);
     m_settings->setValue("TerminateOnError", m_terminateOnFirstError);
+    m_settings->setValue("FailFastOrdering", m_failFastOrdering);
 
     //
     // Serial Parameters
@@ -237,6 +480,81 @@ MainWindow::~MainWindow()
     m_settings->setValue("Serial/OutputDelayMS", m_outputDelay_ms);
     m_settings->setValue("Serial/TimeoutMS_A", m_timeoutA_ms);
     m_settings->setValue("Serial/TimeoutMS_B", m_timeoutB_ms);
+    m_settings->setValue("Serial/AdaptiveTimeouts", m_adaptiveTimeouts);
+    m_settings->setValue("Serial/AdaptiveMarginMS", m_adaptiveMargin_ms);
+    m_settings->setValue("Serial/AdaptiveMinSamples", m_adaptiveMinSamples);
+
+    //
+    // Sleep tuning parameters
+    //
+    m_settings->setValue("SleepTuning/Enabled", m_sleepTuningEnabled);
+    m_settings->setValue("SleepTuning/Repeats", m_sleepTuningRepeats);
+    m_settings->setValue("SleepTuning/Tolerance", m_sleepTuningTolerance);
+    m_settings->setValue("SleepTuning/MarginPercent", m_sleepTuningMargin_pct);
+
+    //
+    // Fixture parameters
+    //
+    m_settings->setValue("Fixture/Profile", m_fixtureProfile);
+    m_settings->setValue("Fixture/ElideRedundant", m_elideRedundant);
+
+    //
+    // Checkpoint parameters
+    //
+    m_settings->setValue("Checkpoint/Enabled", m_checkpointEnabled);
+    m_settings->setValue("Checkpoint/ReinitTest", m_reinitTest);
+
+    //
+    // Measurement parameters
+    //
+    m_settings->setValue("Measurements/Enabled", m_storeMeasurements);
+    m_settings->setValue("Measurements/Database", m_measurementDatabase);
+
+    //
+    // SPC parameters
+    //
+    m_settings->setValue("SPC/Enabled", m_spcEnabled);
+    m_settings->setValue("SPC/BaselineCount", m_spcBaselineCount);
+    m_settings->setValue("SPC/ShiftStarts", m_spcShiftStarts);
+
+    //
+    // Golden board parameters
+    //
+    m_settings->setValue("Golden/SerialNumber", m_goldenSerialNumber);
+    m_settings->setValue("Golden/TolerancePercent", m_goldenTolerance_pct);
+    m_settings->setValue("Golden/RequireAtShiftStart", m_goldenAtShiftStart);
+
+    //
+    // Metrics parameters
+    //
+    m_settings->setValue("Metrics/Port", m_metricsPort);
+
+    //
+    // Remote control parameters
+    //
+    m_settings->setValue("Remote/Port", m_remotePort);
+    m_settings->setValue("Remote/Address", m_remoteAddress);
+
+    //
+    // Auto start parameters
+    //
+    m_settings->setValue("Products/Rules", m_productRules);
+    m_settings->setValue("AutoStart/Enabled", m_autoStart);
+    m_settings->setValue("AutoStart/LidCommand", m_lidCommand);
+    m_settings->setValue("AutoStart/LidClosedReply", m_lidClosedReply);
+    m_settings->setValue("AutoStart/LidSettleMS", m_lidSettle_ms);
+    m_settings->setValue("AutoStart/PollMS", m_lidPoll_ms);
+
+    //
+    // Panel parameters
+    //
+    m_settings->setValue("Panel/Positions", m_panelPorts.size());
+    for (int i=0; i<m_panelPorts.size(); i++)
+    {
+        QString key = "Panel/Port%1";
+        m_settings->setValue(key.arg(i+1), m_panelPorts[i]);
+    }
+
     if (m_serialPorts[0]->isOpen())
     {
         m_settings->setValue("Serial/PortA", m_serialPorts[0]->portName());
@@ -356,6 +674,11 @@ void MainWindow::snooze(int ms)
 */
 void MainWindow::displayWarning(const char *msg)
 {
+    if (m_remoteRun)
+    {
+        m_remoteMessages.append(plainText(msg));
+        return;
+    }
     QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
     QMessageBox::warning(this, title, msg, QMessageBox::Ok);
 }
@@ -371,6 +694,11 @@ void MainWindow::displayWarning(const char *msg)
 */
 bool MainWindow::displayQuestion(const char *msg)
 {
+    if (m_remoteRun)
+    {
+        m_remoteMessages.append(plainText(msg) + (m_remoteConfirm ? " yes" : " no"));
+        return(m_remoteConfirm);
+    }
     QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
     QMessageBox::StandardButton reply;
     reply = QMessageBox::question(this, title, msg, QMessageBox::Yes|QMessageBox::No);
@@ -388,6 +716,16 @@ bool MainWindow::displayQuestion(const char *msg)
 */
 void MainWindow::startTestsButtonPress()
 {
+    //
+    // A press during a lid poll is handled when the poll is done, so the
+    // run does not share port B with it
+    //
+    if (m_lidPolling)
+    {
+        QTimer::singleShot(10, this, SLOT(startTestsButtonPress()));
+        return;
+    }
+
     enableButtonsAfterRun(false);
     ui->labelResults->setText(g_stringIdle);
     ui->textEditResults->clear();
@@ -404,6 +742,7 @@ void MainWindow::startTestsButtonPress()
 
     QString line;
     m_reportStrings.clear();
+    m_script.clearMeasurements();
 
     //
     // Check to make sure the comm ports are connected to something
@@ -417,6 +756,19 @@ void MainWindow::startTestsButtonPress()
         return;
     }
 
+    //
+    // Switch to the script of the product (a bad serial number is
+    // reported below)
+    //
+    if (  !m_scriptLibrary.isEmpty() && (ui->lineEditSerialNumber->text().trimmed().length() == 10)
+       && !selectProduct(ui->lineEditSerialNumber->text().trimmed()) )
+    {
+        ui->labelResults->setText(g_stringNotRun);
+        enableButtonsAfterRun(true);
+        ui->lineEditSerialNumber->setFocus();
+        return;
+    }
+
     //
     // TestProgram
     //
@@ -473,7 +825,7 @@ void MainWindow::startTestsButtonPress()
         ui->lineEditSerialNumber->setFocus();
         return;
     }
-    if (serialNumber == m_lastSerialNumber)
+    if ((serialNumber == m_lastSerialNumber) && !m_autoRun)
     {
         QString msg = "Run again with last serial number (";
         msg.append(serialNumber);
@@ -486,7 +838,7 @@ void MainWindow::startTestsButtonPress()
             return;
         }
     }
-    if ( m_validateSerial &&  !serialNumberIsInDB(serialNumber) )
+    if ( m_validateSerial && (serialNumber != m_validatedSerial) && !serialNumberIsInDB(serialNumber) )
     {
         logStringRed("Serial number is not validated in the database.");
         displayWarning("Serial number is not validated in the database.");
@@ -496,92 +848,195 @@ void MainWindow::startTestsButtonPress()
         return;
     }
     m_lastSerialNumber = serialNumber;
-    QString serialNumberStr = "ImageBarcode: " + serialNumber;
-    logStringBlack(serialNumberStr.toLocal8Bit());
-    logStringBlack(" ");
+    if (serialNumber == m_armedSerial)
+    {
+        m_armedSerial.clear();   // started with the Start button
+    }
+    m_lidWasOpen = false;
+
+    //
+    // Production units wait for the golden board to pass in the shift
+    //
+    if (  m_goldenAtShiftStart && !m_goldenSerialNumber.isEmpty() && (serialNumber != m_goldenSerialNumber)
+       && !m_goldenUnit.checkedInShift(m_spcHistory.getShiftId(QDateTime::currentDateTime())) )
+    {
+        QString msg = "The golden board (%1) has not passed on this fixture since the start of the shift.\n\n"
+                      "Test %2 anyway?";
+        msg = msg.arg(m_goldenSerialNumber).arg(serialNumber);
+        if (!displayQuestion(msg.toLocal8Bit()))
+        {
+            logStringRedToWindow("Run the golden board before testing production units.");
+            ui->labelResults->setText(g_stringNotRun);
+            enableButtonsAfterRun(true);
+            ui->lineEditSerialNumber->setFocus();
+            return;
+        }
+    }
+
+    //
+    // Offer to resume a run of this serial number that did not end
+    // (the station crashed or lost power)
+    //
+    CRunCheckpoint::run_t checkpoint;
+    bool resuming = false;
+    bool fullRun = false;     // a fresh run of every test, the only kind the golden board is judged on
+    unsigned int testCount = m_testList.size();
+    if ( m_checkpointEnabled && m_checkpoint.load(checkpoint)
+       && (checkpoint.m_serialNumber == serialNumber)
+       && (checkpoint.m_scriptFile == QFileInfo(m_scriptFileName).fileName())
+       && (checkpoint.m_scriptVersion == *m_script.getScriptVersion())
+       && (checkpoint.m_runOrder.size() == testCount)
+       && (checkpoint.m_nextRun < testCount) )
+    {
+        QString lastTest = "(none)";
+        if (checkpoint.m_nextRun > 0)
+        {
+            lastTest = *m_script.getTestName(m_testNumbers[checkpoint.m_runOrder[checkpoint.m_nextRun-1]]);
+        }
+        QString msg = "The last run of %1 did not finish.  It completed %2 of %3 tests (last: %4).\n\n"
+                      "Resume with the next test?";
+        msg = msg.arg(serialNumber).arg(checkpoint.m_nextRun).arg(testCount).arg(lastTest);
+        resuming = displayQuestion(msg.toLocal8Bit());
+    }
+
+    if (resuming)
+    {
+        //
+        // The report continues from the checkpoint
+        //
+        ui->textEditResults->clear();
+        m_reportStrings = checkpoint.m_reportStrings;
+        for (unsigned int i=0; i<m_reportStrings.size(); i++)
+        {
+            logStringGray(m_reportStrings[i].toLocal8Bit());
+        }
+        QString resumeStr = "Resuming from the checkpoint with test %1 of %2";
+        logStringGray(resumeStr.arg(checkpoint.m_nextRun+1).arg(testCount).toLocal8Bit());
+    }
+    else
+    {
+        QString serialNumberStr = "ImageBarcode: " + serialNumber;
+        logStringBlack(serialNumberStr.toLocal8Bit());
+        logStringBlack(" ");
+    }
 
     //
     // Set the timeout values from the ini file
     //
     m_script.setTimeouts(m_timeoutA_ms, m_timeoutB_ms);
+    m_script.setAdaptiveTimeouts(m_adaptiveTimeouts, m_adaptiveMargin_ms, m_adaptiveMinSamples);
+    m_script.setElideRedundant(m_elideRedundant && m_fixtureProfileLoaded);
+    m_script.invalidateFixtureState();
+    m_script.clearRetryCounts();
+    m_script.cancelAsyncPrompts();
+    m_operatorQueue->clearAll();
 
     //
-    // Make a list of all the tests that failed
+    // Make a list of all the tests that failed, and keep track of the
+    // tests that failed or were skipped for the tests that require them
     //
     std::vector<int> failedTestList;
+    std::vector<int> skippedTestList;
+    std::vector<bool> testFailed(m_script.getTestCount(), false);
 
     ui->labelResults->setText(g_stringWorking);
-    unsigned int testCount = m_testList.size();
     ui->progressBarTests->setRange(0, 2*testCount);
+    QTime cycleTime;
+    cycleTime.start();
+    CStationMetrics::Instance()->unitStarted();
+    QJsonObject startedEvent;
+    startedEvent["serial"] = serialNumber;
+    startedEvent["resuming"] = resuming;
+    publishEvent("started", startedEvent);
     int failCount = 0;
     int passCount = 0;
+    std::vector<unsigned int> runOrder;
+    unsigned int firstRun = 0;
 
+    if (resuming)
+    {
+        //
+        // Pick up the results and the run order of the checkpoint, then
+        // bring the DUT and the fixture back to where the run stopped
+        //
+        runOrder = checkpoint.m_runOrder;
+        firstRun = checkpoint.m_nextRun;
+        m_retestReport = checkpoint.m_retestReport;
+        passCount = checkpoint.m_passCount;
+        failCount = checkpoint.m_failCount;
+        failedTestList = checkpoint.m_failedTests;
+        skippedTestList = checkpoint.m_skippedTests;
+        for (unsigned int i=0; i<failedTestList.size(); i++)
+        {
+            testFailed[failedTestList[i]] = true;
+        }
+        for (unsigned int i=0; i<skippedTestList.size(); i++)
+        {
+            testFailed[skippedTestList[i]] = true;
+        }
+        for (unsigned int i=0; i<testCount; i++)
+        {
+            m_testList[i]->setCheckState(Qt::Unchecked);
+        }
+        for (unsigned int i=0; i<checkpoint.m_checked.size(); i++)
+        {
+            m_testList[checkpoint.m_checked[i]]->setCheckState(Qt::Checked);
+        }
+        for (unsigned int r=0; r<firstRun; r++)
+        {
+            unsigned int i = runOrder[r];
+            if (m_testList[i]->checkState() == Qt::Checked)
+            {
+                m_testList[i]->setForeground(testFailed[m_testNumbers[i]] ? Qt::red : Qt::gray);
+            }
+        }
+        emit setProgressBarValue(2*firstRun);
 
-    //
-    // Create a fake tests so we can see the version numbers
-    // in the database with the test records
-    //
-    time_t rawtime;
-    struct tm *t;
-    time (&rawtime);
-    t = localtime (&rawtime);
-    char    tmpStr[100];
-    sprintf(tmpStr, "%02d/%02d/%04d", t->tm_mon+1, t->tm_mday, t->tm_year+1900);
-    QString dateLine = "Date: ";
-    dateLine.append(tmpStr);
-    sprintf(tmpStr, "%02d:%02d:%02d", t->tm_hour, t->tm_min, t->tm_sec);
-    QString timeLine = "Time: ";
-    timeLine.append(tmpStr);
-
-    logStringBlack("TestName: Test Program Name");
-    logStringBlack("TestType: Test Program Name");
-    logStringBlack(dateLine.toLocal8Bit());
-    logStringBlack(timeLine.toLocal8Bit());
-    line = "Value: ";
-    line.append(QFileInfo( QCoreApplication::applicationFilePath() ).fileName());
-    logStringBlack(line.toLocal8Bit());
-    logStringBlack("Result: PASS");
-    logStringBlack("~#~\n");
-
-    logStringBlack("TestName: Test Program Version");
-    logStringBlack("TestType: Test Program Version");
-    logStringBlack(dateLine.toLocal8Bit());
-    logStringBlack(timeLine.toLocal8Bit());
-    line = "Value: ";
-    line.append(VERSION_STRING);
-    logStringBlack(line.toLocal8Bit());
-    logStringBlack("Result: PASS");
-    logStringBlack("~#~\n");
-
-    logStringBlack("TestName: Test Script Name");
-    logStringBlack("TestType: Test Script Name");
-    logStringBlack(dateLine.toLocal8Bit());
-    logStringBlack(timeLine.toLocal8Bit());
-    line = "Value: ";
-    line.append(QFileInfo(m_scriptFileName).fileName());
-    logStringBlack(line.toLocal8Bit());
-    logStringBlack("Result: PASS");
-    logStringBlack("~#~\n");
-
-    logStringBlack("TestName: Test Script Version");
-    logStringBlack("TestType: Test Script Version");
-    logStringBlack(dateLine.toLocal8Bit());
-    logStringBlack(timeLine.toLocal8Bit());
-    line = "Value: ";
-    line.append(m_script.getScriptVersion());
-    logStringBlack(line.toLocal8Bit());
-    logStringBlack("Result: PASS");
-    logStringBlack("~#~\n");
+        if (!reinitForResume(checkpoint))
+        {
+            CStationMetrics::Instance()->unitFinished(CStationMetrics::UNIT_ABORTED, cycleTime.elapsed()/1000.0);
+            ui->labelResults->setText(g_stringNotRun);
+            enableButtonsAfterRun(true);
+            return;
+        }
+    }
+    else
+    {
+        //
+        // Create a fake tests so we can see the version numbers
+        // in the database with the test records
+        //
+        m_script.generateProgramRecords(QFileInfo( QCoreApplication::applicationFilePath() ).fileName(),
+                                        VERSION_STRING, QFileInfo(m_scriptFileName).fileName());
+
+        getRunOrder(runOrder);
+        checkpoint.m_serialNumber = serialNumber;
+        checkpoint.m_scriptFile = QFileInfo(m_scriptFileName).fileName();
+        checkpoint.m_scriptVersion = *m_script.getScriptVersion();
+        checkpoint.m_runOrder = runOrder;
+        checkpoint.m_retestReport = m_retestReport;
+        checkpoint.m_checked.clear();
+        for (unsigned int i=0; i<testCount; i++)
+        {
+            if (m_testList[i]->checkState() == Qt::Checked)
+            {
+                checkpoint.m_checked.push_back(i);
+            }
+        }
+        fullRun = m_retestReport.isEmpty() && (checkpoint.m_checked.size() == testCount);
+    }
 
     //
     // Run each test...
     //
-    for (unsigned int i=0; i<testCount; i++)
+    for (unsigned int r=firstRun; r<testCount; r++)
     {
+        unsigned int i = runOrder[r];
+
         //
         // Update the progress bar
         //
-        emit setProgressBarValue(2*i+1);
+        emit setProgressBarValue(2*r+1);
 
         //
         // Highlight the current test
@@ -598,7 +1053,45 @@ void MainWindow::startTestsButtonPress()
         }
         if (item->checkState() != Qt::Checked)
         {
-            emit setProgressBarValue(2*i+2);
+            emit setProgressBarValue(2*r+2);
+            continue;
+        }
+
+        //
+        // Skip tests whose prerequisites failed or were skipped.  A
+        // prerequisite that was not selected does not prevent the run.
+        //
+        const std::vector<int> &prereqs = m_script.getPrerequisites(m_testNumbers[i]);
+        int failedPrereq = -1;
+        for (unsigned int k=0; k<prereqs.size(); k++)
+        {
+            if (testFailed[prereqs[k]])
+            {
+                failedPrereq = prereqs[k];
+                break;
+            }
+        }
+        if (failedPrereq >= 0)
+        {
+            QString reason = "required test did not pass (";
+            reason.append(*m_script.getTestName(failedPrereq));
+            reason.append(")");
+            m_script.reportNotRun(m_testNumbers[i], reason);
+            testFailed[m_testNumbers[i]] = true;
+            skippedTestList.push_back(m_testNumbers[i]);
+            QJsonObject testEvent;
+            testEvent["test"] = *m_script.getTestName(m_testNumbers[i]);
+            testEvent["result"] = QString("SKIPPED");
+            publishEvent("test", testEvent);
+            item->setForeground(Qt::darkYellow);
+            emit setProgressBarValue(2*r+2);
+
+            checkpoint.m_nextRun = r+1;
+            checkpoint.m_passCount = passCount;
+            checkpoint.m_failCount = failCount;
+            checkpoint.m_failedTests = failedTestList;
+            checkpoint.m_skippedTests = skippedTestList;
+            saveCheckpoint(checkpoint, testFailed);
             continue;
         }
 
@@ -606,8 +1099,25 @@ void MainWindow::startTestsButtonPress()
         // Run the test and update the progress bar
         //
         m_script.terminateOnError(m_terminateOnFirstError);
+        QTime testTime;
+        testTime.start();
         m_script.runTest(m_testNumbers[i]);
-        emit setProgressBarValue(2*i+2);
+        emit setProgressBarValue(2*r+2);
+        if (m_script.sawError() || m_script.terminatedEarly() || CAbort::Instance()->abortRequested())
+        {
+            testFailed[m_testNumbers[i]] = true;
+        }
+        if (!CAbort::Instance()->abortRequested())
+        {
+            m_testHistory.addResult(*m_script.getScriptVersion(), *m_script.getTestName(m_testNumbers[i]),
+                                    testFailed[m_testNumbers[i]], testTime.elapsed());
+            CStationMetrics::Instance()->testFinished(*m_script.getTestName(m_testNumbers[i]), testTime.elapsed()/1000.0);
+        }
+        QJsonObject testEvent;
+        testEvent["test"] = *m_script.getTestName(m_testNumbers[i]);
+        testEvent["result"] = CAbort::Instance()->abortRequested() ? "ABORTED" : (testFailed[m_testNumbers[i]] ? "FAIL" : "PASS");
+        testEvent["duration_ms"] = testTime.elapsed();
+        publishEvent("test", testEvent);
 
         //
         // Check for errors
@@ -655,6 +1165,62 @@ void MainWindow::startTestsButtonPress()
             passCount++;
             item->setForeground(Qt::gray);
         }
+
+        checkpoint.m_nextRun = r+1;
+        checkpoint.m_passCount = passCount;
+        checkpoint.m_failCount = failCount;
+        checkpoint.m_failedTests = failedTestList;
+        checkpoint.m_skippedTests = skippedTestList;
+        saveCheckpoint(checkpoint, testFailed);
+    }
+
+    //
+    // The run is not done until every async prompt has been answered
+    //
+    m_script.flushAsyncPrompts();
+    if ((m_script.getPendingPromptCount() > 0) && !CAbort::Instance()->abortRequested())
+    {
+        QString waitStr = "Waiting for %1 operator check(s)";
+        logStringGray(waitStr.arg(m_script.getPendingPromptCount()).toLocal8Bit());
+        while ((m_script.getPendingPromptCount() > 0) && !CAbort::Instance()->abortRequested())
+        {
+            qApp->processEvents();
+            snooze(10);
+            m_script.flushAsyncPrompts();
+        }
+        if (CAbort::Instance()->abortRequested())
+        {
+            logStringRedToWindow("Tests ABORTED by Operator");
+        }
+    }
+    if (CAbort::Instance()->abortRequested())
+    {
+        m_script.cancelAsyncPrompts();
+        m_operatorQueue->clearAll();
+    }
+
+    //
+    // A test that passed fails if one of its async prompts was answered "no"
+    //
+    const std::vector<int> &asyncFailedTests = m_script.getAsyncFailedTests();
+    for (unsigned int k=0; k<asyncFailedTests.size(); k++)
+    {
+        int n = asyncFailedTests[k];
+        if ((n < 0) || testFailed[n])
+        {
+            continue;
+        }
+        testFailed[n] = true;
+        passCount--;
+        failCount++;
+        failedTestList.push_back(n);
+        for (unsigned int r=0; r<m_testList.size(); r++)
+        {
+            if (m_testNumbers[r] == n)
+            {
+                m_testList[r]->setForeground(Qt::red);
+            }
+        }
     }
 
     //
@@ -688,15 +1254,51 @@ void MainWindow::startTestsButtonPress()
     //
     if (!CAbort::Instance()->abortRequested())
     {
-        generateReport();
-    }
-
-    //
+        if (m_retestReport.isEmpty())
+        {
+            generateReport();
+        }
+        else
+        {
+            generateRetestReport();
+        }
+        storeMeasurements(&m_script, serialNumber, 0);
+        if (serialNumber == m_goldenSerialNumber)
+        {
+            checkGoldenUnit(&m_script, fullRun, !m_script.terminatedEarly() && (failCount == 0));
+        }
+        else
+        {
+            updateSpc(&m_script, 0);
+        }
+    }
+    m_script.saveLatencyHistory();
+    m_testHistory.save();
+    m_spcHistory.save();
+    m_checkpoint.clear();
+
+    CStationMetrics::result_t result = CStationMetrics::UNIT_PASSED;
+    if (CAbort::Instance()->abortRequested())
+        result = CStationMetrics::UNIT_ABORTED;
+    else if (m_script.terminatedEarly() || (failCount > 0))
+        result = CStationMetrics::UNIT_FAILED;
+    CStationMetrics::Instance()->unitFinished(result, cycleTime.elapsed()/1000.0);
+    CStationMetrics::Instance()->retries(m_serialPorts[0]->portName(), m_script.getRetryCount(0));
+    CStationMetrics::Instance()->retries(m_serialPorts[1]->portName(), m_script.getRetryCount(1));
+    m_retestReport.clear();
+
+    //
     // List the tests that failed
     //
     QString summaryStr = "Summary: PASSED=%1  FAILED=%2  NOT_RUN=%3";
     summaryStr = summaryStr.arg(passCount).arg(failCount).arg(testCount-passCount-failCount);
     logStringGray(summaryStr.toLocal8Bit());
+    if ((m_script.getRetryCount(0) > 0) || (m_script.getRetryCount(1) > 0))
+    {
+        QString retryStr = "Retries: port A=%1  port B=%2";
+        retryStr = retryStr.arg(m_script.getRetryCount(0)).arg(m_script.getRetryCount(1));
+        logStringGray(retryStr.toLocal8Bit());
+    }
     if (failedTestList.size() > 0)
     {
         logStringRedToWindow(" ");
@@ -710,12 +1312,35 @@ void MainWindow::startTestsButtonPress()
         }
         logStringRedToWindow("------------------------------------------------------------------------------------------");
     }
+    if (skippedTestList.size() > 0)
+    {
+        logStringRedToWindow(" ");
+        logStringRedToWindow("SKIPPED Tests (required test did not pass):");
+        for (unsigned int i=0; i<skippedTestList.size(); i++)
+        {
+            QString name("        ");
+            name += *m_script.getTestName(skippedTestList[i]);
+            logStringRedToWindow(name.toLocal8Bit());
+        }
+        logStringRedToWindow("------------------------------------------------------------------------------------------");
+    }
+
+    QJsonObject finishedEvent;
+    finishedEvent["serial"] = serialNumber;
+    finishedEvent["result"] = plainText(ui->labelResults->text());
+    finishedEvent["passed"] = passCount;
+    finishedEvent["failed"] = failCount;
+    finishedEvent["not_run"] = (int)testCount-passCount-failCount;
+    publishEvent("finished", finishedEvent);
 
     //
     // re-enable the run button and reset the serial number control
     //
     enableButtonsAfterRun(true);
-    ui->lineEditSerialNumber->clear();
+    if (ui->lineEditSerialNumber->text().trimmed() == serialNumber)
+    {
+        ui->lineEditSerialNumber->clear();   // keep the scan of the next unit
+    }
     ui->lineEditSerialNumber->setFocus();
 }
 
@@ -940,6 +1565,7 @@ bool MainWindow::sendVapoThermCommand(int portIndex, const char *command)
     // write a terminating CR-LF
     //
     bytesWritten += m_serialPorts[portIndex]->write("\r\n");
+    CStationMetrics::Instance()->bytesOut(m_serialPorts[portIndex]->portName(), bytesWritten);
 
 
     //
@@ -957,6 +1583,185 @@ bool MainWindow::sendVapoThermCommand(int portIndex, const char *command)
 
 
 
+/*!
+ * @brief Starts sending a command to the instrument without waiting
+ *
+ * The command is paced out one character at a time by pollVapoThermOutput,
+ * so that both ports can be sending at the same time.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @param[in] command - the command, without comments
+ * @return false if the port is not open
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::startVapoThermCommand(int portIndex, const char *command)
+{
+    flushIncomingData(portIndex);
+
+    m_pendingOutput[portIndex] = command;
+    m_pendingIndex[portIndex] = 0;
+    m_pendingWritten[portIndex] = 0;
+    m_pendingTime[portIndex].start();
+    return(m_serialPorts[portIndex]->isOpen());
+}
+
+
+/*!
+ * @brief Writes the next character of the command started by startVapoThermCommand
+ *
+ * A character is only written once the output delay has passed since the
+ * last one.  The terminating CR-LF follows the last character.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @return 0 while the command is being sent, 1 when it has been sent, -1 on a write error
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int MainWindow::pollVapoThermOutput(int portIndex)
+{
+    int commandLength = m_pendingOutput[portIndex].size();
+    if (m_pendingIndex[portIndex] < 0)
+    {
+        return((m_pendingWritten[portIndex] < commandLength+2) ? -1 : 1);
+    }
+    if ((m_pendingIndex[portIndex] > 0) && (m_pendingTime[portIndex].elapsed() < m_outputDelay_ms))
+    {
+        return(0);
+    }
+
+    if (m_pendingIndex[portIndex] < commandLength)
+    {
+        char smallStr[2];
+        smallStr[0] = m_pendingOutput[portIndex].at(m_pendingIndex[portIndex]);
+        smallStr[1] = '\0';
+        qint64 n = m_serialPorts[portIndex]->write(smallStr);
+        m_pendingWritten[portIndex] += n;
+        CStationMetrics::Instance()->bytesOut(m_serialPorts[portIndex]->portName(), n);
+        m_pendingIndex[portIndex]++;
+        m_pendingTime[portIndex].start();
+        return(0);
+    }
+
+    qint64 n = m_serialPorts[portIndex]->write("\r\n");
+    m_pendingWritten[portIndex] += n;
+    CStationMetrics::Instance()->bytesOut(m_serialPorts[portIndex]->portName(), n);
+    m_pendingIndex[portIndex] = -1;
+    return((m_pendingWritten[portIndex] < commandLength+2) ? -1 : 1);
+}
+
+
+/*!
+ * @brief Returns a line from the instrument if a whole line has arrived
+ *
+ * This does not wait.  The characters of a partial line are kept
+ * until the rest of the line arrives.  Empty lines are skipped.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @param[in] buffer - place to put the line
+ * @param[in] bufferSize - size of the buffer
+ * @return true if a line was returned
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::pollVapoThermResponse(int portIndex, char *buffer, const int bufferSize)
+{
+    buffer[0] = '\0';
+    if (!m_serialPorts[portIndex]->isOpen())
+    {
+        return(false);
+    }
+    receiveVapoThermData(portIndex);
+    return(takeVapoThermLine(portIndex, buffer, bufferSize));
+}
+
+
+/*!
+ * @brief Counts a read of a parallel block branch that timed out
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::readTimedOut(int portIndex)
+{
+    CStationMetrics::Instance()->readTimeout(m_serialPorts[portIndex]->portName());
+}
+
+
+/*!
+ * @brief Appends what the instrument has sent to the input buffer of the port
+ *
+ * The line and block reads and the polled reads of the parallel blocks
+ * all take their data from this buffer, so nothing received by one of
+ * them is lost to the others.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @return the number of bytes received
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int MainWindow::receiveVapoThermData(int portIndex)
+{
+    if (!m_serialPorts[portIndex]->isOpen())
+    {
+        return(0);
+    }
+    QByteArray received = m_serialPorts[portIndex]->readAll();
+    CStationMetrics::Instance()->bytesIn(m_serialPorts[portIndex]->portName(), received.size());
+    m_lineBuffer[portIndex].append(received);
+    return(received.size());
+}
+
+
+/*!
+ * @brief Takes a whole line from the input buffer of the port
+ *
+ * Empty lines are skipped.  A line longer than the buffer is returned in
+ * pieces.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @param[in] buffer - place to put the line
+ * @param[in] bufferSize - size of the buffer
+ * @return true if a line was returned
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::takeVapoThermLine(int portIndex, char *buffer, const int bufferSize)
+{
+    buffer[0] = '\0';
+    QByteArray *pLine = &m_lineBuffer[portIndex];
+    while (!pLine->isEmpty())
+    {
+        int end = 0;
+        while ((end < pLine->size()) && (pLine->at(end) != '\r') && (pLine->at(end) != '\n'))
+        {
+            end++;
+        }
+        if ((end == pLine->size()) && (end < bufferSize-1))
+        {
+            return(false);
+        }
+
+        int n = std::min(end, bufferSize-1);
+        memcpy(buffer, pLine->constData(), n);
+        buffer[n] = '\0';
+        pLine->remove(0, (n < end) ? n : end+1);
+        if (n > 0)
+        {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+
 /*!
  * @brief Flushes the specified serial port
  *
@@ -969,8 +1774,7 @@ void MainWindow::flushIncomingData(int portIndex)
 {
     m_serialPorts[portIndex]->clear();
 
-    m_inputBufferIndex = 0;
-    m_inputBufferCount = 0;
+    m_lineBuffer[portIndex].clear();
 }
 
 
@@ -987,72 +1791,90 @@ void MainWindow::flushIncomingData(int portIndex)
 */
 bool MainWindow::readVapoThermResponse(int portIndex, char *buffer, const int bufferSize, const int msTimeout)
 {
-    int index = 0;
     buffer[0] = '\0';
 
     int tick = 0;
     while (tick < msTimeout)
     {
-        //
-        // Read more data if our input buffer is empty
-        //
-        if (m_inputBufferCount == 0)
+        if (!m_serialPorts[portIndex]->isOpen())
         {
-            if (!m_serialPorts[portIndex]->isOpen())
-            {
-                m_inputBufferIndex = 0;
-                m_inputBufferCount = 0;
-                return(false);
-            }
-
-            m_inputBufferCount = m_serialPorts[portIndex]->read(m_inputBuffer, sizeof(m_inputBuffer));
-            m_inputBufferIndex = 0;
-
-            if (m_inputBufferCount == 0)
-            {
-                qApp->processEvents();
-                snooze(1);
-                tick++;
-                continue;
-            }
+            m_lineBuffer[portIndex].clear();
+            return(false);
         }
 
         //
-        // Return if our output buffer is full
+        // Return a line if one has arrived, otherwise wait for more data
         //
-        if (index >= (bufferSize-1))
+        if (takeVapoThermLine(portIndex, buffer, bufferSize))
         {
             return(true);
         }
+        if (receiveVapoThermData(portIndex) == 0)
+        {
+            qApp->processEvents();
+            snooze(1);
+            tick++;
+        }
+    }
 
-        //
-        // Grab the next character
-        //
-        buffer[index++] = m_inputBuffer[m_inputBufferIndex];
-        buffer[index] = '\0';
-        m_inputBufferIndex++;
-        m_inputBufferCount--;
+    CStationMetrics::Instance()->readTimeout(m_serialPorts[portIndex]->portName());
+    return(false);
+}
+
+
+/*!
+ * @brief reads a block of raw bytes from the instrument
+ *
+ * No line terminators are interpreted.  The read ends when the requested
+ * number of bytes have been read or when no data arrives for the timeout period.
+ *
+ * @param[in] portIndex - 0 for port A, 1 for port B
+ * @param[in] buffer - place to put the bytes
+ * @param[in] count - number of bytes to read
+ * @param[in] msTimeout - timeout period between successful reads
+ * @return the number of bytes read
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+int MainWindow::readVapoThermBytes(int portIndex, char *buffer, const int count, const int msTimeout)
+{
+    int index = 0;
 
+    int tick = 0;
+    while ((index < count) && (tick < msTimeout))
+    {
         //
-        // If the last character was a line terminator then we are done
-        // (provided we have at least one character
+        // Take what has been received first
         //
-        if ((buffer[index-1] == '\n') || (buffer[index-1] == '\r'))
+        QByteArray *pInput = &m_lineBuffer[portIndex];
+        if (!pInput->isEmpty())
         {
-            buffer[index-1] = '\0';
-            if (index > 1)
-            {
-                return(true);
-            }
-            else
-            {
-                index = 0;
-            }
+            int n = std::min(count - index, pInput->size());
+            memcpy(&buffer[index], pInput->constData(), n);
+            pInput->remove(0, n);
+            index += n;
+            tick = 0;
+            continue;
         }
 
+        if (!m_serialPorts[portIndex]->isOpen())
+        {
+            break;
+        }
+        if (receiveVapoThermData(portIndex) == 0)
+        {
+            qApp->processEvents();
+            snooze(1);
+            tick++;
+        }
     }
 
-    return(false);
+    if (index < count)
+    {
+        CStationMetrics::Instance()->readTimeout(m_serialPorts[portIndex]->portName());
+    }
+    return(index);
 }
 
 
@@ -1195,7 +2017,23 @@ bool MainWindow::loadScript(const char *scriptFilename)
     {
         return(false);
     }
+    m_productName.clear();
+    m_productSerial.clear();
+    watchScriptFile(scriptFilename);
+
+    rebuildTestList();
+    return(true);
+}
+
 
+/*!
+ * @brief Fills the list of tests from the loaded script, all tests checked
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::rebuildTestList()
+{
     ui->listWidget->clear();
     m_testList.clear();
     m_testNumbers.clear();
@@ -1226,152 +2064,428 @@ bool MainWindow::loadScript(const char *scriptFilename)
     ui->progressBarTests->setValue(0);
 
     setTitle();
-    return(true);
 }
 
 
 /*!
- * @brief Called when the "Script/Select All Tests" menu is selected
+ * @brief Watches the script file for changes made by the script author
  *
- * @author J. Peterson
- * @date 06/01/2014
+ * @param[in] path - the script file, empty to stop watching
+ *
+ * @author agent
+ * @date 10/19/2026
 */
-void MainWindow::selectAllTests()
+void MainWindow::watchScriptFile(const QString &path)
 {
-    for (unsigned int i=0; i<m_testList.size(); i++)
+    QStringList watched = m_scriptWatcher.files();
+    if (!watched.isEmpty())
     {
-        m_testList[i]->setCheckState(Qt::Checked);
+        m_scriptWatcher.removePaths(watched);
     }
-}
-
-/*!
- * @brief Called when the "Script/Clear All Tests" menu is selected
- *
- * @author J. Peterson
- * @date 06/01/2014
-*/
-void MainWindow::clearAllTests()
-{
-    for (unsigned int i=0; i<m_testList.size(); i++)
+    if (!path.isEmpty() && QFileInfo(path).exists())
     {
-        m_testList[i]->setCheckState(Qt::Unchecked);
+        m_scriptWatcher.addPath(path);
     }
 }
 
 
 /*!
- * @brief Called when the "Abort" button is pressed
+ * @brief Called when the loaded script file was written
  *
- * @author J. Peterson
- * @date 06/01/2014
+ * The reload waits a moment so that an editor can finish writing (or
+ * replacing) the file.
+ *
+ * @author agent
+ * @date 10/19/2026
 */
-void MainWindow::abortButtonPress()
+void MainWindow::scriptFileChanged(const QString &path)
 {
-    CAbort::Instance()->requestAbort();
+    Q_UNUSED(path);
+    m_scriptReloadTimer.start();
 }
 
 
 /*!
- * @brief Called to generate an Aegis report after a script has finished
+ * @brief Reloads the tests of the script that changed since it was loaded
  *
- * @author J. Peterson
- * @date 06/01/2014
+ * Only the changed tests are parsed again (see CTestScript::updateScriptFile).
+ * The checked state of the tests is kept by name, new tests are checked.
+ * The checkpoint of an unfinished run is discarded.  When a run is in
+ * progress the reload is done when it ends.
+ *
+ * @author agent
+ * @date 10/19/2026
 */
-bool MainWindow::generateReport()
+void MainWindow::reloadChangedScript()
 {
-    //
-    // create the filename path name
-    //
-    time_t rawtime;
-    struct tm *t;
-    time (&rawtime);
-    t = localtime (&rawtime);
-    char filename[1000];
-    sprintf(filename, "%02d%02d%04d_%02d%02d%02d.txt",
-            t->tm_mon+1, t->tm_mday, t->tm_year+1900,
-            t->tm_hour, t->tm_min, t->tm_sec);
+    if (m_busy)
+    {
+        m_scriptReloadPending = true;
+        return;
+    }
+    m_scriptReloadPending = false;
+    watchScriptFile(m_scriptFileName);     // an editor may have replaced the file
 
-    QString filePath = m_reportDir;
-    if (filePath.at(filePath.size()-1) != '/')
+    bool changed = false;
+    QStringList reparsed;
+    if (!m_script.updateScriptFile(m_scriptFileName.toLocal8Bit().data(), changed, reparsed))
+    {
+        QString msg = "Could not read the script file " + m_scriptFileName + ", the loaded script is kept.";
+        logStringRedToWindow(msg.toLocal8Bit());
+        return;
+    }
+    if (!changed)
     {
-        filePath.append("/");
+        return;
     }
-    filePath += filename;
 
     //
-    // open the file
+    // The tests of a checkpoint may no longer be the tests of the script
+    // (the version is usually not changed while tuning)
     //
-    FILE *fp = NULL;
-    fp = fopen(filePath.toLocal8Bit().data(), "w");
+    m_checkpoint.clear();
 
-    //
-    // If we can't create the file then create it in the local directory
-    //
-    if (fp == NULL)
+    std::map<QString, Qt::CheckState> checks;
+    for (unsigned int i=0; i<m_testList.size(); i++)
     {
-        QString localFilePath = m_localReportDirectory;
-        if (localFilePath.at(localFilePath.size()-1) != '/')
-        {
-            localFilePath.append("/");
-        }
-        localFilePath += filename;
-        fp = fopen(localFilePath.toLocal8Bit().data(), "w");
-
-        if (fp == NULL)
-        {
-            QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
-            QString msg = "<html><span style=\" font-size:12pt; font-weight:600; color:#F00000;\">";
-            msg += "Could not write report to alternate location:<p>";
-            msg.append(localFilePath);
-            msg.append("</p></span></html>");
-            QMessageBox::warning(this, title, msg, QMessageBox::Ok);
-
-            return(false);
-        }
-        else
+        checks[m_testList[i]->text()] = m_testList[i]->checkState();
+    }
+    rebuildTestList();
+    for (unsigned int i=0; i<m_testList.size(); i++)
+    {
+        std::map<QString, Qt::CheckState>::iterator it = checks.find(m_testList[i]->text());
+        if (it != checks.end())
         {
-
-            QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
-            QString msg = "<html><span style=\" font-size:12pt; font-weight:600; color:#F00000;\">";
-            msg += "Could not write report to the primary directory:<p>";
-            msg += filePath;
-            msg += "</p>The report will be written to:<p>";
-            msg += localFilePath;
-            msg += "</p></span></html>";
-            QMessageBox::warning(this, title, msg, QMessageBox::Ok);
+            m_testList[i]->setCheckState(it->second);
         }
-        m_alternatReportFiles.push_back(localFilePath);
-
     }
 
     //
-    // Create the file now
+    // Switching products must not bring back the old script
     //
-    for (unsigned int i=0; i<m_reportStrings.size(); i++)
+    CTestScript *productScript = m_scriptLibrary.getScript(m_productName);
+    if (productScript != NULL)
     {
-        fprintf(fp, "%s\n", m_reportStrings[i].toLocal8Bit().data());
+        productScript->copyScript(m_script);
     }
-    fclose(fp);
 
-    return(true);
+    QString msg = "Script reloaded (version %1), parsed again: %2";
+    msg = msg.arg(*m_script.getScriptVersion()).arg(reparsed.isEmpty() ? QString("none") : reparsed.join(", "));
+    logStringGray(msg.toLocal8Bit());
 }
 
 
-
-
 /*!
- * @brief Enables the Run button and disables the Abort button after a script completes
+ * @brief Called when the "Script/Reload Product Rules" menu is selected
  *
- * @param[in] enabled - when true Start is enabled and Abort is disabled, when false, the oposite
+ * Reads the rule file of the products and parses the script of each of
+ * them.  The script that is loaded is not changed until the next run.
  *
- * @author J. Peterson
- * @date 06/01/2014
+ * @author agent
+ * @date 10/19/2026
 */
-void MainWindow::enableButtonsAfterRun(bool enable)
+void MainWindow::reloadProductRules()
 {
-    ui->pushButtonStartTests->setEnabled(enable);
-    ui->pushButton_Abort->setEnabled(!enable);
-}
+    m_productName.clear();
+    m_productSerial.clear();
+    if (m_productRules.isEmpty())
+    {
+        m_scriptLibrary.clear();
+        return;
+    }
+
+    QString rules = m_productRules;
+    if (QFileInfo(rules).isRelative())
+    {
+        rules = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath() + "/" + rules;
+    }
+    QStringList errors;
+    m_scriptLibrary.loadRules(rules, errors);
+    for (int i=0; i<errors.size(); i++)
+    {
+        logStringRedToWindow(errors[i].toLocal8Bit());
+    }
+    if (!m_scriptLibrary.isEmpty())
+    {
+        QString msg = "Products: %1";
+        logStringGray(msg.arg(m_scriptLibrary.getProducts().join(", ")).toLocal8Bit());
+    }
+}
+
+
+/*!
+ * @brief Loads the script of the product of a serial number
+ *
+ * The rules of the product rule file are tried in order: the serial
+ * number prefix, the Z number of the serial number in the database,
+ * then the replies to the probe commands.  The probes are only sent
+ * once for a serial number.
+ *
+ * @param[in] serialNumber - serial number of the unit
+ * @return false if no rule matched
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::selectProduct(const QString &serialNumber)
+{
+    if (serialNumber == m_productSerial)
+    {
+        return(true);
+    }
+
+    QString product = m_scriptLibrary.matchSerialNumber(serialNumber);
+    if (product.isEmpty() && m_scriptLibrary.hasZNumberRules())
+    {
+        product = m_scriptLibrary.matchZNumber(lookupZNumber(serialNumber));
+    }
+    if (product.isEmpty() && !m_scriptLibrary.getProbes().empty())
+    {
+        product = probeProduct();
+    }
+    if (product.isEmpty())
+    {
+        QString msg = "No product rule matches serial number %1.";
+        msg = msg.arg(serialNumber);
+        logStringRedToWindow(msg.toLocal8Bit());
+        displayWarning(msg.toLocal8Bit().data());
+        return(false);
+    }
+
+    activateProduct(product);
+    m_productSerial = serialNumber;
+    return(true);
+}
+
+
+/*!
+ * @brief Copies the parsed script of a product into the script that is run
+ *
+ * @param[in] product - name of the product in the rule file
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::activateProduct(const QString &product)
+{
+    CTestScript *script = m_scriptLibrary.getScript(product);
+    if ((script == NULL) || (product == m_productName))
+    {
+        return;
+    }
+
+    m_script.copyScript(*script);
+    m_scriptFileName = m_scriptLibrary.getScriptFile(product);
+    m_productName = product;
+    watchScriptFile(m_scriptFileName);
+    rebuildTestList();
+
+    QString msg = "Product %1: %2";
+    msg = msg.arg(product).arg(QFileInfo(m_scriptFileName).fileName());
+    logStringGray(msg.toLocal8Bit());
+}
+
+
+/*!
+ * @brief Sends the probe commands of the rule file until a reply matches
+ *
+ * @return the product of the first probe that matched, empty if none did
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString MainWindow::probeProduct()
+{
+    const std::vector<CScriptLibrary::probe_t> &probes = m_scriptLibrary.getProbes();
+    for (unsigned int i=0; i<probes.size(); i++)
+    {
+        int portIndex = probes[i].m_portIndex;
+        int timeout_ms = (portIndex == 0) ? m_timeoutA_ms : m_timeoutB_ms;
+        flushIncomingData(portIndex);
+        if (!sendVapoThermCommand(portIndex, probes[i].m_command.toLocal8Bit().data()))
+        {
+            continue;
+        }
+
+        char buffer[1024];
+        while (readVapoThermResponse(portIndex, buffer, sizeof(buffer), timeout_ms))
+        {
+            if (probes[i].m_reply.indexIn(buffer) >= 0)
+            {
+                return(probes[i].m_product);
+            }
+        }
+    }
+    return(QString());
+}
+
+
+/*!
+ * @brief Called when the "Script/Select All Tests" menu is selected
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::selectAllTests()
+{
+    for (unsigned int i=0; i<m_testList.size(); i++)
+    {
+        m_testList[i]->setCheckState(Qt::Checked);
+    }
+}
+
+/*!
+ * @brief Called when the "Script/Clear All Tests" menu is selected
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::clearAllTests()
+{
+    for (unsigned int i=0; i<m_testList.size(); i++)
+    {
+        m_testList[i]->setCheckState(Qt::Unchecked);
+    }
+}
+
+
+/*!
+ * @brief Called when the "Abort" button is pressed
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::abortButtonPress()
+{
+    CAbort::Instance()->requestAbort();
+}
+
+
+/*!
+ * @brief Called to generate an Aegis report after a script has finished
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+bool MainWindow::generateReport()
+{
+    return(generateReport(m_reportStrings, ""));
+}
+
+
+/*!
+ * @brief Writes a report file
+ *
+ * @param[in] reportStrings - lines of the report
+ * @param[in] suffix - appended to the file name (e.g. "_P2" for a panel position)
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::generateReport(const std::vector<QString> &reportStrings, const QString &suffix)
+{
+    //
+    // create the filename path name
+    //
+    time_t rawtime;
+    struct tm *t;
+    time (&rawtime);
+    t = localtime (&rawtime);
+    char filename[1000];
+    sprintf(filename, "%02d%02d%04d_%02d%02d%02d%s.txt",
+            t->tm_mon+1, t->tm_mday, t->tm_year+1900,
+            t->tm_hour, t->tm_min, t->tm_sec, suffix.toLocal8Bit().data());
+
+    //
+    // The file is written by the spooler thread, the report directory
+    // may be a slow network share
+    //
+    QStringList lines;
+    for (unsigned int i=0; i<reportStrings.size(); i++)
+    {
+        lines.append(reportStrings[i]);
+    }
+    m_reportSpooler.spool(filename, lines);
+
+    return(true);
+}
+
+
+/*!
+ * @brief Called when the spooler has written a report
+ *
+ * A report that had to be written to the local directory is only shown in
+ * the window while a run is in progress, a dialog would stop the run.
+ *
+ * @param[in] path - where the report was written
+ * @param[in] inReportDir - false if it was written to the local directory
+ * @param[in] pending - the local reports not yet in the report directory
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::reportSpooled(const QString &path, bool inReportDir, const QStringList &pending)
+{
+    m_alternatReportFiles = pending;
+    CStationMetrics::Instance()->setSpoolDepth(m_alternatReportFiles.size());
+    if (inReportDir)
+    {
+        return;
+    }
+
+    QString msg = "Could not write report to the primary directory " + m_reportDir + ", it was written to " + path;
+    logStringRedToWindow(msg.toLocal8Bit());
+    if (!m_busy)
+    {
+        msg = "<html><span style=\" font-size:12pt; font-weight:600; color:#F00000;\">";
+        msg += "Could not write report to the primary directory:<p>";
+        msg += m_reportDir;
+        msg += "</p>The report was written to:<p>";
+        msg += path;
+        msg += "</p></span></html>";
+        displayWarning(msg.toLocal8Bit().data());
+    }
+}
+
+
+/*!
+ * @brief Called when the spooler could not write a report anywhere
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::reportSpoolError(const QString &message)
+{
+    logStringRedToWindow(message.toLocal8Bit());
+    if (!m_busy)
+    {
+        QString msg = "<html><span style=\" font-size:12pt; font-weight:600; color:#F00000;\">";
+        msg += message;
+        msg += "</span></html>";
+        displayWarning(msg.toLocal8Bit().data());
+    }
+}
+
+
+/*!
+ * @brief Enables the Run button and disables the Abort button after a script completes
+ *
+ * @param[in] enabled - when true Start is enabled and Abort is disabled, when false, the oposite
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::enableButtonsAfterRun(bool enable)
+{
+    m_busy = !enable;
+    if (enable && m_scriptReloadPending)
+    {
+        QTimer::singleShot(0, this, SLOT(reloadChangedScript()));
+    }
+    ui->pushButtonStartTests->setEnabled(enable);
+    ui->pushButton_Abort->setEnabled(!enable);
+    ui->actionRun_Panel->setEnabled(enable && !m_panelPorts.isEmpty());
+}
 
 
 
@@ -1402,7 +2516,131 @@ void MainWindow::serialNumberChanged(QString serialNumber)
     {
         serialNumber = serialNumber.right(serialNumberLength);
         ui->lineEditSerialNumber->setText(serialNumber);
+        return;
+    }
+
+    //
+    // A complete scan is validated in the background, even while the
+    // current unit is still being tested
+    //
+    if (  !m_autoStart || (length != serialNumberLength) || (serialNumber == m_validatingSerial)
+       || (serialNumber == m_armedSerial) )
+    {
+        return;
+    }
+    m_armedSerial.clear();
+    if (!m_validateSerial || (serialNumber == m_validatedSerial))
+    {
+        serialNumberValidated(serialNumber, true, "");
+        return;
+    }
+    m_validatingSerial = serialNumber;
+    QMetaObject::invokeMethod(&m_serialValidator, "validate", Qt::QueuedConnection, Q_ARG(QString, serialNumber),
+                              Q_ARG(QString, zNumberForSerial(serialNumber)));
+}
+
+
+/*!
+ * @brief Called when the database has answered for a scanned serial number
+ *
+ * A serial number that was found is armed: the run starts when the lid
+ * closes (see pollFixtureLid), or with the Start button.
+ *
+ * @param[in] serialNumber - the scanned serial number
+ * @param[in] found - true if it is in the database
+ * @param[in] error - why the database could not be queried, empty if it was
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::serialNumberValidated(const QString &serialNumber, bool found, const QString &error)
+{
+    if (serialNumber == m_validatingSerial)
+    {
+        m_validatingSerial.clear();
+    }
+    if (serialNumber != ui->lineEditSerialNumber->text().trimmed())
+    {
+        return;   // scanned over
+    }
+
+    QString msg;
+    if (!found)
+    {
+        msg = "Serial number %1 is not validated in the database. %2";
+        logStringRedToWindow(msg.arg(serialNumber).arg(error).toLocal8Bit());
+        return;
+    }
+    m_validatedSerial = serialNumber;
+    m_armedSerial = serialNumber;
+    if (m_lidCommand.isEmpty())
+    {
+        msg = "Serial number %1 validated, press Start";
+    }
+    else
+    {
+        msg = "Serial number %1 validated, the run starts when the lid is closed";
+    }
+    logStringGray(msg.arg(serialNumber).toLocal8Bit());
+}
+
+
+/*!
+ * @brief Asks the fixture for the state of its lid and starts an armed run
+ *
+ * The run starts when the lid closes after having been open, so that the
+ * unit that was just tested is not started again.  Nothing is sent to
+ * the fixture while a run is in progress, and a run that is started
+ * during a poll waits for the poll to end.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::pollFixtureLid()
+{
+    if (m_busy || m_lidPolling || !m_serialPorts[1]->isOpen())
+    {
+        return;
+    }
+
+    //
+    // Same exchange as the lid test of the scripts: the fixture echoes
+    // the command, then answers after the settle time
+    //
+    m_lidPolling = true;
+    char echo[1024];
+    char reply[1024];
+    flushIncomingData(1);
+    bool answered = sendVapoThermCommand(1, m_lidCommand.toLocal8Bit())
+                 && readVapoThermResponse(1, echo, sizeof(echo), m_timeoutB_ms);
+    if (answered)
+    {
+        snooze(m_lidSettle_ms);
+        answered = readVapoThermResponse(1, reply, sizeof(reply), m_timeoutB_ms);
+    }
+    flushIncomingData(1);
+    m_lidPolling = false;
+    if (!answered || m_busy)
+    {
+        return;
+    }
+
+    bool closed = QString(reply).contains(m_lidClosedReply, Qt::CaseInsensitive);
+    if (!closed)
+    {
+        m_lidWasOpen = true;
+        return;
+    }
+    if (!m_lidWasOpen || m_armedSerial.isEmpty() || (m_armedSerial != ui->lineEditSerialNumber->text().trimmed()))
+    {
+        return;
     }
+
+    m_armedSerial.clear();
+    m_lidWasOpen = false;
+    m_autoRun = true;
+    startTestsButtonPress();
+    m_autoRun = false;
 }
 
 
@@ -1499,47 +2737,107 @@ bool MainWindow::serialNumberIsInDB(QString serialNumber)
     queryStr.append("INNER JOIN EnerconUtilities.dbo.SNLog2 (NOLOCK) ");
     queryStr.append("ON SNLogDetail.RecordNo = SNLog2.RecordNo ");
     queryStr.append("WHERE SNLogDetail.SN1='%1' AND SNLog2.[Z Number] ='%2'");
-    queryStr = queryStr.arg(serialNumber).arg(m_databaseZNum);
+    queryStr = queryStr.arg(serialNumber).arg(zNumberForSerial(serialNumber));
+    QTime lookupTime;
+    lookupTime.start();
     QSqlQuery query(queryStr, m_database);
 
     //
     // If there is a least one record then the serial number is in the database.
     //
-    return(query.next());
+    bool found = query.next();
+    CStationMetrics::Instance()->databaseLookup(lookupTime.elapsed()/1000.0);
+    return(found);
 }
 
 
 /*!
- * @brief Called when the "Configuration/Terminate on first error" menu is selected
+ * @brief Returns the Z number a serial number is validated against
  *
- * @param[in] checked - new state of the option
+ * This is the Z number of the product loaded for the serial number, or
+ * of the product its prefix selects, otherwise the one of the ini file.
  *
- * @author J. Peterson
- * @date 06/01/2014
+ * @author agent
+ * @date 10/19/2026
 */
-void MainWindow::terminateCheckboxClicked(bool checked)
+QString MainWindow::zNumberForSerial(const QString &serialNumber)
 {
-    m_terminateOnFirstError = checked;
+    QString product = (serialNumber == m_productSerial) ? m_productName : m_scriptLibrary.matchSerialNumber(serialNumber);
+    QString zNumber = m_scriptLibrary.getZNumber(product);
+    return(zNumber.isEmpty() ? m_databaseZNum : zNumber);
 }
 
 
 /*!
- * @brief Called when the "Configuration/Validate serial number" menu is selected
+ * @brief Looks up the Z number a serial number was logged under
  *
- * @param[in] checked - new state of the option
+ * @return the Z number, empty if the serial number was not found
  *
- * @author J. Peterson
- * @date 06/01/2014
+ * @author agent
+ * @date 10/19/2026
 */
-void MainWindow::validateSerialNumberChecked(bool checked)
+QString MainWindow::lookupZNumber(const QString &serialNumber)
 {
-    m_validateSerial = checked;
-}
-
+    if (!m_database.isOpen())
+    {
+        if (!connectToDatabase())
+        {
+            return(QString());
+        }
+    }
 
-/*!
- * @brief Called when the "Configuration/Validate serial connections" menu is selected
- *
+    QString queryStr;
+    queryStr.append("SELECT SNLog2.[Z Number] ");
+    queryStr.append("FROM EnerconUtilities.dbo.SNLogDetail (NOLOCK) ");
+    queryStr.append("INNER JOIN EnerconUtilities.dbo.SNLog2 (NOLOCK) ");
+    queryStr.append("ON SNLogDetail.RecordNo = SNLog2.RecordNo ");
+    queryStr.append("WHERE SNLogDetail.SN1='%1'");
+    queryStr = queryStr.arg(serialNumber);
+    QTime lookupTime;
+    lookupTime.start();
+    QSqlQuery query(queryStr, m_database);
+
+    QString zNumber;
+    if (query.next())
+    {
+        zNumber = query.value(0).toString().trimmed();
+    }
+    CStationMetrics::Instance()->databaseLookup(lookupTime.elapsed()/1000.0);
+    return(zNumber);
+}
+
+
+/*!
+ * @brief Called when the "Configuration/Terminate on first error" menu is selected
+ *
+ * @param[in] checked - new state of the option
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::terminateCheckboxClicked(bool checked)
+{
+    m_terminateOnFirstError = checked;
+}
+
+
+/*!
+ * @brief Called when the "Configuration/Validate serial number" menu is selected
+ *
+ * @param[in] checked - new state of the option
+ *
+ * @author J. Peterson
+ * @date 06/01/2014
+*/
+void MainWindow::validateSerialNumberChecked(bool checked)
+{
+    m_validateSerial = checked;
+}
+
+
+/*!
+ * @brief Called when the "Configuration/Validate serial connections" menu is selected
+ *
  * @param[in] checked - new state of the option
  *
  * @author J. Peterson
@@ -1551,3 +2849,1631 @@ void MainWindow::validateSerialConnectionsChecked(bool checked)
 }
 
 
+/*!
+ * @brief Called when the "Script/Estimate Cycle Time" menu is selected
+ *
+ * The estimate uses the serial parameters from the ini file and is
+ * written to the window only (not to the report).
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::estimateCycleTime()
+{
+    if (m_script.getTestCount() <= 0)
+    {
+        displayWarning("A script must be loaded before the cycle time can be estimated.");
+        return;
+    }
+
+    CTimeBudget budget;
+    budget.analyze(&m_script, m_outputDelay_ms, m_timeoutA_ms, m_timeoutB_ms);
+
+    std::vector<QString> lines;
+    budget.getReport(lines);
+
+    logStringGray(" ");
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        logStringGray(lines[i].toLocal8Bit());
+    }
+}
+
+
+/*!
+ * @brief Called when the "Configuration/Adaptive timeouts" menu is selected
+ *
+ * @param[in] checked - new state of the option
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::adaptiveTimeoutsChecked(bool checked)
+{
+    m_adaptiveTimeouts = checked;
+}
+
+
+/*!
+ * @brief Called when the "Configuration/Fail-fast test ordering" menu is selected
+ *
+ * @param[in] checked - new state of the option
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::failFastOrderingChecked(bool checked)
+{
+    m_failFastOrdering = checked;
+}
+
+
+/*!
+ * @brief Builds the order in which the tests of the list are run
+ *
+ * Normally the tests run in file order.  With fail-fast ordering, each run of
+ * consecutive tests that share a group name is sorted so that the tests most
+ * likely to fail per second of run time go first.  A test is never moved ahead
+ * of a test it requires.  Tests that are not in a group keep their place.
+ *
+ * @param[out] order - indexes into m_testList in the order they are to run
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::getRunOrder(std::vector<unsigned int> &order)
+{
+    order.clear();
+    unsigned int testCount = m_testList.size();
+    if (!m_failFastOrdering)
+    {
+        for (unsigned int i=0; i<testCount; i++)
+        {
+            order.push_back(i);
+        }
+        return;
+    }
+
+    QString version = *m_script.getScriptVersion();
+    unsigned int first = 0;
+    while (first < testCount)
+    {
+        //
+        // Find the block of consecutive tests in the same group
+        //
+        QString group = m_script.getTestGroup(m_testNumbers[first]);
+        unsigned int last = first + 1;
+        if (!group.isEmpty())
+        {
+            while ((last < testCount) && (m_script.getTestGroup(m_testNumbers[last]) == group))
+            {
+                last++;
+            }
+        }
+
+        //
+        // Repeatedly take the ready test with the highest failure rate per second
+        //
+        std::vector<double> priority;
+        for (unsigned int i=first; i<last; i++)
+        {
+            QString name = *m_script.getTestName(m_testNumbers[i]);
+            double p = m_testHistory.getFailureProbability(version, name);
+            int duration_ms = m_testHistory.getMeanDurationMS(version, name, 1000);
+            if (duration_ms < 1)
+                duration_ms = 1;
+            priority.push_back(p * 1000.0 / duration_ms);
+        }
+        std::vector<bool> scheduled(last-first, false);
+        for (unsigned int n=first; n<last; n++)
+        {
+            int best = -1;
+            for (unsigned int i=first; i<last; i++)
+            {
+                if (scheduled[i-first])
+                    continue;
+
+                bool ready = true;
+                const std::vector<int> &prereqs = m_script.getPrerequisites(m_testNumbers[i]);
+                for (unsigned int k=0; k<prereqs.size() && ready; k++)
+                {
+                    for (unsigned int j=first; j<last; j++)
+                    {
+                        if ((m_testNumbers[j] == prereqs[k]) && !scheduled[j-first])
+                        {
+                            ready = false;
+                            break;
+                        }
+                    }
+                }
+                if (ready && ((best < 0) || (priority[i-first] > priority[best-first])))
+                {
+                    best = i;
+                }
+            }
+            scheduled[best-first] = true;
+            order.push_back(best);
+        }
+
+        first = last;
+    }
+}
+
+
+/*!
+ * @brief Called when the "Script/Sleep Tuning Experiment" menu is selected
+ *
+ * The checked tests are run repeatedly on a golden board while the
+ * scripted sleeps are shrunk (see CSleepTuner).  No report is written.
+ * When the experiment completes, a copy of the script with the recommended
+ * sleep times is written next to the script as <name>-tuned.txt.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::sleepTuningExperiment()
+{
+    if (!m_sleepTuningEnabled || (m_script.getTestCount() <= 0))
+    {
+        return;
+    }
+
+    if (!m_serialPorts[0]->isOpen() || !m_serialPorts[1]->isOpen())
+    {
+        displayWarning("Serial ports A and B must be connected to the device under test and the test fixture, respectively.");
+        return;
+    }
+
+    std::vector<int> tests;
+    for (unsigned int i=0; i<m_testList.size(); i++)
+    {
+        if (m_testList[i]->checkState() == Qt::Checked)
+        {
+            tests.push_back(m_testNumbers[i]);
+        }
+    }
+
+    CSleepTuner tuner;
+    int maxPasses = tuner.start(&m_script, tests, m_sleepTuningRepeats, m_sleepTuningTolerance, m_sleepTuningMargin_pct);
+
+    QString msg = "The sleep tuning experiment runs the checked tests up to %1 times with reduced sleeps."
+                  "\n\nOnly run this with a GOLDEN BOARD in the fixture.\n\nContinue?";
+    if (!displayQuestion(msg.arg(maxPasses).toLocal8Bit()))
+    {
+        return;
+    }
+
+    enableButtonsAfterRun(false);
+    CAbort::Instance()->clearRequest();
+    m_script.setTimeouts(m_timeoutA_ms, m_timeoutB_ms);
+    m_script.setAdaptiveTimeouts(false, m_adaptiveMargin_ms, m_adaptiveMinSamples);
+    m_script.setElideRedundant(false);
+    m_script.invalidateFixtureState();
+    m_script.terminateOnError(false);
+    ui->progressBarTests->setRange(0, maxPasses);
+    ui->labelResults->setText(g_stringWorking);
+
+    int pass = 0;
+    while (!tuner.isFinished() && !CAbort::Instance()->abortRequested())
+    {
+        ui->textEditResults->clear();
+        emit setProgressBarValue(pass);
+        QString passLine = "Sleep tuning pass %1 of at most %2";
+        logStringGray(passLine.arg(pass+1).arg(maxPasses).toLocal8Bit());
+
+        std::map<int, int> overrides;
+        tuner.getOverrides(overrides);
+        m_script.setSleepOverrides(overrides);
+        m_script.clearMeasurements();
+
+        for (unsigned int t=0; t<tests.size(); t++)
+        {
+            m_script.runTest(tests[t]);
+            if (CAbort::Instance()->abortRequested() || m_script.terminatedEarly())
+            {
+                break;
+            }
+        }
+
+        //
+        // Each pass ends like a normal run so the next one starts from the same state
+        //
+        m_script.clearSleepOverrides();
+        if (m_indexOnExit >= 0)
+        {
+            bool aborted = CAbort::Instance()->abortRequested();
+            CAbort::Instance()->clearRequest();
+            m_script.runTest(m_indexOnExit);
+            if (aborted)
+            {
+                CAbort::Instance()->requestAbort();
+            }
+        }
+
+        if (!CAbort::Instance()->abortRequested())
+        {
+            tuner.recordPass(m_script.getMeasurements());
+        }
+        pass++;
+    }
+    m_script.clearSleepOverrides();
+    m_script.clearMeasurements();
+    m_reportStrings.clear();
+    emit setProgressBarValue(maxPasses);
+
+    std::vector<QString> lines;
+    tuner.getReport(lines);
+    logStringGray(" ");
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        logStringGray(lines[i].toLocal8Bit());
+    }
+
+    if (CAbort::Instance()->abortRequested())
+    {
+        ui->labelResults->setText(g_stringAborted);
+    }
+    else
+    {
+        QFileInfo info(m_scriptFileName);
+        QString tunedFile = info.absolutePath() + "/" + info.completeBaseName() + "-tuned.txt";
+        if (tuner.writeTunedScript(m_scriptFileName, tunedFile))
+        {
+            QString line = "Tuned script written to: " + tunedFile;
+            logStringGray(line.toLocal8Bit());
+            ui->labelResults->setText(g_stringIdle);
+        }
+        else
+        {
+            QString line = "Could not write the tuned script: " + tunedFile;
+            logStringRedToWindow(line.toLocal8Bit());
+            displayWarning(line.toLocal8Bit());
+        }
+    }
+
+    m_script.cancelAsyncPrompts();
+    m_operatorQueue->clearAll();
+    enableButtonsAfterRun(true);
+}
+
+
+/*!
+ * @brief Asks the operator for the serial number of each panel position
+ *
+ * @param[out] serialNumbers - serial number of each position
+ * @return false if the operator cancelled or a serial number is not valid
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::getPanelSerialNumbers(QStringList &serialNumbers)
+{
+    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+    serialNumbers.clear();
+    for (int i=0; i<m_panelPorts.size(); i++)
+    {
+        QString label = "Serial number of position %1 (%2):";
+        bool ok = false;
+        QString serialNumber = QInputDialog::getText(this, title, label.arg(i+1).arg(m_panelPorts[i]),
+                                                     QLineEdit::Normal, "", &ok).trimmed();
+        if (!ok)
+        {
+            return(false);
+        }
+        if (serialNumber.length() != 10)
+        {
+            displayWarning("Serial Number must be 10 numeric characters.");
+            return(false);
+        }
+        if (serialNumbers.contains(serialNumber))
+        {
+            displayWarning("The same serial number was entered for two positions.");
+            return(false);
+        }
+        if ( m_validateSerial &&  !serialNumberIsInDB(serialNumber) )
+        {
+            displayWarning("Serial number is not validated in the database.");
+            return(false);
+        }
+        serialNumbers.append(serialNumber);
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Called when the "Script/Run Panel" menu is selected
+ *
+ * Runs the checked tests on every position of the panel at the same time.
+ * Each position runs a copy of the script in its own thread with its own
+ * DUT port; the fixture on port B is shared through the fixture arbiter.
+ * A report is written for each position with "_P<n>" added to its name.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::runPanel()
+{
+    if (m_panelPorts.isEmpty() || (m_script.getTestCount() <= 0))
+    {
+        return;
+    }
+    if (!m_serialPorts[1]->isOpen())
+    {
+        displayWarning("Serial port B must be connected to the test fixture.");
+        return;
+    }
+    for (int i=0; i<m_panelPorts.size(); i++)
+    {
+        if (m_serialPorts[0]->isOpen() && (m_panelPorts[i] == m_serialPorts[0]->portName()))
+        {
+            displayWarning("Serial port A is one of the panel ports, disconnect it first.");
+            return;
+        }
+    }
+    QString testOperator = ui->lineEditOperator->text().trimmed();
+    if (testOperator.isEmpty())
+    {
+        displayWarning(g_noOperator.toLocal8Bit().data());
+        ui->lineEditOperator->setFocus();
+        return;
+    }
+    QStringList serialNumbers;
+    if (!getPanelSerialNumbers(serialNumbers))
+    {
+        return;
+    }
+
+    enableButtonsAfterRun(false);
+    ui->labelResults->setText(g_stringWorking);
+    ui->textEditResults->clear();
+    m_reportStrings.clear();
+    m_script.cancelAsyncPrompts();
+    m_operatorQueue->clearAll();
+    CAbort::Instance()->clearRequest();
+
+    //
+    // Checked tests in run order
+    //
+    std::vector<unsigned int> runOrder;
+    getRunOrder(runOrder);
+    std::vector<int> tests;
+    for (unsigned int r=0; r<runOrder.size(); r++)
+    {
+        unsigned int i = runOrder[r];
+        if (m_testList[i]->checkState() == Qt::Checked)
+        {
+            tests.push_back(m_testNumbers[i]);
+        }
+    }
+
+    m_panelFullRun = (tests.size() == m_testList.size());
+
+    m_fixtureArbiter->reset();
+    m_fixtureArbiter->setPort(m_serialPorts[1], m_outputDelay_ms, m_timeoutB_ms);
+
+    //
+    // Start every position
+    //
+    QString program = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+    QString scriptFile = QFileInfo(m_scriptFileName).fileName();
+    m_panelDone = 0;
+    m_panelFinished = 0;
+    ui->progressBarTests->setRange(0, 2*m_panelPorts.size());
+    emit setProgressBarValue(0);
+    for (int i=0; i<m_panelPorts.size(); i++)
+    {
+        CPanelPosition *position = new CPanelPosition(i+1, m_panelPorts[i], m_fixtureArbiter);
+        position->setup(m_script, tests, m_indexOnAbort, m_indexOnExit,
+                        m_outputDelay_ms, m_timeoutA_ms, m_timeoutB_ms, m_terminateOnFirstError);
+
+        std::vector<QString> header;
+        header.push_back("TestProgram: " + program + " " + scriptFile);
+        header.push_back(QString("TestProgramVer: program=") + VERSION_STRING + " script=" + *m_script.getScriptVersion());
+        header.push_back("Operator: " + ui->lineEditOperator->text());
+        header.push_back("ImageBarcode: " + serialNumbers[i]);
+        header.push_back(" ");
+        position->setHeader(header, serialNumbers[i], program, VERSION_STRING, scriptFile);
+
+        connect(position, SIGNAL(logLine(int, const QString &, int)), this, SLOT(logPanelLine(int, const QString &, int)));
+        connect(position, SIGNAL(operatorPrompt(int, const QString &, const QString &)), m_operatorQueue, SLOT(addPrompt(int, const QString &, const QString &)));
+        connect(m_operatorQueue, SIGNAL(answered(int, bool)), position, SLOT(operatorPromptAnswered(int, bool)));
+        connect(position, SIGNAL(testsDone(int)), this, SLOT(panelTestsDone(int)));
+        connect(position, SIGNAL(finished(int)), this, SLOT(panelFinished(int)));
+        m_panel.push_back(position);
+    }
+    QTime cycleTime;
+    cycleTime.start();
+    for (unsigned int i=0; i<m_panel.size(); i++)
+    {
+        CStationMetrics::Instance()->unitStarted();
+        m_panel[i]->start();
+    }
+
+    //
+    // The fixture I/O of the positions is done in this thread, so keep
+    // processing events until every position is done with its tests
+    //
+    while (m_panelDone < (int)m_panel.size())
+    {
+        qApp->processEvents();
+        snooze(10);
+    }
+
+    //
+    // Then run OnAbort/OnExit on every position
+    //
+    bool aborted = CAbort::Instance()->abortRequested();
+    if (aborted)
+    {
+        logStringRedToWindow("Tests ABORTED by Operator");
+    }
+    CAbort::Instance()->clearRequest();
+    for (unsigned int i=0; i<m_panel.size(); i++)
+    {
+        QMetaObject::invokeMethod(m_panel[i], "runCleanup", Qt::QueuedConnection, Q_ARG(bool, aborted));
+    }
+    while (m_panelFinished < (int)m_panel.size())
+    {
+        qApp->processEvents();
+        snooze(10);
+    }
+    if (aborted)
+    {
+        CAbort::Instance()->requestAbort();
+    }
+
+    //
+    // Write the reports and list the results of each position
+    //
+    bool anyFailed = false;
+    bool anyTerminated = false;
+    for (unsigned int p=0; p<m_panel.size(); p++)
+    {
+        CPanelPosition *position = m_panel[p];
+        position->stop();
+
+        if (!aborted)
+        {
+            storeMeasurements(position->getScript(), position->getSerialNumber(), position->getPosition());
+            if (position->getSerialNumber() == m_goldenSerialNumber)
+            {
+                checkGoldenUnit(position->getScript(), m_panelFullRun,
+                                !position->terminatedEarly() && (position->getFailCount() == 0));
+            }
+            else
+            {
+                updateSpc(position->getScript(), position->getPosition());
+            }
+            QString suffix = "_P%1";
+            generateReport(position->getReportStrings(), suffix.arg(position->getPosition()));
+        }
+
+        int passCount = position->getPassCount();
+        int failCount = position->getFailCount();
+        anyFailed = anyFailed || (failCount > 0) || position->terminatedEarly();
+        anyTerminated = anyTerminated || position->terminatedEarly();
+        CStationMetrics::result_t result = CStationMetrics::UNIT_PASSED;
+        if (aborted)
+            result = CStationMetrics::UNIT_ABORTED;
+        else if ((failCount > 0) || position->terminatedEarly())
+            result = CStationMetrics::UNIT_FAILED;
+        CStationMetrics::Instance()->unitFinished(result, cycleTime.elapsed()/1000.0);
+        CStationMetrics::Instance()->retries(m_panelPorts[p], position->getScript()->getRetryCount(0));
+        CStationMetrics::Instance()->retries(m_serialPorts[1]->portName(), position->getScript()->getRetryCount(1));
+        QString summaryStr = "Position %1 (%2): PASSED=%3  FAILED=%4  NOT_RUN=%5";
+        summaryStr = summaryStr.arg(position->getPosition()).arg(position->getSerialNumber())
+                               .arg(passCount).arg(failCount).arg((int)tests.size()-passCount-failCount);
+        logStringGray(" ");
+        logStringGray(summaryStr.toLocal8Bit());
+
+        const std::vector<int> &failedTests = position->getFailedTests();
+        for (unsigned int i=0; i<failedTests.size(); i++)
+        {
+            QString name("        FAILED: ");
+            name += position->getTestName(failedTests[i]);
+            logStringRedToWindow(name.toLocal8Bit());
+        }
+        const std::vector<int> &skippedTests = position->getSkippedTests();
+        for (unsigned int i=0; i<skippedTests.size(); i++)
+        {
+            QString name("        SKIPPED: ");
+            name += position->getTestName(skippedTests[i]);
+            logStringRedToWindow(name.toLocal8Bit());
+        }
+    }
+
+    m_spcHistory.save();
+
+    std::vector<QString> lines;
+    m_fixtureArbiter->getReport(lines);
+    logStringGray(" ");
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        logStringGray(lines[i].toLocal8Bit());
+    }
+
+    for (unsigned int p=0; p<m_panel.size(); p++)
+    {
+        delete m_panel[p];
+    }
+    m_panel.clear();
+    m_operatorQueue->clearAll();
+
+    if (aborted)
+        ui->labelResults->setText(g_stringAborted);
+    else if (anyTerminated)
+        ui->labelResults->setText(g_stringAbnormalStop);
+    else if (anyFailed)
+        ui->labelResults->setText(g_stringFailed);
+    else
+        ui->labelResults->setText(g_stringPassed);
+
+    enableButtonsAfterRun(true);
+}
+
+
+/*!
+ * @brief Writes a line from a panel position to the edit window
+ *
+ * The position keeps its own report, the line is not added to m_reportStrings.
+ *
+ * @param[in] position - the position, starting at 1
+ * @param[in] text - the line, already tagged with the position
+ * @param[in] color - 0 black, 1 gray, 2 red
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::logPanelLine(int position, const QString &text, int color)
+{
+    Q_UNUSED(position);
+    if (color == 1)
+    {
+        logStringGray(text.toLocal8Bit());
+    }
+    else if (color == 2)
+    {
+        logStringRedToWindow(text.toLocal8Bit());
+    }
+    else
+    {
+        ui->textEditResults->moveCursor (QTextCursor::End);
+        ui->textEditResults->setTextColor(QColor( "black" ));
+        ui->textEditResults->insertPlainText(text);
+        ui->textEditResults->moveCursor (QTextCursor::End);
+        ui->textEditResults->insertPlainText ("\r\n");
+    }
+}
+
+
+/*!
+ * @brief Called when a panel position is done with its tests
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::panelTestsDone(int position)
+{
+    Q_UNUSED(position);
+    m_panelDone++;
+    emit setProgressBarValue(m_panelDone);
+}
+
+
+/*!
+ * @brief Called when a panel position is done with OnAbort/OnExit
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::panelFinished(int position)
+{
+    Q_UNUSED(position);
+    m_panelFinished++;
+    emit setProgressBarValue(m_panelDone + m_panelFinished);
+}
+
+
+/*!
+ * @brief Writes the checkpoint after a test has completed
+ *
+ * No checkpoint is taken while an async prompt is waiting for an answer,
+ * its record would be lost in a crash.  The tests that failed an async
+ * prompt are counted as failed in the checkpoint.
+ *
+ * @param[in,out] run - the run order and results so far
+ * @param[in] testFailed - true for each test number that failed or was skipped
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::saveCheckpoint(CRunCheckpoint::run_t &run, const std::vector<bool> &testFailed)
+{
+    if (!m_checkpointEnabled)
+    {
+        return;
+    }
+    m_script.flushAsyncPrompts();
+    if (m_script.getPendingPromptCount() > 0)
+    {
+        return;
+    }
+
+    const std::vector<int> &asyncFailedTests = m_script.getAsyncFailedTests();
+    std::vector<bool> failed = testFailed;
+    for (unsigned int k=0; k<asyncFailedTests.size(); k++)
+    {
+        int n = asyncFailedTests[k];
+        if ((n < 0) || failed[n])
+        {
+            continue;
+        }
+        failed[n] = true;
+        run.m_passCount--;
+        run.m_failCount++;
+        run.m_failedTests.push_back(n);
+    }
+
+    run.m_reportStrings = m_reportStrings;
+    m_script.getFixtureCommands(run.m_fixtureCommands);
+    if (!m_checkpoint.save(run))
+    {
+        logStringGray("Could not write the checkpoint");
+    }
+}
+
+
+/*!
+ * @brief Brings the DUT and the fixture back to where a resumed run stopped
+ *
+ * The re-init test (Checkpoint/ReinitTest in the ini file) is run first,
+ * typically the power-up of the DUT.  Its records are not added to the
+ * report.  Then the fixture commands saved with the checkpoint are sent
+ * again.
+ *
+ * @param[in] run - the checkpoint
+ * @return false if the re-init test failed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::reinitForResume(const CRunCheckpoint::run_t &run)
+{
+    if (!m_reinitTest.isEmpty())
+    {
+        int n = -1;
+        for (int i=0; i<m_script.getTestCount(); i++)
+        {
+            if (*m_script.getTestName(i) == m_reinitTest)
+            {
+                n = i;
+                break;
+            }
+        }
+        if (n < 0)
+        {
+            QString msg = "The re-init test (" + m_reinitTest + ") is not in the script.";
+            logStringRedToWindow(msg.toLocal8Bit());
+            displayWarning(msg.toLocal8Bit().data());
+            return(false);
+        }
+
+        unsigned int reportSize = m_reportStrings.size();
+        m_script.terminateOnError(true);
+        m_script.runTest(n);
+        m_reportStrings.resize(reportSize);
+        if (m_script.sawError() || m_script.terminatedEarly() || CAbort::Instance()->abortRequested())
+        {
+            QString msg = "The re-init test (" + m_reinitTest + ") failed, the run can not be resumed.";
+            logStringRedToWindow(msg.toLocal8Bit());
+            displayWarning(msg.toLocal8Bit().data());
+            return(false);
+        }
+    }
+
+    m_script.invalidateFixtureState();
+    if (!m_script.restoreFixture(run.m_fixtureCommands))
+    {
+        logStringRedToWindow("Could not restore the state of the fixture.");
+        return(false);
+    }
+    return(true);
+}
+
+
+/*!
+ * @brief Called when the "Script/Retest Failures Only" menu is selected
+ *
+ * Finds the last report of the serial number that was entered, checks
+ * only the tests that failed in it (and the tests they require), and runs
+ * them.  The report of the retest is merged into the last report.  The
+ * tests that were checked before are checked again afterwards.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::retestFailures()
+{
+    if (m_lidPolling)
+    {
+        QTimer::singleShot(10, this, SLOT(retestFailures()));
+        return;
+    }
+    if (m_script.getTestCount() <= 0)
+    {
+        return;
+    }
+    QString serialNumber = ui->lineEditSerialNumber->text().trimmed();
+    if (serialNumber.length() != 10)
+    {
+        displayWarning(g_noSerialNumber.toLocal8Bit().data());
+        ui->lineEditSerialNumber->setFocus();
+        return;
+    }
+
+    //
+    // The failed tests are checked in the script of the product, the run
+    // must not switch scripts afterwards
+    //
+    if (!m_scriptLibrary.isEmpty() && !selectProduct(serialNumber))
+    {
+        return;
+    }
+
+    QStringList dirs;
+    dirs << m_reportDir << m_localReportDirectory;
+    QString reportFile;
+    if (!CTestReport::findLastReport(dirs, serialNumber, reportFile))
+    {
+        QString msg = "No report of " + serialNumber + " was found.";
+        displayWarning(msg.toLocal8Bit().data());
+        return;
+    }
+    CTestReport lastReport;
+    if (!lastReport.load(reportFile))
+    {
+        QString msg = "Could not read the report: " + reportFile;
+        displayWarning(msg.toLocal8Bit().data());
+        return;
+    }
+    QString version = lastReport.getProgramValue("Test Script Version");
+    if (version != *m_script.getScriptVersion())
+    {
+        QString msg = "The last report of %1 was made with script version %2, the loaded script is version %3.  "
+                      "Run all of the tests instead.";
+        displayWarning(msg.arg(serialNumber).arg(version).arg(*m_script.getScriptVersion()).toLocal8Bit());
+        return;
+    }
+    QStringList failedNames;
+    lastReport.getFailedTests(failedNames);
+    if (failedNames.isEmpty())
+    {
+        QString msg = "The last report of " + serialNumber + " has no failed tests.";
+        displayWarning(msg.toLocal8Bit().data());
+        return;
+    }
+
+    //
+    // The tests the operator had checked are checked again afterwards
+    //
+    std::map<QString, Qt::CheckState> checks;
+    for (unsigned int i=0; i<m_testList.size(); i++)
+    {
+        checks[m_testList[i]->text()] = m_testList[i]->checkState();
+    }
+
+    //
+    // Check the failed tests and, recursively, the tests they require
+    //
+    clearAllTests();
+    std::vector<int> pending;
+    for (int k=0; k<failedNames.size(); k++)
+    {
+        for (int n=0; n<m_script.getTestCount(); n++)
+        {
+            if (*m_script.getTestName(n) == failedNames[k])
+            {
+                pending.push_back(n);
+            }
+        }
+    }
+    int checkedCount = 0;
+    while (!pending.empty())
+    {
+        int n = pending.back();
+        pending.pop_back();
+        for (unsigned int i=0; i<m_testList.size(); i++)
+        {
+            if ((m_testNumbers[i] == n) && (m_testList[i]->checkState() != Qt::Checked))
+            {
+                m_testList[i]->setCheckState(Qt::Checked);
+                checkedCount++;
+                const std::vector<int> &prereqs = m_script.getPrerequisites(n);
+                pending.insert(pending.end(), prereqs.begin(), prereqs.end());
+            }
+        }
+    }
+    if (checkedCount == 0)
+    {
+        displayWarning("None of the failed tests are in the loaded script.");
+    }
+    else
+    {
+        QString msg = "Retest %1 test(s) of %2 (%3 failed in %4)?";
+        msg = msg.arg(checkedCount).arg(serialNumber).arg(failedNames.size()).arg(QFileInfo(reportFile).fileName());
+        if (displayQuestion(msg.toLocal8Bit()))
+        {
+            m_retestReport = reportFile;
+            startTestsButtonPress();
+            m_retestReport.clear();
+        }
+    }
+
+    for (unsigned int i=0; i<m_testList.size(); i++)
+    {
+        std::map<QString, Qt::CheckState>::iterator it = checks.find(m_testList[i]->text());
+        if (it != checks.end())
+        {
+            m_testList[i]->setCheckState(it->second);
+        }
+    }
+}
+
+
+/*!
+ * @brief Writes the report of a retest merged into the last report of the board
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+bool MainWindow::generateRetestReport()
+{
+    CTestReport lastReport;
+    if (!lastReport.load(m_retestReport))
+    {
+        QString msg = "Could not read " + m_retestReport + ", the report has the retested tests only.";
+        logStringRedToWindow(msg.toLocal8Bit());
+        return(generateReport());
+    }
+
+    CTestReport retest;
+    retest.parse(m_reportStrings);
+    std::vector<QString> merged;
+    lastReport.merge(retest, QFileInfo(m_retestReport).fileName(), merged);
+
+    QString msg = "Report merged with " + QFileInfo(m_retestReport).fileName();
+    logStringGray(msg.toLocal8Bit());
+    return(generateReport(merged, ""));
+}
+
+
+/*!
+ * @brief Queues the measurements of a run for the measurement database
+ *
+ * @param[in] script - the script that ran
+ * @param[in] serialNumber - serial number of the board
+ * @param[in] position - panel position, 0 when not on a panel
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::storeMeasurements(CTestScript *script, const QString &serialNumber, int position)
+{
+    if (!m_storeMeasurements)
+    {
+        return;
+    }
+
+    const std::vector<CTestScript::measurement_t> &measurements = script->getMeasurements();
+    std::vector<CMeasurementStore::row_t> rows;
+    for (unsigned int k=0; k<measurements.size(); k++)
+    {
+        const CTestScript::measurement_t &measurement = measurements[k];
+        const CCommand *pCommand = script->getCommand(measurement.m_commandIndex);
+        CMeasurementStore::row_t row;
+        row.m_serialNumber = serialNumber;
+        row.m_scriptVersion = *script->getScriptVersion();
+        row.m_testName = *script->getTestName(measurement.m_testIndex);
+        row.m_line = pCommand->m_lineNumber;
+        row.m_command = pCommand->m_line.trimmed();
+        row.m_valueValid = measurement.m_valueValid;
+        row.m_value = measurement.m_value;
+        row.m_limitsValid = (pCommand->m_type != CCommand::CMD_EXPECT_CHAR) && (pCommand->m_type != CCommand::CMD_EXPECT_STR);
+        row.m_min = pCommand->m_argMin;
+        row.m_max = pCommand->m_argMax;
+        row.m_passed = measurement.m_passed;
+        row.m_time = measurement.m_time;
+        row.m_duration_ms = measurement.m_duration_ms;
+        row.m_position = position;
+        row.m_retest = !m_retestReport.isEmpty();
+        rows.push_back(row);
+    }
+    m_measurementStore.addRun(rows);
+}
+
+
+/*!
+ * @brief Adds the values of the expects of a run to the SPC statistics
+ *
+ * Only the expects with numeric limits are followed.  The values that
+ * break a control chart rule are shown in red and the summaries of the
+ * shifts that ended are appended to the shift summary file.
+ *
+ * @param[in] script - the script that ran
+ * @param[in] position - panel position, 0 when not on a panel
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::updateSpc(CTestScript *script, int position)
+{
+    if (!m_spcEnabled || !m_retestReport.isEmpty())
+    {
+        return;
+    }
+
+    const std::vector<CTestScript::measurement_t> &measurements = script->getMeasurements();
+    for (unsigned int k=0; k<measurements.size(); k++)
+    {
+        const CTestScript::measurement_t &measurement = measurements[k];
+        const CCommand *pCommand = script->getCommand(measurement.m_commandIndex);
+        if (  !measurement.m_valueValid
+           || (pCommand->m_type == CCommand::CMD_EXPECT_CHAR)
+           || (pCommand->m_type == CCommand::CMD_EXPECT_STR) )
+        {
+            continue;
+        }
+        QString alarm = m_spcHistory.addValue(*script->getScriptVersion(), *script->getTestName(measurement.m_testIndex),
+                                              pCommand->m_lineNumber, pCommand->m_argMin, pCommand->m_argMax,
+                                              measurement.m_value, measurement.m_time);
+        if (!alarm.isEmpty())
+        {
+            if (position > 0)
+            {
+                alarm = QString("[P%1] ").arg(position) + alarm;
+            }
+            logStringRedToWindow(alarm.toLocal8Bit());
+        }
+    }
+
+    //
+    // Write the summaries of the shifts that ended
+    //
+    std::vector<QString> summaries;
+    m_spcHistory.takeShiftSummaries(summaries);
+    if (summaries.empty())
+    {
+        return;
+    }
+    QString filename = QFileInfo( QCoreApplication::applicationFilePath() ).dir().absolutePath();
+    filename += "/";
+    filename += SPC_SHIFT_FILE;
+    QFile file(filename);
+    bool opened = file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+    QTextStream out(&file);
+    for (unsigned int i=0; i<summaries.size(); i++)
+    {
+        logStringGray(summaries[i].toLocal8Bit());
+        if (opened)
+        {
+            out << summaries[i] << "\n";
+        }
+    }
+    if (!opened)
+    {
+        QString msg = "Could not write the SPC shift summary to " + filename;
+        logStringRedToWindow(msg.toLocal8Bit());
+    }
+}
+
+
+/*!
+ * @brief Compares a run of the golden board with its baseline
+ *
+ * The first run of the golden board with a script version records the
+ * baseline.  Each later run flags the expects whose value moved from the
+ * baseline by more than the tolerance of the test, the fixture channel
+ * behind them has likely drifted.  An expect without a baseline value
+ * fails the check.  Runs that are resumed, retests or that leave tests
+ * unchecked neither record the baseline nor ready the fixture.
+ *
+ * @param[in] script - the script that ran
+ * @param[in] fullRun - true for a fresh run with every test checked
+ * @param[in] completed - true if every test ran and passed
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::checkGoldenUnit(CTestScript *script, bool fullRun, bool completed)
+{
+    const QString &version = *script->getScriptVersion();
+    QString shiftId = m_spcHistory.getShiftId(QDateTime::currentDateTime());
+    bool recording = !m_goldenUnit.hasBaseline(version);
+    if (!fullRun)
+    {
+        logStringRedToWindow("Golden: only a fresh run of every test records the baseline or readies the fixture");
+        return;
+    }
+    if (recording && !completed)
+    {
+        logStringRedToWindow("Golden: the baseline is only recorded from a run in which every test passed");
+        m_goldenUnit.setLastCheck(shiftId, false);
+        m_goldenUnit.save();
+        return;
+    }
+
+    logStringGray(" ");
+    int count = 0;
+    int drifted = 0;
+    int missing = 0;
+    const std::vector<CTestScript::measurement_t> &measurements = script->getMeasurements();
+    for (unsigned int k=0; k<measurements.size(); k++)
+    {
+        const CTestScript::measurement_t &measurement = measurements[k];
+        const CCommand *pCommand = script->getCommand(measurement.m_commandIndex);
+        if (  !measurement.m_valueValid
+           || (pCommand->m_type == CCommand::CMD_EXPECT_CHAR)
+           || (pCommand->m_type == CCommand::CMD_EXPECT_STR) )
+        {
+            continue;
+        }
+        const QString &testName = *script->getTestName(measurement.m_testIndex);
+        if (recording)
+        {
+            m_goldenUnit.setBaseline(version, testName, pCommand->m_lineNumber, measurement.m_value);
+            count++;
+            continue;
+        }
+
+        double golden;
+        if (!m_goldenUnit.getBaseline(version, testName, pCommand->m_lineNumber, golden))
+        {
+            missing++;
+            QString line = "Golden: %1 line %2 (%3) has no baseline value";
+            line = line.arg(testName).arg(pCommand->m_lineNumber+1).arg(pCommand->m_line.trimmed());
+            logStringRedToWindow(line.toLocal8Bit());
+            continue;
+        }
+        count++;
+        double span = pCommand->m_argMax - pCommand->m_argMin;
+        if (span <= 0.0)
+        {
+            span = fabs(golden);
+        }
+        double allowed = span * m_goldenUnit.getTolerance(testName) / 100.0;
+        double drift = measurement.m_value - golden;
+        if (fabs(drift) > allowed)
+        {
+            drifted++;
+            QString line = "Golden: %1 line %2 (%3): value %4, golden %5, drift %6 exceeds %7";
+            line = line.arg(testName).arg(pCommand->m_lineNumber+1).arg(pCommand->m_line.trimmed())
+                       .arg(measurement.m_value, 0, 'g', 6).arg(golden, 0, 'g', 6)
+                       .arg(drift, 0, 'g', 4).arg(allowed, 0, 'g', 4);
+            logStringRedToWindow(line.toLocal8Bit());
+        }
+    }
+
+    QString line;
+    if (recording)
+    {
+        line = "Golden: baseline of %1 recorded from %2 value(s)";
+        logStringGray(line.arg(version).arg(count).toLocal8Bit());
+    }
+    else if ((drifted == 0) && (missing == 0) && completed)
+    {
+        line = "Golden: %1 value(s) within tolerance, the fixture is ready for %2";
+        logStringGray(line.arg(count).arg(shiftId).toLocal8Bit());
+    }
+    else
+    {
+        line = "Golden: %1 of %2 value(s) drifted, %3 without a baseline%4, check the fixture before testing production units";
+        line = line.arg(drifted).arg(count).arg(missing).arg(completed ? "" : " and the run did not pass");
+        logStringRedToWindow(line.toLocal8Bit());
+    }
+    m_goldenUnit.setLastCheck(shiftId, (drifted == 0) && (missing == 0) && completed);
+    m_goldenUnit.save();
+}
+
+
+/*!
+ * @brief Called when the "Reports/Register Golden Board" menu is selected
+ *
+ * Sets the serial number of the golden board of the fixture and forgets
+ * the baseline of the loaded script version, so that the next run of the
+ * golden board records a new one.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::registerGoldenUnit()
+{
+    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+    bool ok = false;
+    QString serialNumber = QInputDialog::getText(this, title, "Serial number of the golden board:", QLineEdit::Normal,
+                                                 m_goldenSerialNumber.isEmpty() ? ui->lineEditSerialNumber->text().trimmed() : m_goldenSerialNumber,
+                                                 &ok).trimmed();
+    if (!ok)
+    {
+        return;
+    }
+    if (!serialNumber.isEmpty() && (serialNumber.length() != 10))
+    {
+        displayWarning("Serial Number must be 10 numeric characters.");
+        return;
+    }
+
+    m_goldenSerialNumber = serialNumber;
+    m_goldenUnit.clearBaseline(*m_script.getScriptVersion());
+    m_goldenUnit.save();
+    m_settings->setValue("Golden/SerialNumber", m_goldenSerialNumber);
+
+    QString line;
+    if (m_goldenSerialNumber.isEmpty())
+    {
+        line = "Golden: no golden board for this fixture";
+    }
+    else
+    {
+        line = "Golden: %1 registered, its next run records the baseline of %2";
+        line = line.arg(m_goldenSerialNumber).arg(*m_script.getScriptVersion());
+    }
+    logStringGray(line.toLocal8Bit());
+}
+
+
+/*!
+ * @brief Called when the "Reports/SPC Summary" menu is selected
+ *
+ * Lists the running statistics and Cpk of every expect, overall and for
+ * the current shift.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::showSpcSummary()
+{
+    std::vector<QString> lines;
+    m_spcHistory.getSummary(lines);
+    ui->textEditResults->clear();
+    if (lines.empty())
+    {
+        logStringGray("No SPC statistics yet");
+        return;
+    }
+    for (unsigned int i=0; i<lines.size(); i++)
+    {
+        logStringGray(lines[i].toLocal8Bit());
+    }
+}
+
+
+/*!
+ * @brief Called when the "Reports/Reset SPC Baselines" menu is selected
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::resetSpcBaselines()
+{
+    QMessageBox::StandardButton reply;
+    reply = QMessageBox::question(this, "Reset SPC Baselines",
+                                  "Discard the statistics and control chart baselines of every expect?",
+                                  QMessageBox::Yes|QMessageBox::No);
+    if (reply != QMessageBox::Yes)
+    {
+        return;
+    }
+    m_spcHistory.resetBaselines();
+    m_spcHistory.save();
+}
+
+
+/*!
+ * @brief Shows an error of the measurement database
+ *
+ * @param[in] message - the error
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::measurementStoreError(const QString &message)
+{
+    logStringRedToWindow(message.toLocal8Bit());
+}
+
+
+/*!
+ * @brief Called when the "Reports/Index Report Archive" menu is selected
+ *
+ * Adds the records of the reports in a directory (and its subdirectories)
+ * to the report index of the measurement database.  Reports already in the
+ * index are skipped unless they changed.  Abort, or a failure to write to
+ * the index, stops the indexing; the reports not yet indexed are picked up
+ * the next time.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::indexReportArchive()
+{
+    QString dir = QFileDialog::getExistingDirectory(this, "Report Archive", m_reportDir);
+    if (dir.isEmpty())
+    {
+        return;
+    }
+
+    CReportIndexer indexer;
+    if (!indexer.open(m_measurementDatabasePath))
+    {
+        QString msg = "Could not open the report index: " + m_measurementDatabasePath;
+        displayWarning(msg.toLocal8Bit().data());
+        return;
+    }
+
+    enableButtonsAfterRun(false);
+    CAbort::Instance()->clearRequest();
+    ui->textEditResults->clear();
+    QTime t;
+    t.start();
+
+    int total = indexer.start(QStringList() << dir);
+    QString line = "Indexing %1 new or changed report(s) in %2";
+    logStringGray(line.arg(total).arg(dir).toLocal8Bit());
+    ui->progressBarTests->setRange(0, std::max(total, 1));
+
+    int filesDone = 0;
+    int recordsDone = 0;
+    while (indexer.step(filesDone, recordsDone))
+    {
+        if (CAbort::Instance()->abortRequested())
+        {
+            indexer.cancel();
+        }
+        emit setProgressBarValue(filesDone);
+        qApp->processEvents();
+        snooze(50);
+    }
+    emit setProgressBarValue(std::max(total, 1));
+
+    line = "Indexed %1 report(s), %2 record(s) in %3 s";
+    logStringGray(line.arg(filesDone).arg(recordsDone).arg(t.elapsed()/1000.0, 0, 'f', 1).toLocal8Bit());
+    if (!indexer.getError().isEmpty())
+    {
+        logStringRedToWindow(indexer.getError().toLocal8Bit());
+    }
+    else if (CAbort::Instance()->abortRequested())
+    {
+        logStringRedToWindow("Indexing stopped by the operator");
+    }
+    enableButtonsAfterRun(true);
+}
+
+
+/*!
+ * @brief Called when the "Reports/Query Report Index" menu is selected
+ *
+ * Lists the records of one test between two dates from the report index,
+ * followed by the pass/fail counts and the statistics of the values.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::queryReportIndex()
+{
+    QString title = QFileInfo( QCoreApplication::applicationFilePath() ).fileName();
+    bool ok = false;
+    QString testName = QInputDialog::getText(this, title, "Test name:", QLineEdit::Normal, "", &ok).trimmed();
+    if (!ok || testName.isEmpty())
+    {
+        return;
+    }
+    QDate today = QDate::currentDate();
+    QString fromStr = QInputDialog::getText(this, title, "From (MM/DD/YYYY):", QLineEdit::Normal,
+                                            QDate(today.year(), today.month(), 1).toString("MM/dd/yyyy"), &ok);
+    if (!ok)
+    {
+        return;
+    }
+    QString toStr = QInputDialog::getText(this, title, "To (MM/DD/YYYY):", QLineEdit::Normal,
+                                          today.toString("MM/dd/yyyy"), &ok);
+    if (!ok)
+    {
+        return;
+    }
+    QDate from = QDate::fromString(fromStr.trimmed(), "MM/dd/yyyy");
+    QDate to = QDate::fromString(toStr.trimmed(), "MM/dd/yyyy");
+    if (!from.isValid() || !to.isValid())
+    {
+        displayWarning("Dates must be entered as MM/DD/YYYY.");
+        return;
+    }
+
+    CReportIndexer indexer;
+    std::vector<CReportIndexer::result_t> results;
+    QTime t;
+    t.start();
+    if (!indexer.open(m_measurementDatabasePath) || !indexer.query(testName, from, to, results))
+    {
+        displayWarning("Could not query the report index.");
+        return;
+    }
+    int elapsed_ms = t.elapsed();
+
+    //
+    // List the records (the first 1000) and summarize all of them
+    //
+    ui->textEditResults->clear();
+    CRunningStats stats;
+    int passCount = 0;
+    for (unsigned int i=0; i<results.size(); i++)
+    {
+        const CReportIndexer::result_t &result = results[i];
+        if (result.m_valueValid)
+        {
+            stats.add(result.m_value);
+        }
+        if (result.m_result == "PASS")
+        {
+            passCount++;
+        }
+        if (i < 1000)
+        {
+            QString line = "%1 %2  %3  %4  %5";
+            line = line.arg(result.m_date.toString("MM/dd/yyyy")).arg(result.m_time).arg(result.m_serialNumber)
+                       .arg(result.m_valueValid ? QString::number(result.m_value, 'f', 3) : QString("none"))
+                       .arg(result.m_result);
+            logStringGray(line.toLocal8Bit());
+        }
+    }
+    if (results.size() > 1000)
+    {
+        logStringGray("...");
+    }
+
+    QString summary = "%1: %2 record(s) from %3 to %4, PASS=%5  FAIL=%6  (%7 ms)";
+    summary = summary.arg(testName).arg(results.size()).arg(from.toString("MM/dd/yyyy")).arg(to.toString("MM/dd/yyyy"))
+                     .arg(passCount).arg((int)results.size()-passCount).arg(elapsed_ms);
+    logStringGray(" ");
+    logStringGray(summary.toLocal8Bit());
+    if (stats.count() > 0)
+    {
+        QString line = "Values: n=%1  min=%2  mean=%3  max=%4  sd=%5";
+        line = line.arg(stats.count()).arg(stats.minimum(), 0, 'f', 3).arg(stats.mean(), 0, 'f', 3)
+                   .arg(stats.maximum(), 0, 'f', 3).arg(stats.stdDev(), 0, 'f', 3);
+        logStringGray(line.toLocal8Bit());
+    }
+}
+
+
+/*!
+ * @brief Returns the text of an HTML string, e.g. of the results label
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+QString MainWindow::plainText(const QString &html)
+{
+    return(QTextDocumentFragment::fromHtml(html).toPlainText().trimmed());
+}
+
+
+/*!
+ * @brief Sends an event to the remote clients that subscribed
+ *
+ * @param[in] event - name of the event
+ * @param[in] data - members of the event
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::publishEvent(const QString &event, QJsonObject data)
+{
+    if (!m_remoteControl.hasSubscribers())
+    {
+        return;
+    }
+    data["event"] = event;
+    data["time"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    m_remoteControl.publish(data);
+}
+
+
+/*!
+ * @brief Carries out a request of the remote control API
+ *
+ * The requests do what the buttons and menus do:
+ *   status                            - state, script, operator, serial number and tests
+ *   load {"script": file}             - loads a script
+ *   set {"operator": .., "serial": ..} - fills in the operator and serial number
+ *   select {"tests": [names]} or {"all": true}
+ *   start {"confirm": bool}           - starts a run, confirm answers its questions
+ *   abort                             - same as the Abort button
+ *   subscribe / unsubscribe           - started, test and finished events
+ *   report                            - lines of the report of the last run
+ *
+ * Nothing but status, abort, report and (un)subscribe is accepted while a
+ * run is in progress.
+ *
+ * @param[in] client - the client that sent the request
+ * @param[in] request - the request
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::remoteRequest(int client, const QJsonObject &request)
+{
+    QString cmd = request.value("cmd").toString();
+    QJsonObject response;
+
+    if (cmd == "status")
+    {
+        response["state"] = m_busy ? "busy" : "idle";
+        response["script"] = m_scriptFileName;
+        response["version"] = *m_script.getScriptVersion();
+        response["operator"] = ui->lineEditOperator->text();
+        response["serial"] = ui->lineEditSerialNumber->text();
+        response["result"] = plainText(ui->labelResults->text());
+        response["messages"] = QJsonArray::fromStringList(m_remoteMessages);
+        QJsonArray tests;
+        for (unsigned int i=0; i<m_testList.size(); i++)
+        {
+            QJsonObject test;
+            test["name"] = m_testList[i]->text();
+            test["selected"] = (m_testList[i]->checkState() == Qt::Checked);
+            tests.append(test);
+        }
+        response["tests"] = tests;
+    }
+    else if (cmd == "abort")
+    {
+        abortButtonPress();
+    }
+    else if ((cmd == "subscribe") || (cmd == "unsubscribe"))
+    {
+        m_remoteControl.subscribe(client, cmd == "subscribe");
+    }
+    else if (cmd == "report")
+    {
+        QJsonArray lines;
+        for (unsigned int i=0; i<m_reportStrings.size(); i++)
+        {
+            lines.append(m_reportStrings[i]);
+        }
+        response["lines"] = lines;
+    }
+    else if ((cmd == "load") || (cmd == "set") || (cmd == "select") || (cmd == "start"))
+    {
+        if (m_busy)
+        {
+            m_remoteControl.replyError(client, request, "a run is in progress");
+            return;
+        }
+
+        if (cmd == "load")
+        {
+            QString filename = request.value("script").toString();
+            if (filename.isEmpty() || !loadScript(filename.toLocal8Bit()))
+            {
+                m_remoteControl.replyError(client, request, "could not load the script " + filename);
+                return;
+            }
+            m_scriptFileName = filename;
+            response["version"] = *m_script.getScriptVersion();
+        }
+        else if (cmd == "set")
+        {
+            if (request.contains("operator"))
+            {
+                ui->lineEditOperator->setText(request.value("operator").toString().trimmed());
+            }
+            if (request.contains("serial"))
+            {
+                ui->lineEditSerialNumber->setText(request.value("serial").toString().trimmed());
+            }
+        }
+        else if (cmd == "select")
+        {
+            //
+            // Select in the script of the product of the serial number, so
+            // that the start does not switch scripts and check everything
+            //
+            QString serialNumber = ui->lineEditSerialNumber->text().trimmed();
+            if (!m_scriptLibrary.isEmpty() && (serialNumber.length() == 10))
+            {
+                m_remoteRun = true;     // no dialog
+                bool selected = selectProduct(serialNumber);
+                m_remoteRun = false;
+                if (!selected)
+                {
+                    m_remoteControl.replyError(client, request, "no product rule matches serial number " + serialNumber);
+                    return;
+                }
+            }
+            if (request.value("all").toBool())
+            {
+                selectAllTests();
+            }
+            else
+            {
+                QStringList names;
+                QJsonArray tests = request.value("tests").toArray();
+                for (int k=0; k<tests.size(); k++)
+                {
+                    names.append(tests[k].toString().trimmed());
+                }
+
+                //
+                // A request with an unknown test leaves the selection alone
+                //
+                QStringList unknown = names;
+                for (unsigned int i=0; i<m_testList.size(); i++)
+                {
+                    unknown.removeAll(m_testList[i]->text().trimmed());
+                }
+                if (!unknown.isEmpty())
+                {
+                    m_remoteControl.replyError(client, request, "unknown test(s): " + unknown.join(", "));
+                    return;
+                }
+                for (unsigned int i=0; i<m_testList.size(); i++)
+                {
+                    bool selected = names.contains(m_testList[i]->text().trimmed());
+                    m_testList[i]->setCheckState(selected ? Qt::Checked : Qt::Unchecked);
+                }
+            }
+        }
+        else
+        {
+            if (!ui->pushButtonStartTests->isEnabled())
+            {
+                m_remoteControl.replyError(client, request, "no script is loaded");
+                return;
+            }
+            //
+            // The run keeps processing events until it ends, so it is
+            // started after this reply has been sent
+            //
+            m_remoteConfirm = request.value("confirm").toBool();
+            m_busy = true;
+            QTimer::singleShot(0, this, SLOT(remoteStart()));
+        }
+    }
+    else
+    {
+        m_remoteControl.replyError(client, request, "unknown command " + cmd);
+        return;
+    }
+
+    m_remoteControl.reply(client, request, response);
+}
+
+
+/*!
+ * @brief Runs the tests for the remote control API
+ *
+ * This is startTestsButtonPress with the dialogs answered from the start
+ * request and their messages collected for the status request.
+ *
+ * @author agent
+ * @date 10/19/2026
+*/
+void MainWindow::remoteStart()
+{
+    if (m_lidPolling)
+    {
+        QTimer::singleShot(10, this, SLOT(remoteStart()));
+        return;
+    }
+    m_remoteMessages.clear();
+    m_remoteRun = true;
+    startTestsButtonPress();
+    m_remoteRun = false;
+
+    if (ui->labelResults->text() == g_stringNotRun)
+    {
+        QJsonObject notRunEvent;
+        notRunEvent["messages"] = QJsonArray::fromStringList(m_remoteMessages);
+        publishEvent("not_run", notRunEvent);
+    }
+}
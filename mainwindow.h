@@ -11,6 +11,7 @@
  *  Version | Author       | Date        | Description
  *  :--:    | :-----       | :--:        | :----------
  *   1      | J. Peterson  | 02/13/2015  | initial version
+ *   2      | agent        | 10/19/2026  | metrics, remote control, auto-start, product selection
  *
 */
 #ifndef MAINWINDOW_H
@@ -25,7 +26,22 @@
 #include <QString>
 #include <QSettings>
 #include <QSqlDatabase>
+#include <QTimer>
+#include <QFileSystemWatcher>
 #include "TestScript.h"
+#include "TestHistory.h"
+#include "OperatorQueue.h"
+#include "FixtureArbiter.h"
+#include "PanelPosition.h"
+#include "RunCheckpoint.h"
+#include "MeasurementStore.h"
+#include "SpcHistory.h"
+#include "GoldenUnit.h"
+#include "MetricsServer.h"
+#include "RemoteControl.h"
+#include "SerialValidator.h"
+#include "ReportSpooler.h"
+#include "ScriptLibrary.h"
 
 #define VERSION_STRING "2.5"
 
@@ -59,7 +75,30 @@ public slots:
     void terminateCheckboxClicked(bool checked);
     void validateSerialNumberChecked(bool checked);
     void validateSerialConnectionsChecked(bool checked);
-
+    void estimateCycleTime();
+    void adaptiveTimeoutsChecked(bool checked);
+    void failFastOrderingChecked(bool checked);
+    void sleepTuningExperiment();
+    void runPanel();
+    void retestFailures();
+    void logPanelLine(int position, const QString &text, int color);
+    void panelTestsDone(int position);
+    void panelFinished(int position);
+    void measurementStoreError(const QString &message);
+    void indexReportArchive();
+    void queryReportIndex();
+    void showSpcSummary();
+    void resetSpcBaselines();
+    void registerGoldenUnit();
+    void remoteRequest(int client, const QJsonObject &request);
+    void remoteStart();
+    void serialNumberValidated(const QString &serialNumber, bool found, const QString &error);
+    void pollFixtureLid();
+    void reportSpooled(const QString &path, bool inReportDir, const QStringList &pending);
+    void reportSpoolError(const QString &message);
+    void reloadProductRules();
+    void scriptFileChanged(const QString &path);
+    void reloadChangedScript();
 
     void logStringBlack(const char *string);
     void logStringGray(const char *string);
@@ -69,11 +108,18 @@ public slots:
     void logReply(const char *reply);
     bool sendVapoThermCommand(int portIndex, const char *command);
     bool readVapoThermResponse(int portIndex, char *buffer, const int bufferSize, const int msTimeout);
+    int  readVapoThermBytes(int portIndex, char *buffer, const int count, const int msTimeout);
+    bool startVapoThermCommand(int portIndex, const char *command);
+    int  pollVapoThermOutput(int portIndex);
+    bool pollVapoThermResponse(int portIndex, char *buffer, const int bufferSize);
+    void readTimedOut(int portIndex);
     bool generateReport();
     void flushIncomingData(int portIndex);
 
 private:
     void snooze(int ms);
+    int  receiveVapoThermData(int portIndex);
+    bool takeVapoThermLine(int portIndex, char *buffer, const int bufferSize);
     void setTitle();
     void displayWarning(const char *msg);
     bool displayQuestion(const char *msg);
@@ -82,6 +128,24 @@ private:
     bool connectToDatabase();
     bool serialNumberIsInDB(QString serialNumber);
     bool loadScript(const char *scriptFilename);
+    void rebuildTestList();
+    void watchScriptFile(const QString &path);
+    bool selectProduct(const QString &serialNumber);
+    void activateProduct(const QString &product);
+    QString lookupZNumber(const QString &serialNumber);
+    QString probeProduct();
+    QString zNumberForSerial(const QString &serialNumber);
+    void getRunOrder(std::vector<unsigned int> &order);
+    bool generateReport(const std::vector<QString> &reportStrings, const QString &suffix);
+    bool getPanelSerialNumbers(QStringList &serialNumbers);
+    void saveCheckpoint(CRunCheckpoint::run_t &run, const std::vector<bool> &testFailed);
+    bool reinitForResume(const CRunCheckpoint::run_t &run);
+    bool generateRetestReport();
+    void storeMeasurements(CTestScript *script, const QString &serialNumber, int position);
+    void updateSpc(CTestScript *script, int position);
+    void checkGoldenUnit(CTestScript *script, bool fullRun, bool completed);
+    void publishEvent(const QString &event, QJsonObject data);
+    QString plainText(const QString &html);
 
 private:
     Ui::MainWindow *ui;
@@ -94,10 +158,77 @@ private:
     int                            m_outputDelay_ms;  // ms delay between output characters
     int                            m_timeoutA_ms;
     int                            m_timeoutB_ms;
+    bool                           m_adaptiveTimeouts;
+    int                            m_adaptiveMargin_ms;
+    int                            m_adaptiveMinSamples;
+    bool                           m_sleepTuningEnabled;  // only set on golden board stations
+    int                            m_sleepTuningRepeats;
+    double                         m_sleepTuningTolerance;
+    int                            m_sleepTuningMargin_pct;
+    CTestHistory                   m_testHistory;
+    COperatorQueue                *m_operatorQueue;
+    QString                        m_fixtureProfile;
+    bool                           m_elideRedundant;      // as configured, only used if the profile loaded
+    bool                           m_fixtureProfileLoaded;
+    bool                           m_failFastOrdering;
+    CFixtureArbiter               *m_fixtureArbiter;
+    QStringList                    m_panelPorts;      // DUT port of each panel position
+    std::vector<CPanelPosition *>  m_panel;
+    int                            m_panelDone;       // positions done with their tests
+    int                            m_panelFinished;   // positions done with OnAbort/OnExit
+    bool                           m_panelFullRun;    // every test of the script is checked
+    CRunCheckpoint                 m_checkpoint;
+    bool                           m_checkpointEnabled;
+    QString                        m_reinitTest;      // test run before resuming from a checkpoint
+    QString                        m_retestReport;    // last report of the board when retesting its failures
+    CMeasurementStore              m_measurementStore;
+    bool                           m_storeMeasurements;
+    QString                        m_measurementDatabase;
+    QString                        m_measurementDatabasePath;  // absolute path of m_measurementDatabase
+    CSpcHistory                    m_spcHistory;
+    bool                           m_spcEnabled;
+    int                            m_spcBaselineCount;
+    QStringList                    m_spcShiftStarts;  // "HH:mm" start of each shift
+    CGoldenUnit                    m_goldenUnit;
+    QString                        m_goldenSerialNumber;  // golden board of the fixture, empty if none
+    double                         m_goldenTolerance_pct;
+    bool                           m_goldenAtShiftStart;  // hold production until the golden board passed in the shift
+    CMetricsServer                 m_metricsServer;
+    int                            m_metricsPort;         // 0 if the metrics are not served
+    CRemoteControl                 m_remoteControl;
+    int                            m_remotePort;          // 0 if remote control is off
+    QString                        m_remoteAddress;
+    bool                           m_busy;                // a run (or other long operation) is in progress
+    bool                           m_remoteRun;           // the run was started remotely, no dialogs
+    bool                           m_remoteConfirm;       // answer to the questions of a remote run
+    QStringList                    m_remoteMessages;      // warnings and questions of the last remote run
+    CSerialValidator               m_serialValidator;
+    bool                           m_autoStart;           // validate scans at once and start when the lid closes
+    QString                        m_lidCommand;          // port B command asking for the state of the lid
+    QString                        m_lidClosedReply;      // text in its reply when the lid is closed
+    int                            m_lidSettle_ms;        // wait between the echo and the reply
+    int                            m_lidPoll_ms;
+    QTimer                         m_lidTimer;
+    bool                           m_lidPolling;
+    bool                           m_lidWasOpen;          // the lid opened since the last run
+    bool                           m_autoRun;             // the run was started by the lid
+    QString                        m_validatingSerial;    // scan waiting for the database
+    QString                        m_validatedSerial;     // scan found in the database
+    QString                        m_armedSerial;         // scan waiting for the lid to close
+    CReportSpooler                 m_reportSpooler;
+    CScriptLibrary                 m_scriptLibrary;
+    QString                        m_productRules;        // rule file of the products, empty if not used
+    QString                        m_productName;         // product whose script is loaded
+    QString                        m_productSerial;       // serial number the product was selected for
+    QFileSystemWatcher             m_scriptWatcher;       // the loaded script file
+    QTimer                         m_scriptReloadTimer;   // lets the editor finish writing the file
+    bool                           m_scriptReloadPending; // the script changed during a run
 
-    char m_inputBuffer[1024];
-    int  m_inputBufferIndex;
-    int  m_inputBufferCount;
+    QByteArray m_pendingOutput[2];   // command being paced out by pollVapoThermOutput
+    int        m_pendingIndex[2];    // next character to write, -1 when idle
+    int        m_pendingWritten[2];
+    QTime      m_pendingTime[2];     // time of the last character written
+    QByteArray m_lineBuffer[2];      // received and not yet read, for all of the reads of the port
 
     QSettings  *m_settings;
     std::vector<QString> m_reportStrings;